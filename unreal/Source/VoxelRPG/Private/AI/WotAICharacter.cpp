@@ -1,6 +1,10 @@
 #include "AI/WotAICharacter.h"
 #include "AI/WotAIController.h"
+#include "AI/WotAILODSubsystem.h"
+#include "AI/WotBotRegistrySubsystem.h"
+#include "AI/WotPerceptionSubsystem.h"
 #include "BehaviorTree/BlackboardComponent.h"
+#include "BehaviorTree/Blackboard/BlackboardKeyType_Object.h"
 #include "Perception/PawnSensingComponent.h"
 #include "AIController.h"
 #include "WotActionComponent.h"
@@ -9,12 +13,16 @@
 #include "WotInventoryComponent.h"
 #include "WotDeathEffectComponent.h"
 #include "Components/CapsuleComponent.h"
+#include "Components/SkeletalMeshComponent.h"
+#include "GameFramework/CharacterMovementComponent.h"
+#include "WotActorPoolSubsystem.h"
 #include "Engine/EngineTypes.h"
 #include "UI/WotUWHealthBar.h"
 #include "UI/WotUWPopupNumber.h"
 #include "BrainComponent.h"
 #include "Items/WotItem.h"
 #include "Items/WotItemWeapon.h"
+#include "Items/WotStuckItemsComponent.h"
 
 AWotAICharacter::AWotAICharacter()
 {
@@ -30,11 +38,15 @@ AWotAICharacter::AWotAICharacter()
   ActionComp = CreateDefaultSubobject<UWotActionComponent>("ActionComp");
 
 	DeathEffectComp = CreateDefaultSubobject<UWotDeathEffectComponent>("DeathEffectComp");
+
+  // lets the AI LOD lower the animation update rate, see ApplyLODTier
+  GetMesh()->bEnableUpdateRateOptimizations = true;
 }
 
 void AWotAICharacter::PostInitializeComponents()
 {
   Super::PostInitializeComponents();
+  ComponentCache.Fill(this);
   PawnSensingComp->OnSeePawn.AddDynamic(this, &AWotAICharacter::OnPawnSeen);
 	AttributeComp->OnHealthChanged.AddDynamic(this, &AWotAICharacter::OnHealthChanged);
 	AttributeComp->OnKilled.AddDynamic(this, &AWotAICharacter::OnKilled);
@@ -42,19 +54,200 @@ void AWotAICharacter::PostInitializeComponents()
   // channels with responses!
 	GetCapsuleComponent()->SetCollisionResponseToChannel(ECC_WorldDynamic, ECR_Ignore);
   GetMesh()->SetGenerateOverlapEvents(true);
+  // remember what OnKilled changes so the bot can be reused from the pool
+  MeshRelativeTransform = GetMesh()->GetRelativeTransform();
+  CapsuleProfileName = GetCapsuleComponent()->GetCollisionProfileName();
+  MeshProfileName = GetMesh()->GetCollisionProfileName();
+  GroundMovementMode = GetCharacterMovement()->GetGroundMovementMode();
+  bSweepWhileNavWalking = GetCharacterMovement()->bSweepWhileNavWalking;
+}
+
+void AWotAICharacter::BeginPlay()
+{
+  Super::BeginPlay();
+  if (UWotBotRegistrySubsystem* Registry = UWotBotRegistrySubsystem::Get(this)) {
+    Registry->RegisterBot(this);
+  }
+  RegisterPerception();
+}
+
+void AWotAICharacter::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+  if (UWotBotRegistrySubsystem* Registry = UWotBotRegistrySubsystem::Get(this)) {
+    Registry->UnregisterBot(this);
+  }
+  UnregisterPerception();
+  Super::EndPlay(EndPlayReason);
+}
+
+void AWotAICharacter::OnReleasedToPool_Implementation()
+{
+  if (UWotBotRegistrySubsystem* Registry = UWotBotRegistrySubsystem::Get(this)) {
+    Registry->UnregisterBot(this);
+  }
+  UnregisterPerception();
+  ResetLODTier();
+  // a pooled bot doesn't think, sense or move until acquired again
+  if (AAIController* AIC = Cast<AAIController>(GetController())) {
+    AIC->StopMovement();
+    if (AIC->GetBrainComponent()) {
+      AIC->GetBrainComponent()->StopLogic("Pooled");
+    }
+  }
+  PawnSensingComp->SetSensingUpdatesEnabled(false);
+  GetCharacterMovement()->StopMovementImmediately();
+  GetCharacterMovement()->SetComponentTickEnabled(false);
+  GetMesh()->bPauseAnims = true;
+  // the pool only clears FTimerManager timers
+  UWotTimingWheelSubsystem::ClearTimer(this, HighlightTimerHandle);
+  UWotTimingWheelSubsystem::ClearTimer(this, TimerHandle_ForgetDamageActor);
+  UWotTimingWheelSubsystem::ClearTimer(this, TimerHandle_Destroy);
+  // undo the ragdoll and put the mesh back under the capsule
+  GetMesh()->SetAllBodiesSimulatePhysics(false);
+  GetMesh()->SetCollisionProfileName(MeshProfileName);
+  GetMesh()->AttachToComponent(GetCapsuleComponent(), FAttachmentTransformRules::SnapToTargetNotIncludingScale);
+  GetMesh()->SetRelativeTransform(MeshRelativeTransform);
+  SetHighlightEnabled(0, false);
+  // a bot released alive (e.g. a demoted animal) still has its loot, which
+  // is rolled again when it is acquired
+  InventoryComp->ClearItems();
+}
+
+void AWotAICharacter::OnAcquiredFromPool_Implementation()
+{
+  AttributeComp->ResetAttributes();
+  GetCapsuleComponent()->SetCollisionProfileName(CapsuleProfileName);
+  GetMesh()->SetVisibility(true, false);
+  GetMesh()->bPauseAnims = false;
+  // TurnOff() disabled movement and replication
+  GetCharacterMovement()->SetComponentTickEnabled(true);
+  GetCharacterMovement()->SetDefaultMovementMode();
+  SetReplicates(GetClass()->GetDefaultObject<AActor>()->GetIsReplicated());
+  InventoryComp->AddDefaultItems();
+  // OnKilled detached the equipped item actors
+  EquipmentComp->ReequipAll();
+  // start thinking from scratch
+  SetBlackboardActor("TargetActor", nullptr);
+  SetBlackboardActor("DamageActor", nullptr);
+  AAIController* AIC = Cast<AAIController>(GetController());
+  if (AIC && AIC->GetBrainComponent()) {
+    AIC->GetBrainComponent()->RestartLogic();
+  }
+  if (UWotBotRegistrySubsystem* Registry = UWotBotRegistrySubsystem::Get(this)) {
+    Registry->RegisterBot(this);
+  }
+  PawnSensingComp->SetSensingUpdatesEnabled(GetClass()->GetDefaultObject<AWotAICharacter>()->PawnSensingComp->bEnableSensingUpdates);
+  RegisterPerception();
+}
+
+void AWotAICharacter::RegisterPerception()
+{
+  UWotPerceptionSubsystem* Perception = UWotPerceptionSubsystem::GetIfEnabled(this);
+  if (!Perception || !PawnSensingComp->bSeePawns) {
+    return;
+  }
+  // the component only holds the sight settings from now on
+  PawnSensingComp->SetSensingUpdatesEnabled(false);
+  Perception->RegisterSensor(this, PawnSensingComp);
+  Perception->RegisterStimulus(this);
+}
+
+void AWotAICharacter::UnregisterPerception()
+{
+  if (UWotPerceptionSubsystem* Perception = UWotPerceptionSubsystem::Get(this)) {
+    Perception->UnregisterSensor(this);
+    Perception->UnregisterStimulus(this);
+  }
+}
+
+void AWotAICharacter::OnSensedTargetChanged(APawn* NewTarget, APawn* OldTarget)
+{
+  // like pawn sensing, a lost target is kept so the bot keeps chasing it
+  if (NewTarget) {
+    SetBlackboardActor("TargetActor", NewTarget);
+  }
+}
+
+void AWotAICharacter::OnSensedTargetKept(APawn* Target)
+{
+  // like OnSeePawn, which pawn sensing raises on every update, but without
+  // rewriting the key (and notifying its observers) when nothing changed
+  AAIController* AIC = Cast<AAIController>(GetController());
+  UBlackboardComponent* BBComp = AIC ? AIC->GetBlackboardComponent() : nullptr;
+  if (!BBComp) {
+    return;
+  }
+  if (TargetActorKeyID == FBlackboard::InvalidKey) {
+    TargetActorKeyID = BBComp->GetKeyID("TargetActor");
+  }
+  if (BBComp->GetValue<UBlackboardKeyType_Object>(TargetActorKeyID) != Target) {
+    BBComp->SetValue<UBlackboardKeyType_Object>(TargetActorKeyID, Target);
+  }
+}
+
+void AWotAICharacter::ApplyLODTier(int32 Tier, const FWotAILODTier& Settings)
+{
+  LODTier = Tier;
+  // picked up by UWotBTService when the services schedule their next tick
+  LODServiceIntervalScale = FMath::Max(Settings.ServiceIntervalScale, 1.0f);
+  UCharacterMovementComponent* MovementComp = GetCharacterMovement();
+  MovementComp->bSweepWhileNavWalking = Settings.bNavWalking ? false : bSweepWhileNavWalking;
+  // switches right away when on the ground, otherwise once landed
+  MovementComp->SetGroundMovementMode(Settings.bNavWalking ? MOVE_NavWalking : GroundMovementMode.GetValue());
+  // use the tier's frame skip for every mesh LOD instead of the screen size
+  // based one; bots off screen still update at the non rendered rate
+  if (FAnimUpdateRateParameters* UpdateRateParams = GetMesh()->AnimUpdateRateParams) {
+    UpdateRateParams->bShouldUseLodMap = true;
+    UpdateRateParams->LODToFrameSkipMap.Reset();
+    for (int32 LODIndex = 0; LODIndex < MAX_MESH_LOD_COUNT; LODIndex++) {
+      UpdateRateParams->LODToFrameSkipMap.Add(LODIndex, Settings.AnimFrameSkip);
+    }
+  }
+}
+
+void AWotAICharacter::ResetLODTier()
+{
+  ApplyLODTier(INDEX_NONE, FWotAILODTier());
+}
+
+UWotStuckItemsComponent* AWotAICharacter::GetStuckItems() const
+{
+  UWotStuckItemsComponent* StuckItems = FindComponentByClass<UWotStuckItemsComponent>();
+  return StuckItems && StuckItems->GetNumStuckItems() > 0 ? StuckItems : nullptr;
+}
+
+void AWotAICharacter::Interact_Implementation(APawn* InstigatorPawn, FHitResult Hit)
+{
+  // the bot is the interactable found for both, so hand over to its items
+  if (UWotStuckItemsComponent* StuckItems = GetStuckItems()) {
+    IWotInteractableInterface::Execute_Interact(StuckItems, InstigatorPawn, Hit);
+  }
+}
+
+void AWotAICharacter::GetInteractionText_Implementation(APawn* InstigatorPawn, FHitResult Hit, FText& OutText)
+{
+  if (UWotStuckItemsComponent* StuckItems = GetStuckItems()) {
+    IWotInteractableInterface::Execute_GetInteractionText(StuckItems, InstigatorPawn, Hit, OutText);
+  }
 }
 
 void AWotAICharacter::Highlight_Implementation(FHitResult Hit, int HighlightValue, float Duration=0)
 {
+  if (UWotStuckItemsComponent* StuckItems = GetStuckItems()) {
+    IWotGameplayInterface::Execute_Highlight(StuckItems, Hit, HighlightValue, Duration);
+  }
   SetHighlightEnabled(HighlightValue, true);
   // if duration is > 0, start a timer to unhighlight the object
   if (Duration > 0) {
-    GetWorldTimerManager().SetTimer(HighlightTimerHandle, this, &AWotAICharacter::OnHighlightTimerExpired, Duration, false);
+    UWotTimingWheelSubsystem::SetTimer(this, HighlightTimerHandle, &AWotAICharacter::OnHighlightTimerExpired, Duration);
   }
 }
 
 void AWotAICharacter::Unhighlight_Implementation(FHitResult Hit)
 {
+  if (UWotStuckItemsComponent* StuckItems = FindComponentByClass<UWotStuckItemsComponent>()) {
+    IWotGameplayInterface::Execute_Unhighlight(StuckItems, Hit);
+  }
   SetHighlightEnabled(0, false);
 }
 
@@ -171,15 +364,15 @@ void AWotAICharacter::SetBlackboardActor(const FString BlackboardKeyName, AActor
 
 void AWotAICharacter::OnHealthChanged(AActor* InstigatorActor, UWotAttributeComponent* OwningComp, float NewHealth, float Delta)
 {
-  // set the instigator as the damage actor
-  SetBlackboardActor("DamageActor", InstigatorActor);
-  UE_LOG(LogTemp, Warning, TEXT("Run away from %s"), *GetNameSafe(InstigatorActor));
-  SetBlackboardActor("TargetActor", InstigatorActor);
-  // Then forget damage actor after a delay
-  GetWorldTimerManager().SetTimer(TimerHandle_ForgetDamageActor,
-                                  this,
-                                  &AWotAICharacter::ForgetDamageActor_TimeElapsed,
-                                  DamageActorForgetDelay);
+  // set the instigator as the damage actor, unless we changed our own health
+  // (e.g. a lowered max health)
+  if (InstigatorActor && InstigatorActor != this) {
+    SetBlackboardActor("DamageActor", InstigatorActor);
+    UE_LOG(LogTemp, Warning, TEXT("Run away from %s"), *GetNameSafe(InstigatorActor));
+    SetBlackboardActor("TargetActor", InstigatorActor);
+    // Then forget damage actor after a delay
+    UWotTimingWheelSubsystem::SetTimer(this, TimerHandle_ForgetDamageActor, &AWotAICharacter::ForgetDamageActor_TimeElapsed, DamageActorForgetDelay);
+  }
   // and show the health widgets
 	ShowHealthBarWidget(NewHealth, Delta, 1.0f);
 	ShowPopupWidgetNumber(Delta, 1.0f);
@@ -192,6 +385,7 @@ void AWotAICharacter::OnHealthChanged(AActor* InstigatorActor, UWotAttributeComp
 
 void AWotAICharacter::OnKilled(AActor* InstigatorActor, UWotAttributeComponent* OwningComp)
 {
+  UnregisterPerception();
 	// turn off collision & physics
 	TurnOff(); // freezes the pawn state
 	GetCapsuleComponent()->SetSimulatePhysics(false);
@@ -228,12 +422,12 @@ void AWotAICharacter::OnKilled(AActor* InstigatorActor, UWotAttributeComponent*
   // Drop all items the character is carrying
   InventoryComp->DropAll();
 	// Then destroy after a delay (could also use SetLifeSpan(...) instead of timer)
-	GetWorldTimerManager().SetTimer(TimerHandle_Destroy, this, &AWotAICharacter::Destroy_TimeElapsed, KilledDestroyDelay);
+	UWotTimingWheelSubsystem::SetTimer(this, TimerHandle_Destroy, &AWotAICharacter::Destroy_TimeElapsed, KilledDestroyDelay);
 }
 
 void AWotAICharacter::Destroy_TimeElapsed()
 {
-	Destroy();
+	UWotActorPoolSubsystem::ReleasePooled(this);
 }
 
 void AWotAICharacter::ForgetDamageActor_TimeElapsed()
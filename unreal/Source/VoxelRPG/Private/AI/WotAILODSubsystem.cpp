@@ -0,0 +1,161 @@
+#include "AI/WotAILODSubsystem.h"
+#include "AI/WotAICharacter.h"
+#include "AI/WotBotRegistrySubsystem.h"
+#include "GameFramework/PlayerController.h"
+#include "Engine/World.h"
+
+static TAutoConsoleVariable<bool> CVarAILODEnabled(TEXT("wot.AILOD.Enabled"), true, TEXT("Lower the behavior tree, movement and animation update rates of bots far from the players"), ECVF_Cheat);
+static TAutoConsoleVariable<float> CVarAILODUpdateInterval(TEXT("wot.AILOD.UpdateInterval"), 0.25f, TEXT("Seconds between sorting the bots into LOD tiers"), ECVF_Cheat);
+static TAutoConsoleVariable<float> CVarAILODHysteresis(TEXT("wot.AILOD.Hysteresis"), 300.0f, TEXT("Distance a bot has to be past a tier boundary before it changes tier"), ECVF_Cheat);
+static TAutoConsoleVariable<float> CVarAILODOffscreenDistanceScale(TEXT("wot.AILOD.OffscreenDistanceScale"), 2.0f, TEXT("Bots not rendered lately count as this many times farther away"), ECVF_Cheat);
+
+// a bot not rendered for this long counts as off screen
+static constexpr float RecentlyRenderedTolerance = 0.5f;
+
+static FAutoConsoleCommandWithWorld AILODStatsCommand(
+  TEXT("wot.AILOD.Stats"),
+  TEXT("Logs the AI LOD counters and the number of bots per tier"),
+  FConsoleCommandWithWorldDelegate::CreateLambda([](UWorld* World) {
+    UWotAILODSubsystem* AILOD = UWotAILODSubsystem::Get(World);
+    if (!AILOD) {
+      return;
+    }
+    const FWotAILODCounters Counters = AILOD->GetCounters();
+    UE_LOG(LogTemp, Log, TEXT("AI LOD: evaluations %d, tier changes %d"), Counters.Evaluations, Counters.TierChanges);
+    for (int32 Tier = 0; Tier < Counters.BotsPerTier.Num(); Tier++) {
+      UE_LOG(LogTemp, Log, TEXT("  tier %d (from %.0f): %d bots"), Tier, AILOD->GetTiers()[Tier].MinDistance, Counters.BotsPerTier[Tier]);
+    }
+  }));
+
+UWotAILODSubsystem::UWotAILODSubsystem()
+{
+  // full detail near the players, then slower services, cheap movement and
+  // fewer animation updates the farther away
+  Tiers.AddDefaulted();
+  FWotAILODTier& Medium = Tiers.AddDefaulted_GetRef();
+  Medium.MinDistance = 3000.0f;
+  Medium.ServiceIntervalScale = 2.0f;
+  Medium.AnimFrameSkip = 1;
+  FWotAILODTier& Far = Tiers.AddDefaulted_GetRef();
+  Far.MinDistance = 6000.0f;
+  Far.ServiceIntervalScale = 4.0f;
+  Far.bNavWalking = true;
+  Far.AnimFrameSkip = 3;
+  FWotAILODTier& VeryFar = Tiers.AddDefaulted_GetRef();
+  VeryFar.MinDistance = 12000.0f;
+  VeryFar.ServiceIntervalScale = 8.0f;
+  VeryFar.bNavWalking = true;
+  VeryFar.AnimFrameSkip = 7;
+}
+
+UWotAILODSubsystem* UWotAILODSubsystem::Get(const UObject* WorldContextObject)
+{
+  if (!WorldContextObject) {
+    return nullptr;
+  }
+  UWorld* World = WorldContextObject->GetWorld();
+  return World ? World->GetSubsystem<UWotAILODSubsystem>() : nullptr;
+}
+
+UWotAILODSubsystem* UWotAILODSubsystem::GetIfEnabled(const UObject* WorldContextObject)
+{
+  return CVarAILODEnabled.GetValueOnGameThread() ? Get(WorldContextObject) : nullptr;
+}
+
+void UWotAILODSubsystem::ResetCounters()
+{
+  Counters = FWotAILODCounters();
+}
+
+TStatId UWotAILODSubsystem::GetStatId() const
+{
+  RETURN_QUICK_DECLARE_CYCLE_STAT(UWotAILODSubsystem, STATGROUP_Tickables);
+}
+
+void UWotAILODSubsystem::Tick(float DeltaTime)
+{
+  if (!CVarAILODEnabled.GetValueOnGameThread()) {
+    if (bApplied) {
+      ResetBots();
+    }
+    return;
+  }
+  const double Now = GetWorld()->GetTimeSeconds();
+  if (Now < NextEvaluateTime) {
+    return;
+  }
+  NextEvaluateTime = Now + CVarAILODUpdateInterval.GetValueOnGameThread();
+  Evaluate();
+}
+
+int32 UWotAILODSubsystem::SelectTier(int32 CurrentTier, float Distance, float Hysteresis) const
+{
+  if (!Tiers.IsValidIndex(CurrentTier)) {
+    // no tier yet, take the one the distance is in
+    int32 Tier = 0;
+    while (Tier + 1 < Tiers.Num() && Distance >= Tiers[Tier + 1].MinDistance) {
+      Tier++;
+    }
+    return Tier;
+  }
+  int32 Tier = CurrentTier;
+  while (Tier + 1 < Tiers.Num() && Distance >= Tiers[Tier + 1].MinDistance + Hysteresis) {
+    Tier++;
+  }
+  while (Tier > 0 && Distance < Tiers[Tier].MinDistance - Hysteresis) {
+    Tier--;
+  }
+  return Tier;
+}
+
+void UWotAILODSubsystem::Evaluate()
+{
+  UWotBotRegistrySubsystem* Registry = UWotBotRegistrySubsystem::Get(this);
+  if (!Registry || Tiers.Num() == 0) {
+    return;
+  }
+  TArray<FVector, TInlineAllocator<4>> ViewerLocations;
+  for (FConstPlayerControllerIterator It = GetWorld()->GetPlayerControllerIterator(); It; ++It) {
+    const APlayerController* PC = It->Get();
+    if (PC && PC->GetPawn()) {
+      ViewerLocations.Add(PC->GetPawn()->GetActorLocation());
+    }
+  }
+  // keep the current tiers while nobody is around to look at the bots
+  if (ViewerLocations.Num() == 0) {
+    return;
+  }
+  const float Hysteresis = FMath::Max(CVarAILODHysteresis.GetValueOnGameThread(), 0.0f);
+  const float OffscreenDistanceScale = FMath::Max(CVarAILODOffscreenDistanceScale.GetValueOnGameThread(), 1.0f);
+  Counters.BotsPerTier.Init(0, Tiers.Num());
+  for (AWotAICharacter* Bot : Registry->GetAliveBots()) {
+    const FVector BotLocation = Bot->GetActorLocation();
+    float DistanceSquared = TNumericLimits<float>::Max();
+    for (const FVector& ViewerLocation : ViewerLocations) {
+      DistanceSquared = FMath::Min(DistanceSquared, (float)FVector::DistSquared(BotLocation, ViewerLocation));
+    }
+    float Distance = FMath::Sqrt(DistanceSquared);
+    if (!Bot->WasRecentlyRendered(RecentlyRenderedTolerance)) {
+      Distance *= OffscreenDistanceScale;
+    }
+    const int32 Tier = SelectTier(Bot->GetLODTier(), Distance, Hysteresis);
+    if (Tier != Bot->GetLODTier()) {
+      Bot->ApplyLODTier(Tier, Tiers[Tier]);
+      Counters.TierChanges++;
+    }
+    Counters.BotsPerTier[Tier]++;
+  }
+  Counters.Evaluations++;
+  bApplied = true;
+}
+
+void UWotAILODSubsystem::ResetBots()
+{
+  if (UWotBotRegistrySubsystem* Registry = UWotBotRegistrySubsystem::Get(this)) {
+    for (AWotAICharacter* Bot : Registry->GetRegisteredBots()) {
+      Bot->ResetLODTier();
+    }
+  }
+  Counters.BotsPerTier.Reset();
+  bApplied = false;
+}
@@ -0,0 +1,14 @@
+#include "AI/WotBTService.h"
+#include "AI/WotAICharacter.h"
+#include "AIController.h"
+
+void UWotBTService::ScheduleNextTick(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory)
+{
+  Super::ScheduleNextTick(OwnerComp, NodeMemory);
+
+  const AAIController* MyController = OwnerComp.GetAIOwner();
+  const AWotAICharacter* AICharacter = MyController ? Cast<AWotAICharacter>(MyController->GetPawn()) : nullptr;
+  if (AICharacter && AICharacter->GetLODServiceIntervalScale() != 1.0f) {
+    SetNextTickTime(NodeMemory, GetNextTickRemainingTime(NodeMemory) * AICharacter->GetLODServiceIntervalScale());
+  }
+}
@@ -1,7 +1,28 @@
 #include "AI/WotBTService_CheckAttackRange.h"
+#include "AI/WotVisibilitySubsystem.h"
 #include "BehaviorTree/BlackboardComponent.h"
+#include "BehaviorTree/BlackboardData.h"
+#include "BehaviorTree/Blackboard/BlackboardKeyType_Bool.h"
+#include "BehaviorTree/Blackboard/BlackboardKeyType_Object.h"
 #include "AIController.h"
 
+UWotBTService_CheckAttackRange::UWotBTService_CheckAttackRange()
+{
+  TargetActorKey.SelectedKeyName = "TargetActor";
+  TargetActorKey.AddObjectFilter(this, GET_MEMBER_NAME_CHECKED(UWotBTService_CheckAttackRange, TargetActorKey), AActor::StaticClass());
+  AttackRangeKey.AddBoolFilter(this, GET_MEMBER_NAME_CHECKED(UWotBTService_CheckAttackRange, AttackRangeKey));
+}
+
+void UWotBTService_CheckAttackRange::InitializeFromAsset(UBehaviorTree& Asset)
+{
+  Super::InitializeFromAsset(Asset);
+
+  if (UBlackboardData* BlackboardAsset = GetBlackboardAsset()) {
+    TargetActorKey.ResolveSelectedKey(*BlackboardAsset);
+    AttackRangeKey.ResolveSelectedKey(*BlackboardAsset);
+  }
+}
+
 void UWotBTService_CheckAttackRange::TickNode(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory, float DeltaSeconds)
 {
   Super::TickNode(OwnerComp, NodeMemory, DeltaSeconds);
@@ -11,22 +32,25 @@ void UWotBTService_CheckAttackRange::TickNode(UBehaviorTreeComponent& OwnerComp,
 
   // check distance between AI pawn and target actor
   UBlackboardComponent* BlackboardComp = OwnerComp.GetBlackboardComponent();
-  if (ensure(BlackboardComp)) {
-    AActor* TargetActor = Cast<AActor>(BlackboardComp->GetValueAsObject("TargetActor"));
-    if (TargetActor) {
-      AAIController* MyController = OwnerComp.GetAIOwner();
-      if (ensure(MyController)) {
-        APawn* AIPawn = MyController->GetPawn();
-        if (ensure(AIPawn)) {
-          float DistanceTo = FVector::Distance(TargetActor->GetActorLocation(), AIPawn->GetActorLocation());
-          bWithinRange = DistanceTo < AttackRange;
+  if (!ensure(BlackboardComp)) {
+    return;
+  }
+  AActor* TargetActor = Cast<AActor>(BlackboardComp->GetValue<UBlackboardKeyType_Object>(TargetActorKey.GetSelectedKeyID()));
+  if (TargetActor) {
+    AAIController* MyController = OwnerComp.GetAIOwner();
+    if (ensure(MyController)) {
+      APawn* AIPawn = MyController->GetPawn();
+      if (ensure(AIPawn)) {
+        float DistanceTo = FVector::Distance(TargetActor->GetActorLocation(), AIPawn->GetActorLocation());
+        bWithinRange = DistanceTo < AttackRange;
 
-          if (bWithinRange) {
-            bHasLineOfSight = MyController->LineOfSightTo(TargetActor);
-          }
+        if (bWithinRange) {
+          // shared with every other AI watching the same target, see UWotVisibilitySubsystem
+          UWotVisibilitySubsystem* Visibility = UWotVisibilitySubsystem::GetIfEnabled(AIPawn);
+          bHasLineOfSight = Visibility ? Visibility->HasLineOfSight(AIPawn, TargetActor) : MyController->LineOfSightTo(TargetActor);
         }
       }
     }
   }
-  BlackboardComp->SetValueAsBool(AttackRangeKey.SelectedKeyName, (bWithinRange && bHasLineOfSight));
+  BlackboardComp->SetValue<UBlackboardKeyType_Bool>(AttackRangeKey.GetSelectedKeyID(), (bWithinRange && bHasLineOfSight));
 }
@@ -1,7 +1,27 @@
 #include "AI/WotBTService_CheckHidden.h"
+#include "AI/WotVisibilitySubsystem.h"
 #include "BehaviorTree/BlackboardComponent.h"
+#include "BehaviorTree/BlackboardData.h"
+#include "BehaviorTree/Blackboard/BlackboardKeyType_Bool.h"
+#include "BehaviorTree/Blackboard/BlackboardKeyType_Object.h"
 #include "AIController.h"
 
+UWotBTService_CheckHidden::UWotBTService_CheckHidden()
+{
+  ActorToHideFromKey.AddObjectFilter(this, GET_MEMBER_NAME_CHECKED(UWotBTService_CheckHidden, ActorToHideFromKey), AActor::StaticClass());
+  HiddenKey.AddBoolFilter(this, GET_MEMBER_NAME_CHECKED(UWotBTService_CheckHidden, HiddenKey));
+}
+
+void UWotBTService_CheckHidden::InitializeFromAsset(UBehaviorTree& Asset)
+{
+  Super::InitializeFromAsset(Asset);
+
+  if (UBlackboardData* BlackboardAsset = GetBlackboardAsset()) {
+    ActorToHideFromKey.ResolveSelectedKey(*BlackboardAsset);
+    HiddenKey.ResolveSelectedKey(*BlackboardAsset);
+  }
+}
+
 void UWotBTService_CheckHidden::TickNode(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory, float DeltaSeconds)
 {
   Super::TickNode(OwnerComp, NodeMemory, DeltaSeconds);
@@ -11,22 +31,25 @@ void UWotBTService_CheckHidden::TickNode(UBehaviorTreeComponent& OwnerComp, uint
 
   // check distance between AI pawn and target actor
   UBlackboardComponent* BlackboardComp = OwnerComp.GetBlackboardComponent();
-  if (ensure(BlackboardComp)) {
-    AActor* ActorToHideFrom = Cast<AActor>(BlackboardComp->GetValueAsObject(ActorToHideFromKey.SelectedKeyName));
-    if (ActorToHideFrom) {
-      AAIController* MyController = OwnerComp.GetAIOwner();
-      if (ensure(MyController)) {
-        APawn* AIPawn = MyController->GetPawn();
-        if (ensure(AIPawn)) {
-          float DistanceTo = FVector::Distance(ActorToHideFrom->GetActorLocation(), AIPawn->GetActorLocation());
-          bWithinRange = DistanceTo < MaxHideRange;
+  if (!ensure(BlackboardComp)) {
+    return;
+  }
+  AActor* ActorToHideFrom = Cast<AActor>(BlackboardComp->GetValue<UBlackboardKeyType_Object>(ActorToHideFromKey.GetSelectedKeyID()));
+  if (ActorToHideFrom) {
+    AAIController* MyController = OwnerComp.GetAIOwner();
+    if (ensure(MyController)) {
+      APawn* AIPawn = MyController->GetPawn();
+      if (ensure(AIPawn)) {
+        float DistanceTo = FVector::Distance(ActorToHideFrom->GetActorLocation(), AIPawn->GetActorLocation());
+        bWithinRange = DistanceTo < MaxHideRange;
 
-          if (bWithinRange) {
-            bHasLineOfSight = MyController->LineOfSightTo(ActorToHideFrom);
-          }
+        if (bWithinRange) {
+          // shared with every other AI watching the same actor, see UWotVisibilitySubsystem
+          UWotVisibilitySubsystem* Visibility = UWotVisibilitySubsystem::GetIfEnabled(AIPawn);
+          bHasLineOfSight = Visibility ? Visibility->HasLineOfSight(AIPawn, ActorToHideFrom) : MyController->LineOfSightTo(ActorToHideFrom);
         }
       }
     }
   }
-  BlackboardComp->SetValueAsBool(HiddenKey.SelectedKeyName, (!bWithinRange || !bHasLineOfSight));
+  BlackboardComp->SetValue<UBlackboardKeyType_Bool>(HiddenKey.GetSelectedKeyID(), (!bWithinRange || !bHasLineOfSight));
 }
@@ -17,8 +17,7 @@ void UWotBTService_CheckLowHealth::TickNode(UBehaviorTreeComponent& OwnerComp, u
       APawn* AIPawn = MyController->GetPawn();
       if (ensure(AIPawn)) {
         // get the attribute component of the AI pawn
-        UWotAttributeComponent* AttributeComp =
-          Cast<UWotAttributeComponent>(AIPawn->GetComponentByClass(UWotAttributeComponent::StaticClass()));
+        UWotAttributeComponent* AttributeComp = UWotAttributeComponent::GetAttributes(AIPawn);
         // if there's no attribute component, return
         if (!AttributeComp) {
           return;
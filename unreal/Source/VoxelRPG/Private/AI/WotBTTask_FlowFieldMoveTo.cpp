@@ -0,0 +1,104 @@
+#include "AI/WotBTTask_FlowFieldMoveTo.h"
+#include "AI/WotFlowFieldSubsystem.h"
+#include "AIController.h"
+#include "BehaviorTree/BlackboardComponent.h"
+#include "BehaviorTree/Blackboard/BlackboardKeyType_Object.h"
+#include "Navigation/PathFollowingComponent.h"
+
+UWotBTTask_FlowFieldMoveTo::UWotBTTask_FlowFieldMoveTo()
+{
+  NodeName = "Flow Field Move To";
+  TargetActorKey.SelectedKeyName = "TargetActor";
+  TargetActorKey.AddObjectFilter(this, GET_MEMBER_NAME_CHECKED(UWotBTTask_FlowFieldMoveTo, TargetActorKey), AActor::StaticClass());
+  AcceptableRadius = 100.0f;
+  bNotifyTick = true;
+}
+
+void UWotBTTask_FlowFieldMoveTo::InitializeFromAsset(UBehaviorTree& Asset)
+{
+  Super::InitializeFromAsset(Asset);
+
+  if (UBlackboardData* BlackboardAsset = GetBlackboardAsset()) {
+    TargetActorKey.ResolveSelectedKey(*BlackboardAsset);
+  }
+}
+
+uint16 UWotBTTask_FlowFieldMoveTo::GetInstanceMemorySize() const
+{
+  return sizeof(FMoveMemory);
+}
+
+EBTNodeResult::Type UWotBTTask_FlowFieldMoveTo::ExecuteTask(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory)
+{
+  FMoveMemory& Memory = *reinterpret_cast<FMoveMemory*>(NodeMemory);
+  Memory.bFollowingPath = false;
+  return Move(OwnerComp, Memory);
+}
+
+void UWotBTTask_FlowFieldMoveTo::TickTask(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory, float DeltaSeconds)
+{
+  FMoveMemory& Memory = *reinterpret_cast<FMoveMemory*>(NodeMemory);
+  const EBTNodeResult::Type Result = Move(OwnerComp, Memory);
+  if (Result != EBTNodeResult::InProgress) {
+    FinishLatentTask(OwnerComp, Result);
+  }
+}
+
+EBTNodeResult::Type UWotBTTask_FlowFieldMoveTo::AbortTask(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory)
+{
+  FMoveMemory& Memory = *reinterpret_cast<FMoveMemory*>(NodeMemory);
+  AAIController* MyController = OwnerComp.GetAIOwner();
+  if (Memory.bFollowingPath && MyController) {
+    MyController->StopMovement();
+  }
+  return EBTNodeResult::Aborted;
+}
+
+EBTNodeResult::Type UWotBTTask_FlowFieldMoveTo::Move(UBehaviorTreeComponent& OwnerComp, FMoveMemory& Memory)
+{
+  AAIController* MyController = OwnerComp.GetAIOwner();
+  if (!ensure(MyController)) {
+    return EBTNodeResult::Failed;
+  }
+  APawn* MyPawn = MyController->GetPawn();
+  AActor* TargetActor = Cast<AActor>(OwnerComp.GetBlackboardComponent()->GetValue<UBlackboardKeyType_Object>(TargetActorKey.GetSelectedKeyID()));
+  if (MyPawn == nullptr || TargetActor == nullptr) {
+    if (Memory.bFollowingPath && MyController) {
+      MyController->StopMovement();
+    }
+    return EBTNodeResult::Failed;
+  }
+
+  const FVector Location = MyPawn->GetActorLocation();
+  if (FVector::Dist2D(Location, TargetActor->GetActorLocation()) <= AcceptableRadius) {
+    if (Memory.bFollowingPath) {
+      MyController->StopMovement();
+    }
+    return EBTNodeResult::Succeeded;
+  }
+
+  FVector Direction;
+  UWotFlowFieldSubsystem* FlowField = UWotFlowFieldSubsystem::GetIfEnabled(MyPawn);
+  if (FlowField && FlowField->GetFlowDirection(TargetActor, Location, Direction)) {
+    if (Memory.bFollowingPath) {
+      MyController->StopMovement();
+      Memory.bFollowingPath = false;
+    }
+    MyPawn->AddMovementInput(Direction);
+    return EBTNodeResult::InProgress;
+  }
+
+  // outside of the field, follow a path until back in it
+  if (!Memory.bFollowingPath) {
+    if (MyController->MoveToActor(TargetActor, AcceptableRadius) == EPathFollowingRequestResult::Failed) {
+      return EBTNodeResult::Failed;
+    }
+    Memory.bFollowingPath = true;
+    return EBTNodeResult::InProgress;
+  }
+  if (MyController->GetMoveStatus() == EPathFollowingStatus::Idle) {
+    // the move ended without getting in range
+    return EBTNodeResult::Failed;
+  }
+  return EBTNodeResult::InProgress;
+}
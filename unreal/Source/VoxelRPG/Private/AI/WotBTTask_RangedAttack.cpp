@@ -3,6 +3,7 @@
 #include "GameFramework/Character.h"
 #include "BehaviorTree/BlackboardComponent.h"
 #include "WotAttributeComponent.h"
+#include "WotActorPoolSubsystem.h"
 
 UWotBTTask_RangedAttack::UWotBTTask_RangedAttack()
 {
@@ -45,7 +46,7 @@ EBTNodeResult::Type UWotBTTask_RangedAttack::ExecuteTask(UBehaviorTreeComponent&
     // Set the instigator so the projectile doesn't interact / damage the owner pawn
     Params.Instigator = MyPawn;
 
-    AActor* NewProj = GetWorld()->SpawnActor<AActor>(ProjectileClass, SpawnLocation, SpawnRotation, Params);
+    AActor* NewProj = UWotActorPoolSubsystem::SpawnPooled(MyPawn, ProjectileClass, FTransform(SpawnRotation, SpawnLocation), Params);
 
     return NewProj ? EBTNodeResult::Succeeded : EBTNodeResult::Failed;
   }
@@ -0,0 +1,112 @@
+#include "AI/WotBotRegistrySubsystem.h"
+#include "AI/WotAICharacter.h"
+#include "WotAttributeComponent.h"
+#include "Engine/World.h"
+
+UWotBotRegistrySubsystem* UWotBotRegistrySubsystem::Get(const UObject* WorldContextObject)
+{
+  if (!WorldContextObject) {
+    return nullptr;
+  }
+  UWorld* World = WorldContextObject->GetWorld();
+  return World ? World->GetSubsystem<UWotBotRegistrySubsystem>() : nullptr;
+}
+
+void UWotBotRegistrySubsystem::RegisterBot(AWotAICharacter* Bot)
+{
+  if (!ensure(Bot)) {
+    return;
+  }
+  if (RegisteredIndices.Contains(Bot)) {
+    return;
+  }
+  RegisteredIndices.Add(Bot, RegisteredBots.Add(Bot));
+  UWotAttributeComponent* AttributeComp = UWotAttributeComponent::GetAttributes(Bot);
+  if (AttributeComp) {
+    AttributeComp->OnKilled.AddUniqueDynamic(this, &UWotBotRegistrySubsystem::OnBotKilled);
+  }
+  if (!AttributeComp || AttributeComp->IsAlive()) {
+    AddAlive(Bot);
+  }
+}
+
+void UWotBotRegistrySubsystem::UnregisterBot(AWotAICharacter* Bot)
+{
+  if (!RegisteredIndices.Contains(Bot)) {
+    return;
+  }
+  UWotAttributeComponent* AttributeComp = UWotAttributeComponent::GetAttributes(Bot);
+  if (AttributeComp) {
+    AttributeComp->OnKilled.RemoveDynamic(this, &UWotBotRegistrySubsystem::OnBotKilled);
+  }
+  RemoveAlive(Bot);
+  RemoveSwap(RegisteredBots, RegisteredIndices, Bot);
+}
+
+int32 UWotBotRegistrySubsystem::GetNumAliveBots() const
+{
+  return AliveBots.Num();
+}
+
+int32 UWotBotRegistrySubsystem::GetNumAliveBotsOfClass(TSubclassOf<AWotAICharacter> BotClass) const
+{
+  const int32* Count = AliveCountByClass.Find(BotClass.Get());
+  return Count ? *Count : 0;
+}
+
+int32 UWotBotRegistrySubsystem::GetNumAliveBotsInFaction(FGameplayTag Faction) const
+{
+  const int32* Count = AliveCountByFaction.Find(Faction);
+  return Count ? *Count : 0;
+}
+
+void UWotBotRegistrySubsystem::OnBotKilled(AActor* InstigatorActor, UWotAttributeComponent* OwningComp)
+{
+  if (!OwningComp) {
+    return;
+  }
+  RemoveAlive(Cast<AWotAICharacter>(OwningComp->GetOwner()));
+}
+
+void UWotBotRegistrySubsystem::AddAlive(AWotAICharacter* Bot)
+{
+  if (AliveIndices.Contains(Bot)) {
+    return;
+  }
+  AliveIndices.Add(Bot, AliveBots.Add(Bot));
+  AliveCountByClass.FindOrAdd(Bot->GetClass())++;
+  AliveCountByFaction.FindOrAdd(Bot->GetFaction())++;
+}
+
+void UWotBotRegistrySubsystem::RemoveAlive(AWotAICharacter* Bot)
+{
+  if (!Bot || !AliveIndices.Contains(Bot)) {
+    return;
+  }
+  RemoveSwap(AliveBots, AliveIndices, Bot);
+  // counts never go below zero, and empty entries are dropped so the maps stay
+  // as small as the number of live classes / factions
+  if (int32* ClassCount = AliveCountByClass.Find(Bot->GetClass())) {
+    if (--(*ClassCount) <= 0) {
+      AliveCountByClass.Remove(Bot->GetClass());
+    }
+  }
+  if (int32* FactionCount = AliveCountByFaction.Find(Bot->GetFaction())) {
+    if (--(*FactionCount) <= 0) {
+      AliveCountByFaction.Remove(Bot->GetFaction());
+    }
+  }
+}
+
+void UWotBotRegistrySubsystem::RemoveSwap(TArray<AWotAICharacter*>& Array, TMap<AWotAICharacter*, int32>& Indices, AWotAICharacter* Bot)
+{
+  int32 Index;
+  if (!Indices.RemoveAndCopyValue(Bot, Index)) {
+    return;
+  }
+  Array.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+  // fix up the index of the bot that was swapped into the hole
+  if (Array.IsValidIndex(Index)) {
+    Indices[Array[Index]] = Index;
+  }
+}
@@ -0,0 +1,32 @@
+#include "AI/WotEnvQueryGenerator_SpawnPoints.h"
+#include "AI/WotSpawnPointSubsystem.h"
+#include "EnvironmentQuery/Contexts/EnvQueryContext_Querier.h"
+#include "EnvironmentQuery/Items/EnvQueryItemType_Point.h"
+
+UWotEnvQueryGenerator_SpawnPoints::UWotEnvQueryGenerator_SpawnPoints()
+{
+  GenerateAround = UEnvQueryContext_Querier::StaticClass();
+  ItemType = UEnvQueryItemType_Point::StaticClass();
+}
+
+void UWotEnvQueryGenerator_SpawnPoints::GenerateItems(FEnvQueryInstance& QueryInstance) const
+{
+  UWotSpawnPointSubsystem* SpawnPoints = UWotSpawnPointSubsystem::Get(QueryInstance.Owner.Get());
+  if (!SpawnPoints || !SpawnPoints->IsGridBuilt()) {
+    return;
+  }
+  TArray<FVector> ContextLocations;
+  QueryInstance.PrepareContext(GenerateAround, ContextLocations);
+  TArray<FVector> Locations;
+  for (const FVector& ContextLocation : ContextLocations) {
+    SpawnPoints->GetCachedLocations(ContextLocation, Radius, bOnlyHiddenFromPlayers, Locations);
+  }
+  for (const FVector& Location : Locations) {
+    QueryInstance.AddItemData<UEnvQueryItemType_Point>(Location);
+  }
+}
+
+FText UWotEnvQueryGenerator_SpawnPoints::GetDescriptionTitle() const
+{
+  return FText::Format(FText::FromString("Cached Spawn Points around {0}"), UEnvQueryTypes::DescribeContext(GenerateAround));
+}
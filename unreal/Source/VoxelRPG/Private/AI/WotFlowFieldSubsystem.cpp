@@ -0,0 +1,338 @@
+#include "AI/WotFlowFieldSubsystem.h"
+#include "NavigationSystem.h"
+#include "NavigationData.h"
+#include "Engine/World.h"
+
+static TAutoConsoleVariable<bool> CVarFlowFieldEnabled(TEXT("wot.FlowField.Enabled"), true, TEXT("Steer agents chasing a common goal with a shared flow field instead of a path query each"), ECVF_Cheat);
+static TAutoConsoleVariable<float> CVarFlowFieldCellSize(TEXT("wot.FlowField.CellSize"), 100.0f, TEXT("Size of the flow field cells, applies to fields built afterwards"), ECVF_Cheat);
+static TAutoConsoleVariable<float> CVarFlowFieldRadius(TEXT("wot.FlowField.Radius"), 4000.0f, TEXT("How far around its goal a flow field reaches, applies to fields built afterwards"), ECVF_Cheat);
+static TAutoConsoleVariable<float> CVarFlowFieldUpdateInterval(TEXT("wot.FlowField.UpdateInterval"), 0.1f, TEXT("Seconds between moving the flow fields along with their goals"), ECVF_Cheat);
+static TAutoConsoleVariable<int32> CVarFlowFieldMaxProjectionsPerFrame(TEXT("wot.FlowField.MaxProjectionsPerFrame"), 128, TEXT("Maximum number of cells projected onto the navmesh per frame, each with a raycast to its projected neighbors"), ECVF_Cheat);
+static TAutoConsoleVariable<int32> CVarFlowFieldMaxIntegrationStepsPerFrame(TEXT("wot.FlowField.MaxIntegrationStepsPerFrame"), 4096, TEXT("Maximum number of cells whose costs are settled per frame"), ECVF_Cheat);
+
+// fields not sampled for this long are dropped
+static constexpr double FieldTimeout = 5.0;
+
+// how far above and below the goal cells are projected onto the navmesh
+static constexpr float ProjectHeight = 1000.0f;
+
+static FAutoConsoleCommandWithWorld FlowFieldStatsCommand(
+  TEXT("wot.FlowField.Stats"),
+  TEXT("Logs the flow field counters"),
+  FConsoleCommandWithWorldDelegate::CreateLambda([](UWorld* World) {
+    UWotFlowFieldSubsystem* FlowField = UWotFlowFieldSubsystem::Get(World);
+    if (!FlowField) {
+      return;
+    }
+    const FWotFlowFieldCounters Counters = FlowField->GetCounters();
+    UE_LOG(LogTemp, Log, TEXT("Flow field: %d fields, builds %d, updates %d, cells projected %d, edge raycasts %d, samples %d (%d misses), last update %.1f us"),
+      FlowField->GetNumFields(), Counters.FieldBuilds, Counters.FieldUpdates, Counters.CellsProjected,
+      Counters.EdgeRaycasts, Counters.Samples, Counters.SampleMisses, FlowField->GetLastTickMicroseconds());
+  }));
+
+UWotFlowFieldSubsystem* UWotFlowFieldSubsystem::Get(const UObject* WorldContextObject)
+{
+  if (!WorldContextObject) {
+    return nullptr;
+  }
+  UWorld* World = WorldContextObject->GetWorld();
+  return World ? World->GetSubsystem<UWotFlowFieldSubsystem>() : nullptr;
+}
+
+UWotFlowFieldSubsystem* UWotFlowFieldSubsystem::GetIfEnabled(const UObject* WorldContextObject)
+{
+  return CVarFlowFieldEnabled.GetValueOnGameThread() ? Get(WorldContextObject) : nullptr;
+}
+
+void UWotFlowFieldSubsystem::ResetCounters()
+{
+  Counters = FWotFlowFieldCounters();
+}
+
+TStatId UWotFlowFieldSubsystem::GetStatId() const
+{
+  RETURN_QUICK_DECLARE_CYCLE_STAT(UWotFlowFieldSubsystem, STATGROUP_Tickables);
+}
+
+FIntPoint UWotFlowFieldSubsystem::ToCell(const FVector& Location, float CellSize) const
+{
+  return FIntPoint(FMath::FloorToInt32(Location.X / CellSize), FMath::FloorToInt32(Location.Y / CellSize));
+}
+
+bool UWotFlowFieldSubsystem::GetFlowDirection(AActor* Goal, FVector Location, FVector& OutDirection)
+{
+  if (!Goal) {
+    return false;
+  }
+  const FVector GoalLocation = Goal->GetActorLocation();
+  FField* Field = Fields.Find(Goal);
+  if (!Field) {
+    // built over the next frames, agents fall back to their own paths until
+    // the first flow is done
+    Field = &Fields.Add(Goal);
+    Field->Goal = Goal;
+    Field->CellSize = FMath::Max(CVarFlowFieldCellSize.GetValueOnGameThread(), 25.0f);
+    const FIntPoint GoalCell = ToCell(GoalLocation, Field->CellSize);
+    Recenter(*Field, GoalCell, GoalLocation.Z);
+    StartIntegration(*Field, GoalCell);
+    Counters.FieldBuilds++;
+  }
+  Field->LastSampleTime = GetWorld()->GetTimeSeconds();
+  Counters.Samples++;
+
+  const FIntPoint Cell = ToCell(Location, Field->CellSize);
+  if (!Field->FlowContains(Cell)) {
+    Counters.SampleMisses++;
+    return false;
+  }
+  if (Cell == Field->FlowGoalCell) {
+    OutDirection = (GoalLocation - Location).GetSafeNormal2D();
+    return !OutDirection.IsZero();
+  }
+  const int32 Next = Field->Next[(Cell.Y - Field->FlowOrigin.Y) * Field->FlowSize + (Cell.X - Field->FlowOrigin.X)];
+  if (Next == INDEX_NONE) {
+    Counters.SampleMisses++;
+    return false;
+  }
+  const FVector NextCenter(
+    (Field->FlowOrigin.X + Next % Field->FlowSize + 0.5f) * Field->CellSize,
+    (Field->FlowOrigin.Y + Next / Field->FlowSize + 0.5f) * Field->CellSize,
+    Location.Z);
+  OutDirection = (NextCenter - Location).GetSafeNormal2D();
+  return !OutDirection.IsZero();
+}
+
+void UWotFlowFieldSubsystem::Recenter(FField& Field, const FIntPoint& Center, float Height)
+{
+  const int32 Size = FMath::Max(FMath::CeilToInt32(2.0f * CVarFlowFieldRadius.GetValueOnGameThread() / Field.CellSize), 1);
+  const FIntPoint Origin = Center - FIntPoint(Size / 2, Size / 2);
+  const int32 NumCells = Size * Size;
+
+  TArray<bool> Projected;
+  TArray<bool> Walkable;
+  TArray<FVector> Points;
+  TArray<uint16> Blocked;
+  Projected.SetNumZeroed(NumCells);
+  Walkable.SetNumZeroed(NumCells);
+  Points.SetNumZeroed(NumCells);
+  Blocked.SetNumZeroed(NumCells);
+  Field.ProjectQueue.Reset();
+  for (int32 Y = 0; Y < Size; Y++) {
+    for (int32 X = 0; X < Size; X++) {
+      const FIntPoint Cell = Origin + FIntPoint(X, Y);
+      const int32 Index = Y * Size + X;
+      if (Field.Size > 0 && Field.Contains(Cell) && Field.Projected[Field.ToIndex(Cell)]) {
+        const int32 OldIndex = Field.ToIndex(Cell);
+        Projected[Index] = true;
+        Walkable[Index] = Field.Walkable[OldIndex];
+        Points[Index] = Field.Points[OldIndex];
+        // the edges to cells that are new are set when those are projected
+        Blocked[Index] = Field.Blocked[OldIndex];
+        continue;
+      }
+      Field.ProjectQueue.Add(Index);
+    }
+  }
+  Field.Origin = Origin;
+  Field.Size = Size;
+  Field.ProjectZ = Height;
+  Field.Projected = MoveTemp(Projected);
+  Field.Walkable = MoveTemp(Walkable);
+  Field.Points = MoveTemp(Points);
+  Field.Blocked = MoveTemp(Blocked);
+}
+
+void UWotFlowFieldSubsystem::Project(FField& Field)
+{
+  if (Field.ProjectQueue.Num() == 0) {
+    return;
+  }
+  UNavigationSystemV1* NavSys = FNavigationSystem::GetCurrent<UNavigationSystemV1>(GetWorld());
+  const ANavigationData* NavData = NavSys ? NavSys->GetDefaultNavDataInstance(FNavigationSystem::DontCreate) : nullptr;
+  FSharedConstNavQueryFilter QueryFilter;
+  if (NavData) {
+    QueryFilter = NavData->GetDefaultQueryFilter();
+  }
+  const FVector ProjectExtent(Field.CellSize * 0.5f, Field.CellSize * 0.5f, ProjectHeight);
+  while (ProjectionsLeft > 0 && Field.ProjectQueue.Num() > 0) {
+    const int32 Index = Field.ProjectQueue.Pop(EAllowShrinking::No);
+    ProjectionsLeft--;
+    Counters.CellsProjected++;
+    Field.Projected[Index] = true;
+    const int32 X = Index % Field.Size;
+    const int32 Y = Index / Field.Size;
+    FNavLocation NavLocation;
+    const FVector CellCenter((Field.Origin.X + X + 0.5f) * Field.CellSize, (Field.Origin.Y + Y + 0.5f) * Field.CellSize, Field.ProjectZ);
+    if (!NavData || !NavSys->ProjectPointToNavigation(CellCenter, NavLocation, ProjectExtent, NavData)) {
+      continue;
+    }
+    Field.Walkable[Index] = true;
+    Field.Points[Index] = NavLocation.Location;
+    // a straight line on the navmesh to each neighbor projected before, so
+    // every edge is checked once
+    for (int32 DY = -1; DY <= 1; DY++) {
+      for (int32 DX = -1; DX <= 1; DX++) {
+        const int32 NX = X + DX;
+        const int32 NY = Y + DY;
+        if ((DX == 0 && DY == 0) || NX < 0 || NY < 0 || NX >= Field.Size || NY >= Field.Size) {
+          continue;
+        }
+        const int32 Neighbor = NY * Field.Size + NX;
+        if (!Field.Projected[Neighbor] || !Field.Walkable[Neighbor]) {
+          continue;
+        }
+        Counters.EdgeRaycasts++;
+        FVector HitLocation;
+        const int32 Bit = DirectionBit(DX, DY);
+        if (NavData->Raycast(Field.Points[Index], Field.Points[Neighbor], HitLocation, QueryFilter)) {
+          Field.Blocked[Index] |= 1 << Bit;
+          Field.Blocked[Neighbor] |= 1 << (8 - Bit);
+        } else {
+          Field.Blocked[Index] &= ~(1 << Bit);
+          Field.Blocked[Neighbor] &= ~(1 << (8 - Bit));
+        }
+      }
+    }
+  }
+}
+
+void UWotFlowFieldSubsystem::StartIntegration(FField& Field, const FIntPoint& GoalCell)
+{
+  Field.bIntegrating = true;
+  Field.bIntegrationSeeded = false;
+  Field.IntegrationGoalCell = GoalCell;
+}
+
+void UWotFlowFieldSubsystem::Integrate(FField& Field)
+{
+  const auto CheaperFirst = [](const FOpenCell& A, const FOpenCell& B) { return A.Cost < B.Cost; };
+  if (!Field.bIntegrationSeeded) {
+    const int32 NumCells = Field.Size * Field.Size;
+    Field.Costs.Init(TNumericLimits<float>::Max(), NumCells);
+    Field.IntegrationNext.Init(INDEX_NONE, NumCells);
+    Field.Open.Reset();
+    // the goal cell is where the costs start from even if the goal is not
+    // on the navmesh
+    if (Field.Contains(Field.IntegrationGoalCell)) {
+      const int32 GoalIndex = Field.ToIndex(Field.IntegrationGoalCell);
+      Field.Costs[GoalIndex] = 0.0f;
+      Field.Open.HeapPush(FOpenCell{ 0.0f, GoalIndex }, CheaperFirst);
+    }
+    Field.bIntegrationSeeded = true;
+  }
+
+  // neighbors higher or lower than this are not connected
+  const float MaxStepHeight = Field.CellSize;
+  const float DiagonalCost = Field.CellSize * UE_SQRT_2;
+  while (IntegrationStepsLeft > 0 && Field.Open.Num() > 0) {
+    FOpenCell Current;
+    Field.Open.HeapPop(Current, CheaperFirst, EAllowShrinking::No);
+    if (Current.Cost > Field.Costs[Current.Index]) {
+      continue;
+    }
+    IntegrationStepsLeft--;
+    const int32 X = Current.Index % Field.Size;
+    const int32 Y = Current.Index / Field.Size;
+    const bool bCurrentWalkable = Field.Walkable[Current.Index];
+    for (int32 DY = -1; DY <= 1; DY++) {
+      for (int32 DX = -1; DX <= 1; DX++) {
+        const int32 NX = X + DX;
+        const int32 NY = Y + DY;
+        if ((DX == 0 && DY == 0) || NX < 0 || NY < 0 || NX >= Field.Size || NY >= Field.Size) {
+          continue;
+        }
+        const int32 Neighbor = NY * Field.Size + NX;
+        if (!Field.Walkable[Neighbor]) {
+          continue;
+        }
+        // walls and drops between the two cells
+        if (bCurrentWalkable && (Field.Blocked[Current.Index] & (1 << DirectionBit(DX, DY)))) {
+          continue;
+        }
+        if (bCurrentWalkable && FMath::Abs(Field.Points[Neighbor].Z - Field.Points[Current.Index].Z) > MaxStepHeight) {
+          continue;
+        }
+        const bool bDiagonal = DX != 0 && DY != 0;
+        // don't cut corners around cells off the navmesh
+        if (bDiagonal && (!Field.Walkable[Y * Field.Size + NX] || !Field.Walkable[NY * Field.Size + X])) {
+          continue;
+        }
+        const float Cost = Current.Cost + (bDiagonal ? DiagonalCost : Field.CellSize);
+        if (Cost < Field.Costs[Neighbor]) {
+          Field.Costs[Neighbor] = Cost;
+          Field.IntegrationNext[Neighbor] = Current.Index;
+          Field.Open.HeapPush(FOpenCell{ Cost, Neighbor }, CheaperFirst);
+        }
+      }
+    }
+  }
+  if (Field.Open.Num() > 0) {
+    return;
+  }
+  // done, agents steer by it from now on
+  Field.Next = MoveTemp(Field.IntegrationNext);
+  Field.FlowOrigin = Field.Origin;
+  Field.FlowSize = Field.Size;
+  Field.FlowGoalCell = Field.IntegrationGoalCell;
+  Field.Costs.Reset();
+  Field.bIntegrating = false;
+  Field.bIntegrationSeeded = false;
+  Counters.FieldUpdates++;
+}
+
+bool UWotFlowFieldSubsystem::UpdateField(FField& Field, bool bMoveGoal)
+{
+  AActor* Goal = Field.Goal.Get();
+  if (!Goal || GetWorld()->GetTimeSeconds() - Field.LastSampleTime > FieldTimeout) {
+    return false;
+  }
+  // rebuilt on the next sample
+  if (Field.CellSize != FMath::Max(CVarFlowFieldCellSize.GetValueOnGameThread(), 25.0f)) {
+    return false;
+  }
+  // a goal that moves again before the integration is done is picked up
+  // after it, so a fast goal doesn't keep restarting it
+  if (bMoveGoal && !Field.bIntegrating) {
+    const FVector GoalLocation = Goal->GetActorLocation();
+    const FIntPoint GoalCell = ToCell(GoalLocation, Field.CellSize);
+    if (GoalCell != Field.FlowGoalCell) {
+      // recenter once the goal is a quarter of the grid away from the center
+      const FIntPoint Center = Field.Origin + FIntPoint(Field.Size / 2, Field.Size / 2);
+      const FIntPoint Offset = GoalCell - Center;
+      if (FMath::Max(FMath::Abs(Offset.X), FMath::Abs(Offset.Y)) > Field.Size / 4) {
+        Recenter(Field, GoalCell, GoalLocation.Z);
+      }
+      StartIntegration(Field, GoalCell);
+    }
+  }
+  Project(Field);
+  if (Field.bIntegrating && Field.ProjectQueue.Num() == 0) {
+    Integrate(Field);
+  }
+  return true;
+}
+
+void UWotFlowFieldSubsystem::Tick(float DeltaTime)
+{
+  if (!CVarFlowFieldEnabled.GetValueOnGameThread()) {
+    Fields.Empty();
+    return;
+  }
+  // goals are followed every UpdateInterval, the projection and integration
+  // they start continue every frame
+  const double Now = GetWorld()->GetTimeSeconds();
+  const bool bMoveGoals = Now >= NextUpdateTime;
+  if (bMoveGoals) {
+    NextUpdateTime = Now + CVarFlowFieldUpdateInterval.GetValueOnGameThread();
+  }
+  ProjectionsLeft = FMath::Max(CVarFlowFieldMaxProjectionsPerFrame.GetValueOnGameThread(), 1);
+  IntegrationStepsLeft = FMath::Max(CVarFlowFieldMaxIntegrationStepsPerFrame.GetValueOnGameThread(), 1);
+
+  const uint64 StartCycles = FPlatformTime::Cycles64();
+  for (auto It = Fields.CreateIterator(); It; ++It) {
+    if (!UpdateField(It.Value(), bMoveGoals)) {
+      It.RemoveCurrent();
+    }
+  }
+  LastTickMicroseconds = FPlatformTime::ToMilliseconds64(FPlatformTime::Cycles64() - StartCycles) * 1000.0;
+}
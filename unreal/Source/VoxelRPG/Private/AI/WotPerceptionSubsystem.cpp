@@ -0,0 +1,333 @@
+#include "AI/WotPerceptionSubsystem.h"
+#include "AI/WotAICharacter.h"
+#include "AI/WotVisibilitySubsystem.h"
+#include "WotAttributeComponent.h"
+#include "Perception/PawnSensingComponent.h"
+#include "GameFramework/Controller.h"
+#include "Engine/World.h"
+
+static TAutoConsoleVariable<bool> CVarPerceptionEnabled(TEXT("wot.Perception.Enabled"), true, TEXT("Let the perception subsystem do the sight checks of AI characters instead of their pawn sensing components, applied when a bot begins play"), ECVF_Cheat);
+static TAutoConsoleVariable<float> CVarPerceptionCellSize(TEXT("wot.Perception.CellSize"), 2000.0f, TEXT("Cell size of the spatial hash stimuli are bucketed in"), ECVF_Cheat);
+
+static FAutoConsoleCommandWithWorld PerceptionStatsCommand(
+  TEXT("wot.Perception.Stats"),
+  TEXT("Logs the perception subsystem counters"),
+  FConsoleCommandWithWorldDelegate::CreateLambda([](UWorld* World) {
+    UWotPerceptionSubsystem* Perception = UWotPerceptionSubsystem::Get(World);
+    if (!Perception) {
+      return;
+    }
+    const FWotPerceptionCounters Counters = Perception->GetCounters();
+    UE_LOG(LogTemp, Log, TEXT("Perception: %d sensors, %d stimuli, sensor updates %d, candidate pairs %d, in cone %d, targets gained %d, lost %d, last update %.1f us"),
+           Perception->GetNumSensors(), Perception->GetNumStimuli(), Counters.SensorUpdates, Counters.CandidatePairs,
+           Counters.PairsInCone, Counters.TargetsGained, Counters.TargetsLost, Perception->GetLastTickMicroseconds());
+  }));
+
+UWotPerceptionSubsystem* UWotPerceptionSubsystem::Get(const UObject* WorldContextObject)
+{
+  if (!WorldContextObject) {
+    return nullptr;
+  }
+  UWorld* World = WorldContextObject->GetWorld();
+  return World ? World->GetSubsystem<UWotPerceptionSubsystem>() : nullptr;
+}
+
+UWotPerceptionSubsystem* UWotPerceptionSubsystem::GetIfEnabled(const UObject* WorldContextObject)
+{
+  return CVarPerceptionEnabled.GetValueOnGameThread() ? Get(WorldContextObject) : nullptr;
+}
+
+void UWotPerceptionSubsystem::RegisterSensor(AWotAICharacter* Sensor, const UPawnSensingComponent* Config)
+{
+  if (!ensure(Sensor && Config) || SensorIndices.Contains(Sensor)) {
+    return;
+  }
+  SensorIndices.Add(Sensor, Sensors.Add(Sensor));
+  SightRadii.Add(Config->SightRadius);
+  PeripheralCosines.Add(Config->GetPeripheralVisionCosine());
+  const float Interval = FMath::Max(Config->SensingInterval, 0.0f);
+  SensingIntervals.Add(Interval);
+  // spread the updates of bots spawned together over their interval
+  NextUpdateTimes.Add(GetWorld()->GetTimeSeconds() + FMath::FRand() * Interval);
+  OnlySensePlayers.Add(Config->bOnlySensePlayers);
+  Targets.Add(nullptr);
+}
+
+void UWotPerceptionSubsystem::UnregisterSensor(AWotAICharacter* Sensor)
+{
+  if (const int32* Index = SensorIndices.Find(Sensor)) {
+    RemoveSensorAt(*Index);
+  }
+}
+
+void UWotPerceptionSubsystem::RemoveSensorAt(int32 Index)
+{
+  SensorIndices.Remove(Sensors[Index]);
+  Sensors.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+  SightRadii.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+  PeripheralCosines.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+  SensingIntervals.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+  NextUpdateTimes.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+  OnlySensePlayers.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+  Targets.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+  // fix up the index of the sensor that was swapped into the hole
+  if (Sensors.IsValidIndex(Index)) {
+    SensorIndices[Sensors[Index]] = Index;
+  }
+}
+
+void UWotPerceptionSubsystem::RegisterStimulus(APawn* Pawn)
+{
+  if (!ensure(Pawn) || StimulusIndices.Contains(Pawn)) {
+    return;
+  }
+  StimulusIndices.Add(Pawn, Stimuli.Add(Pawn));
+  StimulusIsPlayer.Add(false);
+}
+
+void UWotPerceptionSubsystem::UnregisterStimulus(APawn* Pawn)
+{
+  if (const int32* Index = StimulusIndices.Find(Pawn)) {
+    RemoveStimulusAt(*Index);
+  }
+}
+
+void UWotPerceptionSubsystem::RemoveStimulusAt(int32 Index)
+{
+  StimulusIndices.Remove(Stimuli[Index]);
+  Stimuli.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+  StimulusIsPlayer.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+  if (Stimuli.IsValidIndex(Index)) {
+    StimulusIndices[Stimuli[Index]] = Index;
+  }
+}
+
+APawn* UWotPerceptionSubsystem::GetSensedTarget(const AWotAICharacter* Sensor) const
+{
+  const int32* Index = SensorIndices.Find(Sensor);
+  return Index ? Targets[*Index].Get() : nullptr;
+}
+
+void UWotPerceptionSubsystem::ResetCounters()
+{
+  Counters = FWotPerceptionCounters();
+}
+
+void UWotPerceptionSubsystem::Deinitialize()
+{
+  Sensors.Empty();
+  SightRadii.Empty();
+  PeripheralCosines.Empty();
+  SensingIntervals.Empty();
+  NextUpdateTimes.Empty();
+  OnlySensePlayers.Empty();
+  Targets.Empty();
+  SensorIndices.Empty();
+  Stimuli.Empty();
+  StimulusIsPlayer.Empty();
+  StimulusIndices.Empty();
+  Cells.Empty();
+  Super::Deinitialize();
+}
+
+TStatId UWotPerceptionSubsystem::GetStatId() const
+{
+  RETURN_QUICK_DECLARE_CYCLE_STAT(UWotPerceptionSubsystem, STATGROUP_Tickables);
+}
+
+void UWotPerceptionSubsystem::BuildCells(float CellSize)
+{
+  // drop cells when the map grew well past what the stimuli need, otherwise
+  // keep their arrays allocated
+  if (Cells.Num() > 4 * Stimuli.Num() + 64) {
+    Cells.Reset();
+  } else {
+    for (auto& Cell : Cells) {
+      Cell.Value.Reset();
+    }
+  }
+  for (int32 Index = Stimuli.Num() - 1; Index >= 0; Index--) {
+    if (!IsValid(Stimuli[Index])) {
+      RemoveStimulusAt(Index);
+    }
+  }
+  StimulusX.SetNumUninitialized(Stimuli.Num(), EAllowShrinking::No);
+  StimulusY.SetNumUninitialized(Stimuli.Num(), EAllowShrinking::No);
+  StimulusZ.SetNumUninitialized(Stimuli.Num(), EAllowShrinking::No);
+  for (int32 Index = 0; Index < Stimuli.Num(); Index++) {
+    const FVector Location = Stimuli[Index]->GetActorLocation();
+    StimulusX[Index] = (float)Location.X;
+    StimulusY[Index] = (float)Location.Y;
+    StimulusZ[Index] = (float)Location.Z;
+    // possession can change after registering
+    StimulusIsPlayer[Index] = Stimuli[Index]->IsPlayerControlled();
+    const FIntPoint Cell(FMath::FloorToInt32(StimulusX[Index] / CellSize), FMath::FloorToInt32(StimulusY[Index] / CellSize));
+    Cells.FindOrAdd(Cell).Add(Index);
+  }
+}
+
+void UWotPerceptionSubsystem::Tick(float DeltaTime)
+{
+  const uint64 StartCycles = FPlatformTime::Cycles64();
+  const double Now = GetWorld()->GetTimeSeconds();
+
+  // prune first, removing swaps sensors around
+  for (int32 Index = Sensors.Num() - 1; Index >= 0; Index--) {
+    if (!IsValid(Sensors[Index])) {
+      RemoveSensorAt(Index);
+    }
+  }
+  Batches.Reset();
+  for (int32 Index = 0; Index < Sensors.Num(); Index++) {
+    if (Now >= NextUpdateTimes[Index]) {
+      NextUpdateTimes[Index] = Now + SensingIntervals[Index];
+      Batches.AddDefaulted_GetRef().SensorIndex = Index;
+    }
+  }
+  if (Batches.Num() == 0) {
+    return;
+  }
+
+  const float CellSize = FMath::Max(CVarPerceptionCellSize.GetValueOnGameThread(), 100.0f);
+  BuildCells(CellSize);
+
+  // pair every due sensor with the stimuli in the cells its sight radius
+  // covers
+  PairStimuli.Reset();
+  PairDeltaX.Reset();
+  PairDeltaY.Reset();
+  PairDeltaZ.Reset();
+  PairForwardX.Reset();
+  PairForwardY.Reset();
+  PairForwardZ.Reset();
+  PairRadiiSquared.Reset();
+  PairCosines.Reset();
+  for (FSensorBatch& Batch : Batches) {
+    const int32 SensorIndex = Batch.SensorIndex;
+    AWotAICharacter* Sensor = Sensors[SensorIndex];
+    FVector EyesLocation;
+    FRotator EyesRotation;
+    Sensor->GetActorEyesViewPoint(EyesLocation, EyesRotation);
+    const FVector Forward = EyesRotation.Vector();
+    const float Radius = SightRadii[SensorIndex];
+    const FIntPoint MinCell(FMath::FloorToInt32((EyesLocation.X - Radius) / CellSize), FMath::FloorToInt32((EyesLocation.Y - Radius) / CellSize));
+    const FIntPoint MaxCell(FMath::FloorToInt32((EyesLocation.X + Radius) / CellSize), FMath::FloorToInt32((EyesLocation.Y + Radius) / CellSize));
+    Batch.FirstPair = PairStimuli.Num();
+    for (int32 CellY = MinCell.Y; CellY <= MaxCell.Y; CellY++) {
+      for (int32 CellX = MinCell.X; CellX <= MaxCell.X; CellX++) {
+        const TArray<int32>* Cell = Cells.Find(FIntPoint(CellX, CellY));
+        if (!Cell) {
+          continue;
+        }
+        for (const int32 StimulusIndex : *Cell) {
+          if (Stimuli[StimulusIndex] == Sensor || (OnlySensePlayers[SensorIndex] && !StimulusIsPlayer[StimulusIndex])) {
+            continue;
+          }
+          PairStimuli.Add(StimulusIndex);
+          PairDeltaX.Add(StimulusX[StimulusIndex] - (float)EyesLocation.X);
+          PairDeltaY.Add(StimulusY[StimulusIndex] - (float)EyesLocation.Y);
+          PairDeltaZ.Add(StimulusZ[StimulusIndex] - (float)EyesLocation.Z);
+          PairForwardX.Add((float)Forward.X);
+          PairForwardY.Add((float)Forward.Y);
+          PairForwardZ.Add((float)Forward.Z);
+          PairRadiiSquared.Add(Radius * Radius);
+          PairCosines.Add(PeripheralCosines[SensorIndex]);
+        }
+      }
+    }
+    Batch.EndPair = PairStimuli.Num();
+  }
+
+  // distance and cone test of all pairs in one branch free pass over the
+  // flat arrays, which the compiler vectorizes; the cone test compares
+  // squares so no square root is needed
+  const int32 NumPairs = PairStimuli.Num();
+  PairDistancesSquared.SetNumUninitialized(NumPairs, EAllowShrinking::No);
+  PairInCone.SetNumUninitialized(NumPairs, EAllowShrinking::No);
+  const float* RESTRICT DeltaX = PairDeltaX.GetData();
+  const float* RESTRICT DeltaY = PairDeltaY.GetData();
+  const float* RESTRICT DeltaZ = PairDeltaZ.GetData();
+  const float* RESTRICT ForwardX = PairForwardX.GetData();
+  const float* RESTRICT ForwardY = PairForwardY.GetData();
+  const float* RESTRICT ForwardZ = PairForwardZ.GetData();
+  const float* RESTRICT RadiiSquared = PairRadiiSquared.GetData();
+  const float* RESTRICT Cosines = PairCosines.GetData();
+  float* RESTRICT DistancesSquared = PairDistancesSquared.GetData();
+  uint8* RESTRICT InCone = PairInCone.GetData();
+  for (int32 Pair = 0; Pair < NumPairs; Pair++) {
+    const float DistanceSquared = DeltaX[Pair] * DeltaX[Pair] + DeltaY[Pair] * DeltaY[Pair] + DeltaZ[Pair] * DeltaZ[Pair];
+    const float Dot = DeltaX[Pair] * ForwardX[Pair] + DeltaY[Pair] * ForwardY[Pair] + DeltaZ[Pair] * ForwardZ[Pair];
+    // Dot / Distance >= Cosine, for either sign of the cosine
+    const float CosineTerm = Cosines[Pair] * FMath::Abs(Cosines[Pair]) * DistanceSquared;
+    const float DotTerm = Dot * FMath::Abs(Dot);
+    DistancesSquared[Pair] = DistanceSquared;
+    InCone[Pair] = (uint8)((DistanceSquared <= RadiiSquared[Pair]) & (DotTerm >= CosineTerm));
+  }
+  Counters.SensorUpdates += Batches.Num();
+  Counters.CandidatePairs += NumPairs;
+
+  for (const FSensorBatch& Batch : Batches) {
+    SetTarget(Batch.SensorIndex, SelectTarget(Batch.SensorIndex, Batch.FirstPair, Batch.EndPair));
+  }
+  LastTickMicroseconds = FPlatformTime::ToMilliseconds64(FPlatformTime::Cycles64() - StartCycles) * 1000.0;
+}
+
+static bool HasLineOfSight(UWotVisibilitySubsystem* Visibility, AWotAICharacter* Sensor, APawn* Target)
+{
+  if (Visibility) {
+    return Visibility->HasLineOfSight(Sensor, Target);
+  }
+  AController* Controller = Sensor->GetController();
+  return Controller && Controller->LineOfSightTo(Target);
+}
+
+APawn* UWotPerceptionSubsystem::SelectTarget(int32 SensorIndex, int32 FirstPair, int32 EndPair)
+{
+  AWotAICharacter* Sensor = Sensors[SensorIndex];
+  APawn* CurrentTarget = Targets[SensorIndex].Get();
+  UWotVisibilitySubsystem* Visibility = UWotVisibilitySubsystem::GetIfEnabled(this);
+  TArray<TPair<float, APawn*>, TInlineAllocator<8>> Candidates;
+  for (int32 Pair = FirstPair; Pair < EndPair; Pair++) {
+    if (!PairInCone[Pair]) {
+      continue;
+    }
+    Counters.PairsInCone++;
+    APawn* Stimulus = Stimuli[PairStimuli[Pair]];
+    const UWotAttributeComponent* AttributeComp = UWotAttributeComponent::GetAttributes(Stimulus);
+    if (AttributeComp && !AttributeComp->IsAlive()) {
+      continue;
+    }
+    // keep the current target while it stays in sight
+    if (Stimulus == CurrentTarget && HasLineOfSight(Visibility, Sensor, Stimulus)) {
+      return Stimulus;
+    }
+    Candidates.Emplace(PairDistancesSquared[Pair], Stimulus);
+  }
+  // otherwise the closest one in sight, so traces stop at the first hit
+  Candidates.Sort([](const TPair<float, APawn*>& A, const TPair<float, APawn*>& B) { return A.Key < B.Key; });
+  for (const TPair<float, APawn*>& Candidate : Candidates) {
+    if (Candidate.Value != CurrentTarget && HasLineOfSight(Visibility, Sensor, Candidate.Value)) {
+      return Candidate.Value;
+    }
+  }
+  return nullptr;
+}
+
+void UWotPerceptionSubsystem::SetTarget(int32 SensorIndex, APawn* NewTarget)
+{
+  APawn* OldTarget = Targets[SensorIndex].Get();
+  if (OldTarget == NewTarget) {
+    // the bot's key may have been cleared or overwritten since
+    if (NewTarget) {
+      Sensors[SensorIndex]->OnSensedTargetKept(NewTarget);
+    }
+    return;
+  }
+  Targets[SensorIndex] = NewTarget;
+  if (NewTarget) {
+    Counters.TargetsGained++;
+  } else {
+    Counters.TargetsLost++;
+  }
+  Sensors[SensorIndex]->OnSensedTargetChanged(NewTarget, OldTarget);
+}
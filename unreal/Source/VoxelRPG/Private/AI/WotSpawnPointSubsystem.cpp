@@ -0,0 +1,306 @@
+#include "AI/WotSpawnPointSubsystem.h"
+#include "NavigationSystem.h"
+#include "Engine/LevelBounds.h"
+#include "Engine/World.h"
+#include "GameFramework/PlayerController.h"
+#include "GameFramework/Pawn.h"
+
+UWotSpawnPointSubsystem* UWotSpawnPointSubsystem::Get(const UObject* WorldContextObject)
+{
+  if (!WorldContextObject) {
+    return nullptr;
+  }
+  UWorld* World = WorldContextObject->GetWorld();
+  return World ? World->GetSubsystem<UWotSpawnPointSubsystem>() : nullptr;
+}
+
+TStatId UWotSpawnPointSubsystem::GetStatId() const
+{
+  RETURN_QUICK_DECLARE_CYCLE_STAT(UWotSpawnPointSubsystem, STATGROUP_Tickables);
+}
+
+void UWotSpawnPointSubsystem::BuildGrid(const FWotSpawnPointCacheSettings& InSettings)
+{
+  Settings = InSettings;
+  UWorld* World = GetWorld();
+  UNavigationSystemV1* NavSys = FNavigationSystem::GetCurrent<UNavigationSystemV1>(World);
+  if (!NavSys) {
+    UE_LOG(LogTemp, Warning, TEXT("SpawnPointCache: no navigation system, not building grid"));
+    return;
+  }
+  FBox Bounds = NavSys->GetNavigableWorldBounds();
+  if (!Bounds.IsValid) {
+    Bounds = ALevelBounds::CalculateLevelBounds(World->PersistentLevel);
+  }
+  if (!Bounds.IsValid) {
+    UE_LOG(LogTemp, Warning, TEXT("SpawnPointCache: level has no bounds, not building grid"));
+    return;
+  }
+
+  float CellSize = FMath::Max(Settings.CellSize, 50.0f);
+  const FVector Size = Bounds.GetSize();
+  const double Area = Size.X * Size.Y;
+  if (Area / (CellSize * CellSize) > Settings.MaxCells) {
+    CellSize = FMath::Sqrt(Area / Settings.MaxCells);
+  }
+  Settings.CellSize = CellSize;
+
+  GridOrigin = Bounds.Min;
+  GridZ = Bounds.GetCenter().Z;
+  GridHalfHeight = Size.Z * 0.5f;
+  NumCellsX = FMath::Max(1, FMath::CeilToInt(Size.X / CellSize));
+  NumCellsY = FMath::Max(1, FMath::CeilToInt(Size.Y / CellSize));
+  const int32 NumCells = NumCellsX * NumCellsY;
+
+  CellLocations.SetNumZeroed(NumCells);
+  CellFlags.SetNumZeroed(NumCells);
+  CellVisibilityTime.Init(-1.0f, NumCells);
+  CellQueued.Init(false, NumCells);
+  ProjectionQueue.Reset(NumCells);
+  CellsAwaitingNavRebuild.Reset();
+  VisibilityCursor = 0;
+  for (int32 i = NumCells - 1; i >= 0; i--) {
+    QueueProjection(i);
+  }
+
+  NavSys->OnNavigationGenerationFinishedDelegate.AddUniqueDynamic(this, &UWotSpawnPointSubsystem::OnNavigationGenerationFinished);
+
+  UE_LOG(LogTemp, Log, TEXT("SpawnPointCache: built %dx%d grid, cell size %.0f"), NumCellsX, NumCellsY, CellSize);
+}
+
+void UWotSpawnPointSubsystem::Deinitialize()
+{
+  if (UNavigationSystemV1* NavSys = FNavigationSystem::GetCurrent<UNavigationSystemV1>(GetWorld())) {
+    NavSys->OnNavigationGenerationFinishedDelegate.RemoveDynamic(this, &UWotSpawnPointSubsystem::OnNavigationGenerationFinished);
+  }
+  Super::Deinitialize();
+}
+
+void UWotSpawnPointSubsystem::InvalidateBounds(const FBox& Bounds)
+{
+  FIntPoint Min, Max;
+  if (!GetCellRange(Bounds.ExpandBy(Settings.CellSize * 0.5f), Min, Max)) {
+    return;
+  }
+  for (int32 Y = Min.Y; Y <= Max.Y; Y++) {
+    for (int32 X = Min.X; X <= Max.X; X++) {
+      const int32 CellIndex = Y * NumCellsX + X;
+      QueueProjection(CellIndex);
+      CellsAwaitingNavRebuild.Add(CellIndex);
+    }
+  }
+}
+
+void UWotSpawnPointSubsystem::OnNavigationGenerationFinished(ANavigationData* NavData)
+{
+  for (int32 CellIndex : CellsAwaitingNavRebuild) {
+    QueueProjection(CellIndex);
+  }
+  CellsAwaitingNavRebuild.Reset();
+}
+
+void UWotSpawnPointSubsystem::QueueProjection(int32 CellIndex)
+{
+  if (!CellQueued[CellIndex]) {
+    CellQueued[CellIndex] = true;
+    ProjectionQueue.Add(CellIndex);
+  }
+}
+
+void UWotSpawnPointSubsystem::ProjectCell(int32 CellIndex)
+{
+  UNavigationSystemV1* NavSys = FNavigationSystem::GetCurrent<UNavigationSystemV1>(GetWorld());
+  if (!NavSys) {
+    return;
+  }
+  const int32 X = CellIndex % NumCellsX;
+  const int32 Y = CellIndex / NumCellsX;
+  const float HalfCell = Settings.CellSize * 0.5f;
+  const FVector CellCenter = GridOrigin + FVector((X + 0.5f) * Settings.CellSize, (Y + 0.5f) * Settings.CellSize, 0);
+  FNavLocation NavLocation;
+  const bool bOnNavMesh = NavSys->ProjectPointToNavigation(FVector(CellCenter.X, CellCenter.Y, GridZ), NavLocation, FVector(HalfCell, HalfCell, GridHalfHeight));
+  CellFlags[CellIndex] = bOnNavMesh ? (CF_Projected | CF_OnNavMesh) : CF_Projected;
+  CellLocations[CellIndex] = bOnNavMesh ? NavLocation.Location : CellCenter;
+  // the location may have moved, so the visibility result is stale
+  CellVisibilityTime[CellIndex] = -1.0f;
+}
+
+void UWotSpawnPointSubsystem::Tick(float DeltaTime)
+{
+  Super::Tick(DeltaTime);
+
+  int32 NumProjected = 0;
+  while (ProjectionQueue.Num() > 0 && NumProjected < Settings.NavProjectionsPerFrame) {
+    const int32 CellIndex = ProjectionQueue.Pop(EAllowShrinking::No);
+    CellQueued[CellIndex] = false;
+    ProjectCell(CellIndex);
+    NumProjected++;
+  }
+
+  UpdatePlayerViews();
+  RefreshVisibility();
+}
+
+void UWotSpawnPointSubsystem::UpdatePlayerViews()
+{
+  PlayerViewLocations.Reset();
+  for (FConstPlayerControllerIterator It = GetWorld()->GetPlayerControllerIterator(); It; ++It) {
+    APlayerController* PC = It->Get();
+    if (PC && PC->GetPawn()) {
+      FVector ViewLocation;
+      FRotator ViewRotation;
+      PC->GetPlayerViewPoint(ViewLocation, ViewRotation);
+      PlayerViewLocations.Add(ViewLocation);
+    }
+  }
+}
+
+void UWotSpawnPointSubsystem::RefreshVisibility()
+{
+  if (PlayerViewLocations.Num() == 0) {
+    return;
+  }
+  FBox PlayerBounds(PlayerViewLocations);
+  FIntPoint Min, Max;
+  if (!GetCellRange(PlayerBounds.ExpandBy(Settings.MaxDistanceFromPlayers), Min, Max)) {
+    return;
+  }
+  const int32 RangeX = Max.X - Min.X + 1;
+  const int32 NumRangeCells = RangeX * (Max.Y - Min.Y + 1);
+  const float Now = GetWorld()->GetTimeSeconds();
+  const float MaxDistanceSq = FMath::Square(Settings.MaxDistanceFromPlayers);
+
+  FCollisionQueryParams Params(SCENE_QUERY_STAT(WotSpawnPointVisibility));
+  for (FConstPlayerControllerIterator It = GetWorld()->GetPlayerControllerIterator(); It; ++It) {
+    if (It->Get()) {
+      Params.AddIgnoredActor(It->Get()->GetPawn());
+    }
+  }
+
+  // walk the area around the players from where we stopped last frame,
+  // checking only cells whose result has expired
+  int32 NumChecked = 0;
+  for (int32 Step = 0; Step < NumRangeCells && NumChecked < Settings.VisibilityChecksPerFrame; Step++) {
+    VisibilityCursor = (VisibilityCursor + 1) % NumRangeCells;
+    const int32 CellIndex = (Min.Y + VisibilityCursor / RangeX) * NumCellsX + (Min.X + VisibilityCursor % RangeX);
+    if (!(CellFlags[CellIndex] & CF_OnNavMesh)) {
+      continue;
+    }
+    if (CellVisibilityTime[CellIndex] >= 0.0f && Now - CellVisibilityTime[CellIndex] < Settings.VisibilityTTL) {
+      continue;
+    }
+    const FVector Target = CellLocations[CellIndex] + FVector(0, 0, Settings.EyeHeight);
+    if (DistanceSqToNearestPlayer(Target) > MaxDistanceSq) {
+      continue;
+    }
+    bool bHidden = true;
+    for (const FVector& ViewLocation : PlayerViewLocations) {
+      if (!GetWorld()->LineTraceTestByChannel(ViewLocation, Target, ECC_Visibility, Params)) {
+        bHidden = false;
+        break;
+      }
+    }
+    if (bHidden) {
+      CellFlags[CellIndex] |= CF_Hidden;
+    } else {
+      CellFlags[CellIndex] &= ~CF_Hidden;
+    }
+    CellVisibilityTime[CellIndex] = Now;
+    NumChecked++;
+  }
+}
+
+int32 UWotSpawnPointSubsystem::GetSpawnCandidates(int32 MaxCount, TArray<FVector>& OutLocations)
+{
+  if (!IsGridBuilt() || MaxCount <= 0) {
+    return 0;
+  }
+  if (PlayerViewLocations.Num() == 0) {
+    UpdatePlayerViews();
+  }
+  if (PlayerViewLocations.Num() == 0) {
+    return 0;
+  }
+  FIntPoint Min, Max;
+  if (!GetCellRange(FBox(PlayerViewLocations).ExpandBy(Settings.MaxDistanceFromPlayers), Min, Max)) {
+    return 0;
+  }
+  const float Now = GetWorld()->GetTimeSeconds();
+  const float MinDistanceSq = FMath::Square(Settings.MinDistanceFromPlayers);
+  const float MaxDistanceSq = FMath::Square(Settings.MaxDistanceFromPlayers);
+  const uint8 RequiredFlags = CF_OnNavMesh | CF_Hidden;
+
+  const int32 FirstNew = OutLocations.Num();
+  int32 NumSeen = 0;
+  for (int32 Y = Min.Y; Y <= Max.Y; Y++) {
+    for (int32 X = Min.X; X <= Max.X; X++) {
+      const int32 CellIndex = Y * NumCellsX + X;
+      if ((CellFlags[CellIndex] & RequiredFlags) != RequiredFlags) {
+        continue;
+      }
+      if (Now - CellVisibilityTime[CellIndex] > Settings.VisibilityTTL) {
+        continue;
+      }
+      const float DistanceSq = DistanceSqToNearestPlayer(CellLocations[CellIndex]);
+      if (DistanceSq < MinDistanceSq || DistanceSq > MaxDistanceSq) {
+        continue;
+      }
+      // reservoir sample so every valid cell is equally likely
+      NumSeen++;
+      if (OutLocations.Num() - FirstNew < MaxCount) {
+        OutLocations.Add(CellLocations[CellIndex]);
+      } else {
+        const int32 Slot = FMath::RandRange(0, NumSeen - 1);
+        if (Slot < MaxCount) {
+          OutLocations[FirstNew + Slot] = CellLocations[CellIndex];
+        }
+      }
+    }
+  }
+  return OutLocations.Num() - FirstNew;
+}
+
+void UWotSpawnPointSubsystem::GetCachedLocations(const FVector& Origin, float Radius, bool bOnlyHidden, TArray<FVector>& OutLocations) const
+{
+  FIntPoint Min, Max;
+  if (!GetCellRange(FBox(Origin, Origin).ExpandBy(Radius), Min, Max)) {
+    return;
+  }
+  const float Now = GetWorld()->GetTimeSeconds();
+  const float RadiusSq = Radius * Radius;
+  for (int32 Y = Min.Y; Y <= Max.Y; Y++) {
+    for (int32 X = Min.X; X <= Max.X; X++) {
+      const int32 CellIndex = Y * NumCellsX + X;
+      if (!(CellFlags[CellIndex] & CF_OnNavMesh)) {
+        continue;
+      }
+      if (bOnlyHidden && (!(CellFlags[CellIndex] & CF_Hidden) || Now - CellVisibilityTime[CellIndex] > Settings.VisibilityTTL)) {
+        continue;
+      }
+      if (FVector::DistSquared2D(CellLocations[CellIndex], Origin) <= RadiusSq) {
+        OutLocations.Add(CellLocations[CellIndex]);
+      }
+    }
+  }
+}
+
+bool UWotSpawnPointSubsystem::GetCellRange(const FBox& Bounds, FIntPoint& OutMin, FIntPoint& OutMax) const
+{
+  if (!IsGridBuilt()) {
+    return false;
+  }
+  OutMin.X = FMath::Clamp(FMath::FloorToInt((Bounds.Min.X - GridOrigin.X) / Settings.CellSize), 0, NumCellsX - 1);
+  OutMin.Y = FMath::Clamp(FMath::FloorToInt((Bounds.Min.Y - GridOrigin.Y) / Settings.CellSize), 0, NumCellsY - 1);
+  OutMax.X = FMath::Clamp(FMath::FloorToInt((Bounds.Max.X - GridOrigin.X) / Settings.CellSize), 0, NumCellsX - 1);
+  OutMax.Y = FMath::Clamp(FMath::FloorToInt((Bounds.Max.Y - GridOrigin.Y) / Settings.CellSize), 0, NumCellsY - 1);
+  return true;
+}
+
+float UWotSpawnPointSubsystem::DistanceSqToNearestPlayer(const FVector& Location) const
+{
+  float MinDistanceSq = TNumericLimits<float>::Max();
+  for (const FVector& ViewLocation : PlayerViewLocations) {
+    MinDistanceSq = FMath::Min(MinDistanceSq, (float)FVector::DistSquared(ViewLocation, Location));
+  }
+  return MinDistanceSq;
+}
@@ -0,0 +1,149 @@
+#include "AI/WotVisibilitySubsystem.h"
+#include "WotTraceSubsystem.h"
+#include "Engine/World.h"
+#include "GameFramework/Actor.h"
+
+static TAutoConsoleVariable<bool> CVarVisibilityUseCache(TEXT("wot.Visibility.UseCache"), true, TEXT("Answer AI line of sight checks from the shared visibility cache instead of tracing on every check"), ECVF_Cheat);
+static TAutoConsoleVariable<float> CVarVisibilityTTL(TEXT("wot.Visibility.TTL"), 0.25f, TEXT("Seconds a cached line of sight result is used before it is traced again"), ECVF_Cheat);
+static TAutoConsoleVariable<int32> CVarVisibilityMaxTracesPerFrame(TEXT("wot.Visibility.MaxTracesPerFrame"), 32, TEXT("Maximum number of line of sight traces issued per frame, the rest wait for the next frame (0 = no limit)"), ECVF_Cheat);
+
+// pairs not queried for this long are dropped from the cache
+static constexpr double UnusedEntryLifetime = 2.0;
+
+static FAutoConsoleCommandWithWorld VisibilityStatsCommand(
+  TEXT("wot.Visibility.Stats"),
+  TEXT("Logs the visibility cache counters"),
+  FConsoleCommandWithWorldDelegate::CreateLambda([](UWorld* World) {
+    UWotVisibilitySubsystem* Visibility = UWotVisibilitySubsystem::Get(World);
+    if (!Visibility) {
+      return;
+    }
+    const FWotVisibilityCounters Counters = Visibility->GetCounters();
+    UE_LOG(LogTemp, Log, TEXT("Visibility: %d pairs cached, %d queued, queries %d (fresh %d, stale %d, misses %d), traces %d, peak queued %d"),
+           Visibility->GetNumCached(), Visibility->GetNumQueued(), Counters.Queries, Counters.FreshHits, Counters.StaleHits,
+           Counters.Misses, Counters.TracesIssued, Counters.PeakQueued);
+  }));
+
+UWotVisibilitySubsystem* UWotVisibilitySubsystem::Get(const UObject* WorldContextObject)
+{
+  if (!WorldContextObject) {
+    return nullptr;
+  }
+  UWorld* World = WorldContextObject->GetWorld();
+  return World ? World->GetSubsystem<UWotVisibilitySubsystem>() : nullptr;
+}
+
+UWotVisibilitySubsystem* UWotVisibilitySubsystem::GetIfEnabled(const UObject* WorldContextObject)
+{
+  return CVarVisibilityUseCache.GetValueOnGameThread() ? Get(WorldContextObject) : nullptr;
+}
+
+bool UWotVisibilitySubsystem::HasLineOfSight(const AActor* Observer, const AActor* Target)
+{
+  if (!Observer || !Target) {
+    return false;
+  }
+  const double Now = GetWorld()->GetTimeSeconds();
+  Counters.Queries++;
+  const FVisibilityKey Key(TObjectKey<AActor>(Observer), TObjectKey<AActor>(Target));
+  FVisibilityEntry* Entry = Entries.Find(Key);
+  if (!Entry) {
+    Entry = &Entries.Add(Key);
+    Entry->Observer = Observer;
+    Entry->Target = Target;
+  }
+  Entry->LastQueryTime = Now;
+  if (Entry->TraceTime < 0.0) {
+    Counters.Misses++;
+  } else if (Now - Entry->TraceTime < CVarVisibilityTTL.GetValueOnGameThread()) {
+    Counters.FreshHits++;
+    return Entry->bVisible;
+  } else {
+    Counters.StaleHits++;
+  }
+  if (!Entry->bQueued) {
+    Entry->bQueued = true;
+    Queue.Add(Key);
+    Counters.PeakQueued = FMath::Max(Counters.PeakQueued, Queue.Num());
+  }
+  return Entry->bVisible;
+}
+
+void UWotVisibilitySubsystem::ResetCounters()
+{
+  Counters = FWotVisibilityCounters();
+}
+
+void UWotVisibilitySubsystem::Deinitialize()
+{
+  Entries.Empty();
+  Queue.Empty();
+  Super::Deinitialize();
+}
+
+TStatId UWotVisibilitySubsystem::GetStatId() const
+{
+  RETURN_QUICK_DECLARE_CYCLE_STAT(UWotVisibilitySubsystem, STATGROUP_Tickables);
+}
+
+void UWotVisibilitySubsystem::Tick(float DeltaTime)
+{
+  IssueTraces();
+  const double Now = GetWorld()->GetTimeSeconds();
+  if (Now >= NextEvictTime) {
+    EvictUnused(Now);
+    NextEvictTime = Now + 1.0;
+  }
+}
+
+void UWotVisibilitySubsystem::IssueTraces()
+{
+  const int32 MaxTraces = CVarVisibilityMaxTracesPerFrame.GetValueOnGameThread();
+  int32 NumTraces = 0;
+  int32 NumTaken = 0;
+  while (NumTaken < Queue.Num() && (MaxTraces <= 0 || NumTraces < MaxTraces)) {
+    const FVisibilityKey Key = Queue[NumTaken++];
+    FVisibilityEntry* Entry = Entries.Find(Key);
+    if (!Entry) {
+      continue;
+    }
+    const AActor* Observer = Entry->Observer.Get();
+    const AActor* Target = Entry->Target.Get();
+    if (!Observer || !Target) {
+      Entries.Remove(Key);
+      continue;
+    }
+    FVector EyesLocation;
+    FRotator EyesRotation;
+    Observer->GetActorEyesViewPoint(EyesLocation, EyesRotation);
+    FCollisionQueryParams Params(SCENE_QUERY_STAT(WotVisibility), true, Observer);
+    Params.AddIgnoredActor(Target);
+    UWotTraceSubsystem::LineTraceTestByChannel(this, EyesLocation, Target->GetActorLocation(), ECC_Visibility, Params,
+      FWotTraceResultDelegate::CreateUObject(this, &UWotVisibilitySubsystem::OnTraceDone, Key));
+    NumTraces++;
+    Counters.TracesIssued++;
+  }
+  Queue.RemoveAt(0, NumTaken, EAllowShrinking::No);
+}
+
+void UWotVisibilitySubsystem::OnTraceDone(const TArray<FHitResult>& Hits, FVisibilityKey Key)
+{
+  FVisibilityEntry* Entry = Entries.Find(Key);
+  if (!Entry) {
+    return;
+  }
+  Entry->bVisible = !Hits.ContainsByPredicate([](const FHitResult& Hit) { return Hit.bBlockingHit; });
+  Entry->TraceTime = GetWorld()->GetTimeSeconds();
+  Entry->bQueued = false;
+}
+
+void UWotVisibilitySubsystem::EvictUnused(double Now)
+{
+  for (auto It = Entries.CreateIterator(); It; ++It) {
+    const FVisibilityEntry& Entry = It.Value();
+    if (Now - Entry.LastQueryTime > UnusedEntryLifetime || !Entry.Observer.IsValid() || !Entry.Target.IsValid()) {
+      // a queued key without an entry is skipped by IssueTraces
+      It.RemoveCurrent();
+    }
+  }
+}
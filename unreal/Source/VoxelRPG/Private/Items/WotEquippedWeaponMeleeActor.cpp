@@ -6,6 +6,9 @@
 #include "GameFramework/Character.h"
 #include "Engine/EngineTypes.h"
 #include "Components/AudioComponent.h"
+#include "WotSoundSubsystem.h"
+#include "WotTraceSubsystem.h"
+#include "Wildlife/WotWildlifeSubsystem.h"
 
 // For Debug:
 #include "DrawDebugHelpers.h"
@@ -61,19 +64,32 @@ void AWotEquippedWeaponMeleeActor::AttackSweep()
 
 	FVector End = OwnerLocation + (ForwardVector * AttackRange);
 
-	TArray<FHitResult> Hits;
-
 	FCollisionShape Shape;
-	Chaos::TVector<float, 3> HalfExtent = HitBoxHalfExtent;
-    FVector Extent = FVector(HalfExtent.X, HalfExtent.Y, HalfExtent.Z);
-	Shape.SetBox(HalfExtent);
+	Shape.SetBox(FVector3f(HitBoxHalfExtent));
+
+	UWotTraceSubsystem::SweepMultiByObjectType(this,
+                                             OwnerLocation,
+                                             End,
+                                             OwnerRotation.Quaternion(),
+                                             ObjectQueryParams,
+                                             Shape,
+                                             FCollisionQueryParams(SCENE_QUERY_STAT(WotMeleeSweep)),
+                                             FWotTraceResultDelegate::CreateUObject(this,
+                                                                                    &AWotEquippedWeaponMeleeActor::OnAttackSweepDone,
+                                                                                    OwnerLocation,
+                                                                                    End,
+                                                                                    OwnerRotation.Quaternion()));
+}
 
-	bool bBlockingHit = GetWorld()->SweepMultiByObjectType(Hits,
-                                                         OwnerLocation,
-                                                         End,
-                                                         OwnerRotation.Quaternion(),
-                                                         ObjectQueryParams,
-                                                         Shape);
+void AWotEquippedWeaponMeleeActor::OnAttackSweepDone(const TArray<FHitResult>& Hits, FVector OwnerLocation, FVector End, FQuat OwnerRotation)
+{
+	AActor* MyOwner = GetAttachParentActor();
+  if (!MyOwner) {
+    UE_LOG(LogTemp, Warning, TEXT("Not a valid owning actor!"));
+    return;
+  }
+  bool bBlockingHit = Hits.ContainsByPredicate([](const FHitResult& Hit) { return Hit.bBlockingHit; });
+  FVector ForwardVector = OwnerRotation.GetForwardVector();
 
 	bool bDrawDebug = CVarDebugDrawHitBox.GetValueOnGameThread();
 
@@ -87,8 +103,9 @@ void AWotEquippedWeaponMeleeActor::AttackSweep()
 
   bool bDidDamage = false;
 
-	for (auto Hit : Hits) {
-		AActor* HitActor = Hit.GetActor();
+	for (const FHitResult& Hit : Hits) {
+		// hitting a wildlife animal hits the character it is promoted to
+		AActor* HitActor = UWotWildlifeSubsystem::ResolveHitActor(Hit.GetActor(), Hit);
 		if (HitActor && HitActor != MyOwner) {
       // if the actor is damage-able, then damage them
       UWotAttributeComponent* AttributeComp = UWotAttributeComponent::GetAttributes(HitActor);
@@ -109,8 +126,7 @@ void AWotEquippedWeaponMeleeActor::AttackSweep()
 
   // if we damaged somebody, play the sound already!
   if (bDidDamage) {
-    EffectAudioComp->SetSound(HitSound);
-    EffectAudioComp->Play(0);
+    UWotSoundSubsystem::PlaySoundAttached(HitSound, EffectAudioComp, EWotSoundCategory::Weapon);
   }
 
 	if (bDrawDebug) {
@@ -118,11 +134,11 @@ void AWotEquippedWeaponMeleeActor::AttackSweep()
     // Draw a line for the vector from the owner to the end of the sweep
 		DrawDebugLine(GetWorld(), OwnerLocation, End, LineColor, false, 5.0f, 0, 10.0f);
     // Draw the box representing how we swept
-    FVector SweepExtent(AttackRange / 2, HalfExtent.Y, HalfExtent.Z);
+    FVector SweepExtent(AttackRange / 2, HitBoxHalfExtent.Y, HitBoxHalfExtent.Z);
     DrawDebugBox(GetWorld(),
                  OwnerLocation + (ForwardVector * AttackRange) / 2,
                  SweepExtent,
-                 OwnerRotation.Quaternion(),
+                 OwnerRotation,
                  LineColor, false, 2.0f, 0, 2.0f);
 	}
 }
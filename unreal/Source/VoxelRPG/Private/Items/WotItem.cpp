@@ -3,6 +3,7 @@
 #include "WotEquipmentComponent.h"
 #include "GameFramework/Character.h"
 #include "Items/WotItemInteractableActor.h"
+#include "WotActorPoolSubsystem.h"
 
 UWotItem::UWotItem()
 {
@@ -108,21 +109,22 @@ void UWotItem::Drop(FVector Location, int DropCount)
     }
   }
 
-  // spawn it into the world as a WotItemInteractableActor
+  DropCount = FMath::Min(DropCount, Count);
+  // spawn it into the world as a single WotItemInteractableActor carrying the
+  // whole stack
   FActorSpawnParameters SpawnParams;
   SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
-  // Spawn one actor for each item dropped
-  for (int i=0; i < DropCount; ++i) {
-    AWotItemInteractableActor* InteractableItem =
-      GetWorld()->SpawnActor<AWotItemInteractableActor>(AWotItemInteractableActor::StaticClass(),
-                                                        Location,
-                                                        FRotator::ZeroRotator,
-                                                        SpawnParams);
+  AWotItemInteractableActor* InteractableItem =
+    UWotActorPoolSubsystem::SpawnPooled<AWotItemInteractableActor>(GetWorld(),
+                                                                   AWotItemInteractableActor::StaticClass(),
+                                                                   FTransform(Location),
+                                                                   SpawnParams);
+  if (InteractableItem) {
     // create an Item for this
     UWotItem* DroppedItem = DuplicateObject(this, InteractableItem);
     // Set the properties of the dropped item accordingly
     DroppedItem->OwningInventory = nullptr;
-    DroppedItem->Count = 1;
+    DroppedItem->Count = DropCount;
     InteractableItem->SetItem(DroppedItem);
     InteractableItem->SetPhysicsAndCollision("Item", true, true);
   }
@@ -1,5 +1,6 @@
 // Fill out your copyright notice in the Description page of Project Settings.
 #include "Items/WotItemActor.h"
+#include "WotInteractableGridSubsystem.h"
 #include "Components/StaticMeshComponent.h"
 #include "Items/WotItem.h"
 
@@ -19,9 +20,27 @@ void AWotItemActor::SetItem(UWotItem* NewItem) {
   // Set the item mesh
   if (Item->PickupMesh) {
     Mesh->SetStaticMesh(Item->PickupMesh);
+    // the interactable grid measured the previous mesh
+    if (UWotInteractableGridSubsystem* Grid = UWotInteractableGridSubsystem::Get(this)) {
+      Grid->RefreshBounds(this);
+    }
   }
 }
 
+void AWotItemActor::OnAcquiredFromPool_Implementation()
+{
+  // callers set the item and physics / collision after acquiring
+}
+
+void AWotItemActor::OnReleasedToPool_Implementation()
+{
+  Item = nullptr;
+  Mesh->SetSimulatePhysics(false);
+  // e.g. equipped items detached from a killed bot were switched to "Item"
+  Mesh->SetCollisionProfileName(GetClass()->GetDefaultObject<AWotItemActor>()->Mesh->GetCollisionProfileName());
+  Mesh->SetRenderCustomDepth(false);
+}
+
 void AWotItemActor::SetPhysicsAndCollision(FName CollisionProfileName, bool EnablePhysics, bool EnableCollision)
 {
   Mesh->SetCollisionProfileName(CollisionProfileName);
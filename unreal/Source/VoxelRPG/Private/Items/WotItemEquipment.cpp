@@ -2,6 +2,7 @@
 #include "Items/WotItemActor.h"
 #include "GameFramework/Character.h"
 #include "WotEquipmentComponent.h"
+#include "WotActorPoolSubsystem.h"
 
 UWotItemEquipment::UWotItemEquipment() : UWotItem()
 {
@@ -81,10 +82,10 @@ void UWotItemEquipment::Equip(ACharacter* Character)
   FActorSpawnParameters SpawnParams;
   SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
   // we don't care about location / rotation because AttachTo will attach accordingly
-  ItemActor = GetWorld()->SpawnActor<AWotItemActor>(ItemActorClass,
-                                                    FVector(),
-                                                    FRotator::ZeroRotator,
-                                                    SpawnParams);
+  ItemActor = UWotActorPoolSubsystem::SpawnPooled<AWotItemActor>(GetWorld(),
+                                                                 ItemActorClass,
+                                                                 FTransform::Identity,
+                                                                 SpawnParams);
   ItemActor->SetItem(this);
   // Set attachment point of owner
   FAttachmentTransformRules AttachmentRules(EAttachmentRule::SnapToTarget,
@@ -106,7 +107,7 @@ void UWotItemEquipment::Unequip(ACharacter* Character)
   IsEquipped = false;
   // Delete the ItemActor
   if (ItemActor) {
-    ItemActor->Destroy();
+    UWotActorPoolSubsystem::ReleasePooled(ItemActor);
   }
   ItemActor = nullptr;
 }
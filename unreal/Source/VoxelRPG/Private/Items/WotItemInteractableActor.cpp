@@ -4,10 +4,52 @@
 #include "Items/WotItem.h"
 #include "WotInventoryComponent.h"
 #include "WotCharacter.h"
+#include "WotActorPoolSubsystem.h"
+#include "Components/InstancedStaticMeshComponent.h"
 
 // Sets default values
 AWotItemInteractableActor::AWotItemInteractableActor() : AWotItemActor()
 {
+  ScatterMesh = CreateDefaultSubobject<UInstancedStaticMeshComponent>(TEXT("ScatterMesh"));
+  ScatterMesh->SetupAttachment(Mesh);
+  ScatterMesh->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+  ScatterMesh->SetCanEverAffectNavigation(false);
+}
+
+void AWotItemInteractableActor::SetItem(UWotItem* NewItem)
+{
+  Super::SetItem(NewItem);
+  UpdateScatter();
+}
+
+void AWotItemInteractableActor::OnReleasedToPool_Implementation()
+{
+  Super::OnReleasedToPool_Implementation();
+  ScatterMesh->ClearInstances();
+}
+
+void AWotItemInteractableActor::UpdateScatter()
+{
+  const int32 NumScatter = Item ? FMath::Clamp(Item->Count - 1, 0, MaxScatterInstances) : 0;
+  if (NumScatter == ScatterMesh->GetInstanceCount()) {
+    return;
+  }
+  ScatterMesh->ClearInstances();
+  if (NumScatter == 0) {
+    return;
+  }
+  ScatterMesh->SetStaticMesh(Mesh->GetStaticMesh());
+  // seeded so the same stack always scatters the same way
+  FRandomStream Random(GetUniqueID());
+  TArray<FTransform> Transforms;
+  for (int32 i = 0; i < NumScatter; i++) {
+    const float Angle = Random.FRandRange(0.0f, 2.0f * PI);
+    const float Distance = Random.FRandRange(0.25f, 1.0f) * ScatterRadius;
+    const FVector Offset(FMath::Cos(Angle) * Distance, FMath::Sin(Angle) * Distance, 0.0f);
+    const FRotator Rotation(0.0f, Random.FRandRange(0.0f, 360.0f), 0.0f);
+    Transforms.Add(FTransform(Rotation, Offset));
+  }
+  ScatterMesh->AddInstances(Transforms, false);
 }
 
 void AWotItemInteractableActor::Interact_Implementation(APawn* InstigatorPawn, FHitResult Hit)
@@ -30,14 +72,20 @@ void AWotItemInteractableActor::Interact_Implementation(APawn* InstigatorPawn, F
     if (NumAdded == TotalCount) {
       UE_LOG(LogTemp, Log, TEXT("InteractableActor: We've added all our items, destroying!"));
       // destroy this object
-      Destroy();
+      UWotActorPoolSubsystem::ReleasePooled(this);
+    } else {
+      // only part of the stack fit, the rest stays here
+      UpdateScatter();
     }
   }
 }
 
 void AWotItemInteractableActor::GetInteractionText_Implementation(APawn* InstigatorPawn, FHitResult Hit, FText& OutText)
 {
-  if (Item) {
+  if (Item && Item->Count > 1) {
+    OutText = FText::Format(NSLOCTEXT("WotItemInteractableActor", "PickupCountFormat", "Pick up {0} {1}"), Item->Count, Item->ItemDisplayName);
+  }
+  else if (Item) {
     OutText = FText::Format(NSLOCTEXT("WotItemInteractableActor", "PickupFormat", "Pick up {0}"), Item->ItemDisplayName);
   }
   else {
@@ -50,7 +98,7 @@ void AWotItemInteractableActor::Highlight_Implementation(FHitResult Hit, int Hig
   SetHighlightEnabled(HighlightValue, true);
   // if duration is > 0, start a timer to unhighlight the object
   if (Duration > 0) {
-    GetWorldTimerManager().SetTimer(HighlightTimerHandle, this, &AWotItemInteractableActor::OnHighlightTimerExpired, Duration, false);
+    UWotTimingWheelSubsystem::SetTimer(this, HighlightTimerHandle, &AWotItemInteractableActor::OnHighlightTimerExpired, Duration);
   }
 }
 
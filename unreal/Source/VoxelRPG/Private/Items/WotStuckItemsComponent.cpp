@@ -0,0 +1,244 @@
+#include "Items/WotStuckItemsComponent.h"
+#include "Items/WotItem.h"
+#include "Items/WotItemInteractableActor.h"
+#include "AI/WotAICharacter.h"
+#include "Components/InstancedStaticMeshComponent.h"
+#include "WotActorPoolSubsystem.h"
+#include "WotAttributeComponent.h"
+#include "WotCharacter.h"
+#include "WotInventoryComponent.h"
+#include "WotInteractableGridSubsystem.h"
+#include "TimerManager.h"
+
+static TAutoConsoleVariable<bool> CVarStuckItemInstances(TEXT("wot.StuckItems.UseInstances"), true, TEXT("Draw items stuck in actors as mesh instances instead of spawning an item actor for each"), ECVF_Cheat);
+
+bool UWotStuckItemsComponent::AddStuckItem(AActor* Target, UPrimitiveComponent* HitComponent, FName BoneName, TSubclassOf<UWotItem> ItemClass, const FTransform& WorldTransform)
+{
+  if (!CVarStuckItemInstances.GetValueOnGameThread() || !Target || !ItemClass) {
+    return false;
+  }
+  if (!ItemClass->GetDefaultObject<UWotItem>()->PickupMesh) {
+    return false;
+  }
+  // only bots hand interaction on to their stuck items, anything else gets
+  // an item actor so the player can still pick it up
+  if (!Cast<AWotAICharacter>(Target)) {
+    return false;
+  }
+  if (!HitComponent || HitComponent->GetOwner() != Target) {
+    HitComponent = Cast<UPrimitiveComponent>(Target->GetRootComponent());
+  }
+  if (!HitComponent) {
+    return false;
+  }
+  UWotStuckItemsComponent* StuckItems = Target->FindComponentByClass<UWotStuckItemsComponent>();
+  if (!StuckItems) {
+    StuckItems = NewObject<UWotStuckItemsComponent>(Target);
+    Target->AddInstanceComponent(StuckItems);
+    StuckItems->RegisterComponent();
+  }
+  FWotStuckItemGroup& Group = StuckItems->FindOrAddGroup(HitComponent, BoneName, ItemClass);
+  Group.Instances->AddInstance(WorldTransform, true);
+  return true;
+}
+
+FWotStuckItemGroup& UWotStuckItemsComponent::FindOrAddGroup(UPrimitiveComponent* AttachComponent, FName BoneName, TSubclassOf<UWotItem> ItemClass)
+{
+  for (FWotStuckItemGroup& Group : Groups) {
+    if (Group.ItemClass == ItemClass && Group.AttachComponent == AttachComponent && Group.BoneName == BoneName) {
+      return Group;
+    }
+  }
+  FWotStuckItemGroup& Group = Groups.AddDefaulted_GetRef();
+  Group.ItemClass = ItemClass;
+  Group.AttachComponent = AttachComponent;
+  Group.BoneName = BoneName;
+  Group.Instances = NewObject<UInstancedStaticMeshComponent>(GetOwner());
+  Group.Instances->SetStaticMesh(ItemClass->GetDefaultObject<UWotItem>()->PickupMesh);
+  Group.Instances->SetMobility(EComponentMobility::Movable);
+  // the instances are only visuals, interaction goes through the owner
+  Group.Instances->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+  Group.Instances->SetCanEverAffectNavigation(false);
+  Group.Instances->SetupAttachment(AttachComponent, BoneName);
+  Group.Instances->RegisterComponent();
+  return Group;
+}
+
+int32 UWotStuckItemsComponent::GetNumStuckItems() const
+{
+  int32 Num = 0;
+  for (const FWotStuckItemGroup& Group : Groups) {
+    Num += Group.Instances ? Group.Instances->GetInstanceCount() : 0;
+  }
+  return Num;
+}
+
+int32 UWotStuckItemsComponent::GetNumStuckItemsOfClass(TSubclassOf<UWotItem> ItemClass) const
+{
+  int32 Num = 0;
+  for (const FWotStuckItemGroup& Group : Groups) {
+    if (Group.ItemClass == ItemClass && Group.Instances) {
+      Num += Group.Instances->GetInstanceCount();
+    }
+  }
+  return Num;
+}
+
+void UWotStuckItemsComponent::GetItemClasses(TArray<TSubclassOf<UWotItem>>& OutItemClasses) const
+{
+  for (const FWotStuckItemGroup& Group : Groups) {
+    OutItemClasses.AddUnique(Group.ItemClass);
+  }
+}
+
+int32 UWotStuckItemsComponent::RemoveItems(TSubclassOf<UWotItem> ItemClass, int32 Count)
+{
+  int32 NumRemoved = 0;
+  for (int32 i = Groups.Num() - 1; i >= 0 && NumRemoved < Count; i--) {
+    FWotStuckItemGroup& Group = Groups[i];
+    if (Group.ItemClass != ItemClass || !Group.Instances) {
+      continue;
+    }
+    // remove from the end so the remaining instance indices don't change
+    while (NumRemoved < Count && Group.Instances->GetInstanceCount() > 0) {
+      Group.Instances->RemoveInstance(Group.Instances->GetInstanceCount() - 1);
+      NumRemoved++;
+    }
+    if (Group.Instances->GetInstanceCount() == 0) {
+      Group.Instances->DestroyComponent();
+      Groups.RemoveAtSwap(i);
+    }
+  }
+  return NumRemoved;
+}
+
+void UWotStuckItemsComponent::DropAll()
+{
+  AActor* Owner = GetOwner();
+  TArray<TSubclassOf<UWotItem>> ItemClasses;
+  GetItemClasses(ItemClasses);
+  FActorSpawnParameters SpawnParams;
+  SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+  for (const auto& ItemClass : ItemClasses) {
+    const int32 Count = RemoveItems(ItemClass, GetNumStuckItemsOfClass(ItemClass));
+    if (Count == 0) {
+      continue;
+    }
+    AWotItemInteractableActor* InteractableItem =
+      UWotActorPoolSubsystem::SpawnPooled<AWotItemInteractableActor>(Owner,
+                                                                     AWotItemInteractableActor::StaticClass(),
+                                                                     FTransform(Owner->GetActorLocation()),
+                                                                     SpawnParams);
+    if (!InteractableItem) {
+      continue;
+    }
+    UWotItem* DroppedItem = NewObject<UWotItem>(InteractableItem, ItemClass);
+    DroppedItem->OwningInventory = nullptr;
+    DroppedItem->Count = Count;
+    DroppedItem->World = GetWorld();
+    InteractableItem->SetItem(DroppedItem);
+    InteractableItem->SetPhysicsAndCollision("Item", true, true);
+  }
+}
+
+void UWotStuckItemsComponent::Interact_Implementation(APawn* InstigatorPawn, FHitResult Hit)
+{
+  UWotInventoryComponent* InventoryComp = UWotInventoryComponent::GetInventory(InstigatorPawn);
+  if (!InventoryComp) {
+    return;
+  }
+  TArray<TSubclassOf<UWotItem>> ItemClasses;
+  GetItemClasses(ItemClasses);
+  int32 TotalAdded = 0;
+  for (const auto& ItemClass : ItemClasses) {
+    UWotItem* NewItem = NewObject<UWotItem>(GetOwner(), ItemClass);
+    NewItem->OwningInventory = nullptr;
+    NewItem->Count = GetNumStuckItemsOfClass(ItemClass);
+    NewItem->World = GetWorld();
+    const int32 NumAdded = InventoryComp->AddItem(NewItem);
+    RemoveItems(ItemClass, NumAdded);
+    TotalAdded += NumAdded;
+  }
+  if (TotalAdded == 0) {
+    return;
+  }
+  AWotCharacter* WotCharacter = Cast<AWotCharacter>(InstigatorPawn);
+  if (WotCharacter) {
+    WotCharacter->ShowPopupWidgetNumber(TotalAdded, 1.0f);
+    WotCharacter->PlaySoundGet();
+  }
+}
+
+void UWotStuckItemsComponent::GetInteractionText_Implementation(APawn* InstigatorPawn, FHitResult Hit, FText& OutText)
+{
+  TArray<TSubclassOf<UWotItem>> ItemClasses;
+  GetItemClasses(ItemClasses);
+  if (ItemClasses.Num() == 1) {
+    OutText = FText::Format(NSLOCTEXT("WotStuckItemsComponent", "PickupCountFormat", "Pick up {0} {1}"),
+                            GetNumStuckItems(),
+                            ItemClasses[0]->GetDefaultObject<UWotItem>()->ItemDisplayName);
+  } else {
+    OutText = FText::Format(NSLOCTEXT("WotStuckItemsComponent", "PickupItemsFormat", "Pick up {0} items"), GetNumStuckItems());
+  }
+}
+
+void UWotStuckItemsComponent::Highlight_Implementation(FHitResult Hit, int HighlightValue, float Duration)
+{
+  SetHighlightEnabled(HighlightValue, true);
+  // if duration is > 0, start a timer to unhighlight the items
+  if (Duration > 0) {
+    UWotTimingWheelSubsystem::SetTimer(this, HighlightTimerHandle, &UWotStuckItemsComponent::OnHighlightTimerExpired, Duration);
+  }
+}
+
+void UWotStuckItemsComponent::Unhighlight_Implementation(FHitResult Hit)
+{
+  SetHighlightEnabled(0, false);
+}
+
+void UWotStuckItemsComponent::OnHighlightTimerExpired()
+{
+  // dummy hit
+  FHitResult Hit;
+  IWotGameplayInterface::Execute_Unhighlight(this, Hit);
+}
+
+void UWotStuckItemsComponent::SetHighlightEnabled(int HighlightValue, bool Enabled)
+{
+  for (const FWotStuckItemGroup& Group : Groups) {
+    if (Group.Instances) {
+      Group.Instances->SetRenderCustomDepth(Enabled);
+      Group.Instances->SetCustomDepthStencilValue(HighlightValue);
+    }
+  }
+}
+
+void UWotStuckItemsComponent::BeginPlay()
+{
+  Super::BeginPlay();
+  if (UWotAttributeComponent* AttributeComp = UWotAttributeComponent::GetAttributes(GetOwner())) {
+    AttributeComp->OnKilled.AddUniqueDynamic(this, &UWotStuckItemsComponent::OnOwnerKilled);
+  }
+  // added after the owner spawned, so the grid has not seen it yet; an
+  // owner that is interactable itself stays registered instead and has to
+  // forward interaction to its stuck items, see AWotAICharacter::Interact
+  if (UWotInteractableGridSubsystem* Grid = UWotInteractableGridSubsystem::Get(this)) {
+    Grid->RegisterInteractable(GetOwner(), this);
+  }
+}
+
+void UWotStuckItemsComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+  if (EndPlayReason == EEndPlayReason::Destroyed) {
+    DropAll();
+  }
+  if (UWotInteractableGridSubsystem* Grid = UWotInteractableGridSubsystem::Get(this)) {
+    Grid->UnregisterInteractable(GetOwner(), this);
+  }
+  Super::EndPlay(EndPlayReason);
+}
+
+void UWotStuckItemsComponent::OnOwnerKilled(AActor* InstigatorActor, UWotAttributeComponent* OwningComp)
+{
+  DropAll();
+}
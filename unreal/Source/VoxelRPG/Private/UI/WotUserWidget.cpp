@@ -29,7 +29,7 @@ void UWotUserWidget::SetDuration(float NewDuration)
 {
   Duration = NewDuration;
   // now set a timer for destroying it
-  GetWorld()->GetTimerManager().SetTimer(TimerHandle_Remove, this, &UWotUserWidget::Remove_TimeElapsed, Duration);
+  UWotTimingWheelSubsystem::SetTimer(this, TimerHandle_Remove, &UWotUserWidget::Remove_TimeElapsed, Duration);
 }
 
 void UWotUserWidget::Remove_TimeElapsed()
@@ -0,0 +1,95 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "MassEntityTypes.h"
+#include "WotWildlifeFragments.generated.h"
+
+class AWotAICharacter;
+
+UENUM()
+enum class EWotWildlifeState : uint8
+{
+  Wander,
+  Forage,
+  Flee,
+};
+
+USTRUCT()
+struct FWotWildlifeTransformFragment : public FMassFragment
+{
+  GENERATED_BODY()
+
+  FVector Location = FVector::ZeroVector;
+
+  float Yaw = 0.0f;
+};
+
+USTRUCT()
+struct FWotWildlifeMovementFragment : public FMassFragment
+{
+  GENERATED_BODY()
+
+  // where the herd was spawned, wandering stays around it
+  FVector Home = FVector::ZeroVector;
+
+  FVector Goal = FVector::ZeroVector;
+
+  float Speed = 0.0f;
+};
+
+USTRUCT()
+struct FWotWildlifeBehaviorFragment : public FMassFragment
+{
+  GENERATED_BODY()
+
+  EWotWildlifeState State = EWotWildlifeState::Forage;
+
+  // until the next decision
+  float TimeLeft = 0.0f;
+};
+
+USTRUCT()
+struct FWotWildlifeSpeciesFragment : public FMassFragment
+{
+  GENERATED_BODY()
+
+  // index into UWotWildlifeSubsystem's species
+  int32 SpeciesIndex = INDEX_NONE;
+};
+
+USTRUCT()
+struct FWotWildlifeRepresentationFragment : public FMassFragment
+{
+  GENERATED_BODY()
+
+  // set while the animal is promoted to a full character
+  TWeakObjectPtr<AWotAICharacter> Actor;
+
+  // world time the ground height below the animal is traced again
+  double NextGroundTraceTime = 0.0;
+};
+
+USTRUCT()
+struct FWotWildlifeHealthFragment : public FMassFragment
+{
+  GENERATED_BODY()
+
+  // health of the character when the animal was last demoted, negative
+  // while it was never hurt
+  float Health = -1.0f;
+};
+
+// Animals promoted to a character, which drives them until demoted
+USTRUCT()
+struct FWotWildlifePromotedTag : public FMassTag
+{
+  GENERATED_BODY()
+};
+
+// Animals spawned by UWotWildlifeSubsystem::RunBench, only stepped by the
+// bench's own processors
+USTRUCT()
+struct FWotWildlifeBenchTag : public FMassTag
+{
+  GENERATED_BODY()
+};
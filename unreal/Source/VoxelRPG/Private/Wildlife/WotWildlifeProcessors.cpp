@@ -0,0 +1,223 @@
+#include "Wildlife/WotWildlifeProcessors.h"
+#include "Wildlife/WotWildlifeFragments.h"
+#include "Wildlife/WotWildlifeSpecies.h"
+#include "Wildlife/WotWildlifeSubsystem.h"
+#include "AI/WotAICharacter.h"
+#include "WotAttributeComponent.h"
+#include "MassExecutionContext.h"
+#include "Engine/World.h"
+
+// how close to its goal an animal stops
+static constexpr float GoalAcceptanceRadius = 50.0f;
+
+// trace height above and depth below an animal when looking for the ground
+static constexpr float GroundTraceUp = 500.0f;
+static constexpr float GroundTraceDown = 1500.0f;
+
+static float GetClosestDistanceSquared(const FVector& Location, const TArray<FVector>& Others, FVector& OutClosest)
+{
+  float ClosestDistanceSquared = TNumericLimits<float>::Max();
+  for (const FVector& Other : Others) {
+    const float DistanceSquared = (float)FVector::DistSquared2D(Location, Other);
+    if (DistanceSquared < ClosestDistanceSquared) {
+      ClosestDistanceSquared = DistanceSquared;
+      OutClosest = Other;
+    }
+  }
+  return ClosestDistanceSquared;
+}
+
+UWotWildlifeBehaviorProcessor::UWotWildlifeBehaviorProcessor()
+  : EntityQuery(*this)
+{
+  bAutoRegisterWithProcessingPhases = false;
+}
+
+void UWotWildlifeBehaviorProcessor::ConfigureQueries()
+{
+  EntityQuery.AddRequirement<FWotWildlifeTransformFragment>(EMassFragmentAccess::ReadOnly);
+  EntityQuery.AddRequirement<FWotWildlifeMovementFragment>(EMassFragmentAccess::ReadWrite);
+  EntityQuery.AddRequirement<FWotWildlifeBehaviorFragment>(EMassFragmentAccess::ReadWrite);
+  EntityQuery.AddRequirement<FWotWildlifeSpeciesFragment>(EMassFragmentAccess::ReadOnly);
+  EntityQuery.AddTagRequirement<FWotWildlifePromotedTag>(EMassFragmentPresence::None);
+  EntityQuery.AddTagRequirement<FWotWildlifeBenchTag>(bBench ? EMassFragmentPresence::All : EMassFragmentPresence::None);
+}
+
+void UWotWildlifeBehaviorProcessor::Execute(FMassEntityManager& EntityManager, FMassExecutionContext& Context)
+{
+  const UWotWildlifeSubsystem* Wildlife = UWotWildlifeSubsystem::Get(EntityManager.GetWorld());
+  if (!Wildlife) {
+    return;
+  }
+  const TArray<FVector>& Threats = Wildlife->ThreatLocations;
+  EntityQuery.ForEachEntityChunk(EntityManager, Context, [&](FMassExecutionContext& ChunkContext) {
+    const TConstArrayView<FWotWildlifeTransformFragment> Transforms = ChunkContext.GetFragmentView<FWotWildlifeTransformFragment>();
+    const TArrayView<FWotWildlifeMovementFragment> Movements = ChunkContext.GetMutableFragmentView<FWotWildlifeMovementFragment>();
+    const TArrayView<FWotWildlifeBehaviorFragment> Behaviors = ChunkContext.GetMutableFragmentView<FWotWildlifeBehaviorFragment>();
+    const TConstArrayView<FWotWildlifeSpeciesFragment> SpeciesFragments = ChunkContext.GetFragmentView<FWotWildlifeSpeciesFragment>();
+    const float DeltaTime = ChunkContext.GetDeltaTimeSeconds();
+    for (int32 Index = 0; Index < ChunkContext.GetNumEntities(); Index++) {
+      const UWotWildlifeSpecies* Species = Wildlife->GetSpecies(SpeciesFragments[Index].SpeciesIndex);
+      if (!Species) {
+        continue;
+      }
+      const FVector& Location = Transforms[Index].Location;
+      FWotWildlifeMovementFragment& Movement = Movements[Index];
+      FWotWildlifeBehaviorFragment& Behavior = Behaviors[Index];
+      // flee for as long as a player is close, and a bit longer
+      FVector Threat;
+      if (GetClosestDistanceSquared(Location, Threats, Threat) < FMath::Square(Species->FleeRadius)) {
+        const FVector Away = (Location - Threat).GetSafeNormal2D();
+        Behavior.State = EWotWildlifeState::Flee;
+        Behavior.TimeLeft = 2.0f;
+        Movement.Goal = Location + Away * Species->FleeDistance;
+        Movement.Speed = Species->RunSpeed;
+        continue;
+      }
+      Behavior.TimeLeft -= DeltaTime;
+      const bool bArrived = FVector::DistSquared2D(Location, Movement.Goal) < FMath::Square(GoalAcceptanceRadius);
+      if (Behavior.TimeLeft > 0.0f && !(Behavior.State != EWotWildlifeState::Forage && bArrived)) {
+        continue;
+      }
+      // done with the current behavior (or arrived), pick the next one
+      if (Behavior.State != EWotWildlifeState::Forage && FMath::FRand() < Species->ForageChance) {
+        Behavior.State = EWotWildlifeState::Forage;
+        Behavior.TimeLeft = FMath::FRandRange(Species->ForageDuration.X, Species->ForageDuration.Y);
+        Movement.Goal = Location;
+        Movement.Speed = 0.0f;
+      } else {
+        const FVector2D Offset = FMath::RandPointInCircle(Species->WanderRadius);
+        Behavior.State = EWotWildlifeState::Wander;
+        Behavior.TimeLeft = Species->WanderTimeout;
+        Movement.Goal = Movement.Home + FVector(Offset.X, Offset.Y, 0.0f);
+        Movement.Speed = Species->WalkSpeed;
+      }
+    }
+  });
+}
+
+UWotWildlifeMovementProcessor::UWotWildlifeMovementProcessor()
+  : EntityQuery(*this)
+{
+  bAutoRegisterWithProcessingPhases = false;
+}
+
+void UWotWildlifeMovementProcessor::ConfigureQueries()
+{
+  EntityQuery.AddRequirement<FWotWildlifeTransformFragment>(EMassFragmentAccess::ReadWrite);
+  EntityQuery.AddRequirement<FWotWildlifeMovementFragment>(EMassFragmentAccess::ReadOnly);
+  EntityQuery.AddTagRequirement<FWotWildlifePromotedTag>(EMassFragmentPresence::None);
+  EntityQuery.AddTagRequirement<FWotWildlifeBenchTag>(bBench ? EMassFragmentPresence::All : EMassFragmentPresence::None);
+}
+
+void UWotWildlifeMovementProcessor::Execute(FMassEntityManager& EntityManager, FMassExecutionContext& Context)
+{
+  EntityQuery.ForEachEntityChunk(EntityManager, Context, [](FMassExecutionContext& ChunkContext) {
+    const TArrayView<FWotWildlifeTransformFragment> Transforms = ChunkContext.GetMutableFragmentView<FWotWildlifeTransformFragment>();
+    const TConstArrayView<FWotWildlifeMovementFragment> Movements = ChunkContext.GetFragmentView<FWotWildlifeMovementFragment>();
+    const float DeltaTime = ChunkContext.GetDeltaTimeSeconds();
+    for (int32 Index = 0; Index < ChunkContext.GetNumEntities(); Index++) {
+      FWotWildlifeTransformFragment& Transform = Transforms[Index];
+      const FWotWildlifeMovementFragment& Movement = Movements[Index];
+      const FVector2D ToGoal(Movement.Goal.X - Transform.Location.X, Movement.Goal.Y - Transform.Location.Y);
+      const float Distance = ToGoal.Size();
+      if (Movement.Speed <= 0.0f || Distance < GoalAcceptanceRadius) {
+        continue;
+      }
+      // the height is left to the ground traces of the representation
+      const FVector2D Step = ToGoal * (FMath::Min(Movement.Speed * DeltaTime, Distance) / Distance);
+      Transform.Location.X += Step.X;
+      Transform.Location.Y += Step.Y;
+      Transform.Yaw = FMath::RadiansToDegrees(FMath::Atan2(ToGoal.Y, ToGoal.X));
+    }
+  });
+}
+
+UWotWildlifeRepresentationProcessor::UWotWildlifeRepresentationProcessor()
+  : EntityQuery(*this)
+{
+  bAutoRegisterWithProcessingPhases = false;
+  // spawns and releases actors
+  bRequiresGameThreadExecution = true;
+}
+
+void UWotWildlifeRepresentationProcessor::ConfigureQueries()
+{
+  EntityQuery.AddRequirement<FWotWildlifeTransformFragment>(EMassFragmentAccess::ReadWrite);
+  EntityQuery.AddRequirement<FWotWildlifeBehaviorFragment>(EMassFragmentAccess::ReadWrite);
+  EntityQuery.AddRequirement<FWotWildlifeSpeciesFragment>(EMassFragmentAccess::ReadOnly);
+  EntityQuery.AddRequirement<FWotWildlifeRepresentationFragment>(EMassFragmentAccess::ReadWrite);
+  EntityQuery.AddRequirement<FWotWildlifeHealthFragment>(EMassFragmentAccess::ReadWrite);
+  EntityQuery.AddTagRequirement<FWotWildlifeBenchTag>(EMassFragmentPresence::None);
+}
+
+void UWotWildlifeRepresentationProcessor::Execute(FMassEntityManager& EntityManager, FMassExecutionContext& Context)
+{
+  UWotWildlifeSubsystem* Wildlife = UWotWildlifeSubsystem::Get(EntityManager.GetWorld());
+  if (!Wildlife) {
+    return;
+  }
+  UWorld* World = Wildlife->GetWorld();
+  const double Now = World->GetTimeSeconds();
+  const TArray<FVector>& Viewers = Wildlife->ThreatLocations;
+  FCollisionQueryParams GroundParams(SCENE_QUERY_STAT(WotWildlifeGround), false, Wildlife->InstanceHost);
+  EntityQuery.ForEachEntityChunk(EntityManager, Context, [&](FMassExecutionContext& ChunkContext) {
+    const TArrayView<FWotWildlifeTransformFragment> Transforms = ChunkContext.GetMutableFragmentView<FWotWildlifeTransformFragment>();
+    const TArrayView<FWotWildlifeBehaviorFragment> Behaviors = ChunkContext.GetMutableFragmentView<FWotWildlifeBehaviorFragment>();
+    const TConstArrayView<FWotWildlifeSpeciesFragment> SpeciesFragments = ChunkContext.GetFragmentView<FWotWildlifeSpeciesFragment>();
+    const TArrayView<FWotWildlifeRepresentationFragment> Representations = ChunkContext.GetMutableFragmentView<FWotWildlifeRepresentationFragment>();
+    const TArrayView<FWotWildlifeHealthFragment> Healths = ChunkContext.GetMutableFragmentView<FWotWildlifeHealthFragment>();
+    for (int32 Index = 0; Index < ChunkContext.GetNumEntities(); Index++) {
+      const int32 SpeciesIndex = SpeciesFragments[Index].SpeciesIndex;
+      const UWotWildlifeSpecies* Species = Wildlife->GetSpecies(SpeciesIndex);
+      if (!Species) {
+        continue;
+      }
+      const FMassEntityHandle Entity = ChunkContext.GetEntity(Index);
+      FWotWildlifeTransformFragment& Transform = Transforms[Index];
+      FWotWildlifeRepresentationFragment& Representation = Representations[Index];
+      FVector Viewer;
+      const float DistanceSquared = GetClosestDistanceSquared(Transform.Location, Viewers, Viewer);
+
+      if (Representation.Actor.IsValid()) {
+        AWotAICharacter* Actor = Representation.Actor.Get();
+        if (!UWotAttributeComponent::IsActorAlive(Actor)) {
+          // the character drops its inventory and goes back to the pool by itself
+          Representation.Actor = nullptr;
+          Wildlife->RemoveKilled(Entity, ChunkContext.Defer());
+        } else if (DistanceSquared > FMath::Square(Species->PromoteRadius + Species->DemoteHysteresis)) {
+          Transform.Location = Actor->GetActorLocation() - FVector(0.0f, 0.0f, Actor->GetSimpleCollisionHalfHeight());
+          Transform.Yaw = Actor->GetActorRotation().Yaw;
+          Behaviors[Index].TimeLeft = 0.0f;
+          // the wounds are still there when it is promoted again
+          if (const UWotAttributeComponent* AttributeComp = UWotAttributeComponent::GetAttributes(Actor)) {
+            Healths[Index].Health = AttributeComp->GetHealth();
+          }
+          Representation.Actor = nullptr;
+          Representation.NextGroundTraceTime = 0.0;
+          Wildlife->Demote(Entity, Actor, ChunkContext.Defer());
+        }
+        continue;
+      }
+      if (Viewers.Num() > 0 && DistanceSquared < FMath::Square(Species->PromoteRadius)) {
+        Representation.Actor = Wildlife->Promote(Entity, SpeciesIndex, Transform.Location, Transform.Yaw, Healths[Index].Health, ChunkContext.Defer());
+        if (Representation.Actor.IsValid()) {
+          continue;
+        }
+      }
+      if (DistanceSquared > FMath::Square(Species->VisibleRadius)) {
+        continue;
+      }
+      // keep visible animals on the ground, a few traces per frame
+      if (Now >= Representation.NextGroundTraceTime && Wildlife->TryUseGroundTrace()) {
+        FHitResult Hit;
+        if (World->LineTraceSingleByChannel(Hit, Transform.Location + FVector(0.0f, 0.0f, GroundTraceUp),
+                                            Transform.Location - FVector(0.0f, 0.0f, GroundTraceDown), ECC_Visibility, GroundParams)) {
+          Transform.Location.Z = Hit.ImpactPoint.Z;
+        }
+        Representation.NextGroundTraceTime = Now + FMath::FRandRange(0.5f, 1.5f);
+      }
+      Wildlife->AddInstance(SpeciesIndex, Entity, FTransform(FRotator(0.0f, Transform.Yaw, 0.0f), Transform.Location));
+    }
+  });
+}
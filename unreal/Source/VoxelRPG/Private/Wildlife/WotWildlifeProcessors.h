@@ -0,0 +1,75 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "MassProcessor.h"
+#include "MassEntityQuery.h"
+#include "WotWildlifeProcessors.generated.h"
+
+// The wildlife processors are run by UWotWildlifeSubsystem in this order,
+// not by the mass processing phases
+
+// Picks what each animal does: flee from players in its flee radius,
+// otherwise forage or wander off when its current behavior ends
+UCLASS()
+class UWotWildlifeBehaviorProcessor : public UMassProcessor
+{
+  GENERATED_BODY()
+
+public:
+
+  UWotWildlifeBehaviorProcessor();
+
+  // set before initializing to step the bench animals only, see
+  // UWotWildlifeSubsystem::RunBench
+  bool bBench = false;
+
+protected:
+
+  virtual void ConfigureQueries() override;
+
+  virtual void Execute(FMassEntityManager& EntityManager, FMassExecutionContext& Context) override;
+
+  FMassEntityQuery EntityQuery;
+};
+
+// Moves the animals that aren't promoted towards their goal
+UCLASS()
+class UWotWildlifeMovementProcessor : public UMassProcessor
+{
+  GENERATED_BODY()
+
+public:
+
+  UWotWildlifeMovementProcessor();
+
+  // as for UWotWildlifeBehaviorProcessor
+  bool bBench = false;
+
+protected:
+
+  virtual void ConfigureQueries() override;
+
+  virtual void Execute(FMassEntityManager& EntityManager, FMassExecutionContext& Context) override;
+
+  FMassEntityQuery EntityQuery;
+};
+
+// Promotes animals near the players to characters and demotes them again,
+// and collects the instances to draw for the visible ones
+UCLASS()
+class UWotWildlifeRepresentationProcessor : public UMassProcessor
+{
+  GENERATED_BODY()
+
+public:
+
+  UWotWildlifeRepresentationProcessor();
+
+protected:
+
+  virtual void ConfigureQueries() override;
+
+  virtual void Execute(FMassEntityManager& EntityManager, FMassExecutionContext& Context) override;
+
+  FMassEntityQuery EntityQuery;
+};
@@ -0,0 +1,481 @@
+#include "Wildlife/WotWildlifeSubsystem.h"
+#include "Wildlife/WotWildlifeFragments.h"
+#include "Wildlife/WotWildlifeProcessors.h"
+#include "Wildlife/WotWildlifeSpecies.h"
+#include "AI/WotAICharacter.h"
+#include "AI/WotBotRegistrySubsystem.h"
+#include "WotAttributeComponent.h"
+#include "WotActorPoolSubsystem.h"
+#include "MassEntitySubsystem.h"
+#include "MassEntityManager.h"
+#include "MassCommandBuffer.h"
+#include "MassExecutor.h"
+#include "MassProcessingTypes.h"
+#include "Components/CapsuleComponent.h"
+#include "Components/InstancedStaticMeshComponent.h"
+#include "Engine/CollisionProfile.h"
+#include "GameFramework/PlayerController.h"
+#include "Engine/World.h"
+
+static TAutoConsoleVariable<bool> CVarWildlifeEnabled(TEXT("wot.Wildlife.Enabled"), true, TEXT("Simulate and draw the wildlife herds, off pauses them"), ECVF_Cheat);
+static TAutoConsoleVariable<int32> CVarWildlifeMaxGroundTracesPerFrame(TEXT("wot.Wildlife.MaxGroundTracesPerFrame"), 64, TEXT("Maximum number of traces per frame keeping visible animals on the ground"), ECVF_Cheat);
+
+// how far above and below a spawn point the ground is looked for
+static constexpr float SpawnTraceUp = 2000.0f;
+static constexpr float SpawnTraceDown = 5000.0f;
+
+static FAutoConsoleCommandWithWorldAndArgs WildlifeSpawnCommand(
+  TEXT("wot.Wildlife.Spawn"),
+  TEXT("Spawns a herd around the player. Arguments: species asset path, number of animals (default 100), radius (default 3000)"),
+  FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World) {
+    UWotWildlifeSubsystem* Wildlife = UWotWildlifeSubsystem::Get(World);
+    if (!Wildlife || Args.Num() == 0) {
+      return;
+    }
+    UWotWildlifeSpecies* Species = LoadObject<UWotWildlifeSpecies>(nullptr, *Args[0]);
+    if (!Species) {
+      UE_LOG(LogTemp, Warning, TEXT("wot.Wildlife.Spawn: no wildlife species '%s'"), *Args[0]);
+      return;
+    }
+    const int32 Count = Args.Num() > 1 ? FMath::Max(FCString::Atoi(*Args[1]), 1) : 100;
+    const float Radius = Args.Num() > 2 ? FCString::Atof(*Args[2]) : 3000.0f;
+    const APlayerController* PC = World->GetFirstPlayerController();
+    const FVector Center = PC && PC->GetPawn() ? PC->GetPawn()->GetActorLocation() : FVector::ZeroVector;
+    Wildlife->SpawnHerd(Species, Center, Count, Radius);
+  }));
+
+static FAutoConsoleCommandWithWorld WildlifeClearCommand(
+  TEXT("wot.Wildlife.Clear"),
+  TEXT("Removes every wildlife animal"),
+  FConsoleCommandWithWorldDelegate::CreateLambda([](UWorld* World) {
+    if (UWotWildlifeSubsystem* Wildlife = UWotWildlifeSubsystem::Get(World)) {
+      Wildlife->DespawnAll();
+    }
+  }));
+
+static FAutoConsoleCommandWithWorld WildlifeStatsCommand(
+  TEXT("wot.Wildlife.Stats"),
+  TEXT("Logs the wildlife counters"),
+  FConsoleCommandWithWorldDelegate::CreateLambda([](UWorld* World) {
+    UWotWildlifeSubsystem* Wildlife = UWotWildlifeSubsystem::Get(World);
+    if (!Wildlife) {
+      return;
+    }
+    const FWotWildlifeCounters Counters = Wildlife->GetCounters();
+    UE_LOG(LogTemp, Log, TEXT("Wildlife: %d animals, %d promoted, %d drawn, spawned %d, promotions %d, demotions %d, killed %d, ground traces %d, last update %.1f us"),
+           Wildlife->GetNumEntities(), Wildlife->GetNumPromoted(), Counters.InstancesDrawn, Counters.Spawned, Counters.Promotions,
+           Counters.Demotions, Counters.Killed, Counters.GroundTraces, Wildlife->GetLastTickMicroseconds());
+  }));
+
+static FAutoConsoleCommandWithWorldAndArgs WildlifeBenchCommand(
+  TEXT("wot.Wildlife.Bench"),
+  TEXT("Simulates animals without drawing or promoting them and logs the cost of a step, then removes them again. Optional arguments: number of animals (default 5000), number of steps (default 300)"),
+  FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World) {
+    UWotWildlifeSubsystem* Wildlife = UWotWildlifeSubsystem::Get(World);
+    if (!Wildlife) {
+      return;
+    }
+    const int32 Count = Args.Num() > 0 ? FMath::Max(FCString::Atoi(*Args[0]), 1) : 5000;
+    const int32 Frames = Args.Num() > 1 ? FMath::Max(FCString::Atoi(*Args[1]), 1) : 300;
+    const double Microseconds = Wildlife->RunBench(Count, Frames);
+    UE_LOG(LogTemp, Log, TEXT("wot.Wildlife.Bench: %d animals, %d steps, %.1f us per step"), Count, Frames, Microseconds);
+  }));
+
+UWotWildlifeSubsystem* UWotWildlifeSubsystem::Get(const UObject* WorldContextObject)
+{
+  if (!WorldContextObject) {
+    return nullptr;
+  }
+  UWorld* World = WorldContextObject->GetWorld();
+  return World ? World->GetSubsystem<UWotWildlifeSubsystem>() : nullptr;
+}
+
+UWotWildlifeSubsystem* UWotWildlifeSubsystem::GetIfEnabled(const UObject* WorldContextObject)
+{
+  return CVarWildlifeEnabled.GetValueOnGameThread() ? Get(WorldContextObject) : nullptr;
+}
+
+void UWotWildlifeSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+  Super::Initialize(Collection);
+  Collection.InitializeDependency<UMassEntitySubsystem>();
+  SimulationProcessors.Add(NewObject<UWotWildlifeBehaviorProcessor>(this));
+  SimulationProcessors.Add(NewObject<UWotWildlifeMovementProcessor>(this));
+  for (UMassProcessor* Processor : SimulationProcessors) {
+    Processor->CallInitialize(this);
+  }
+  RepresentationProcessor = NewObject<UWotWildlifeRepresentationProcessor>(this);
+  RepresentationProcessor->CallInitialize(this);
+}
+
+void UWotWildlifeSubsystem::Deinitialize()
+{
+  DespawnAll();
+  if (InstanceHost) {
+    InstanceHost->Destroy();
+    InstanceHost = nullptr;
+  }
+  InstanceComps.Empty();
+  InstanceTransforms.Empty();
+  InstanceEntities.Empty();
+  Species.Empty();
+  SimulationProcessors.Empty();
+  BenchProcessors.Empty();
+  RepresentationProcessor = nullptr;
+  Super::Deinitialize();
+}
+
+TStatId UWotWildlifeSubsystem::GetStatId() const
+{
+  RETURN_QUICK_DECLARE_CYCLE_STAT(UWotWildlifeSubsystem, STATGROUP_Tickables);
+}
+
+FMassEntityManager* UWotWildlifeSubsystem::GetEntityManager() const
+{
+  UMassEntitySubsystem* EntitySubsystem = GetWorld()->GetSubsystem<UMassEntitySubsystem>();
+  return EntitySubsystem ? &EntitySubsystem->GetMutableEntityManager() : nullptr;
+}
+
+void UWotWildlifeSubsystem::ResetCounters()
+{
+  Counters = FWotWildlifeCounters();
+}
+
+int32 UWotWildlifeSubsystem::RegisterSpecies(UWotWildlifeSpecies* NewSpecies)
+{
+  int32 SpeciesIndex = Species.Find(NewSpecies);
+  if (SpeciesIndex == INDEX_NONE) {
+    SpeciesIndex = Species.Add(NewSpecies);
+    InstanceComps.Add(nullptr);
+    InstanceTransforms.AddDefaulted();
+    InstanceEntities.AddDefaulted();
+  }
+  return SpeciesIndex;
+}
+
+void UWotWildlifeSubsystem::UnregisterLastSpecies(UWotWildlifeSpecies* LastSpecies)
+{
+  if (!ensure(Species.Num() > 0 && Species.Last() == LastSpecies)) {
+    return;
+  }
+  Species.Pop();
+  if (UInstancedStaticMeshComponent* InstanceComp = InstanceComps.Pop()) {
+    InstanceComp->DestroyComponent();
+  }
+  InstanceTransforms.Pop();
+  InstanceEntities.Pop();
+}
+
+int32 UWotWildlifeSubsystem::SpawnHerd(UWotWildlifeSpecies* HerdSpecies, FVector Center, int32 Count, float Radius)
+{
+  return SpawnEntities(HerdSpecies, Center, Count, Radius, false);
+}
+
+int32 UWotWildlifeSubsystem::SpawnEntities(UWotWildlifeSpecies* HerdSpecies, const FVector& Center, int32 Count, float Radius, bool bBench, TArray<FMassEntityHandle>* OutEntities)
+{
+  FMassEntityManager* EntityManager = GetEntityManager();
+  if (!ensure(HerdSpecies) || !EntityManager || Count <= 0) {
+    return 0;
+  }
+  const int32 SpeciesIndex = RegisterSpecies(HerdSpecies);
+  FMassArchetypeHandle& SpawnArchetype = bBench ? BenchArchetype : Archetype;
+  if (!SpawnArchetype.IsValid()) {
+    const UScriptStruct* FragmentsAndTags[] = {
+      FWotWildlifeTransformFragment::StaticStruct(),
+      FWotWildlifeMovementFragment::StaticStruct(),
+      FWotWildlifeBehaviorFragment::StaticStruct(),
+      FWotWildlifeSpeciesFragment::StaticStruct(),
+      FWotWildlifeRepresentationFragment::StaticStruct(),
+      FWotWildlifeHealthFragment::StaticStruct(),
+      FWotWildlifeBenchTag::StaticStruct(),
+    };
+    // the bench tag only goes on the bench archetype
+    const int32 NumFragmentsAndTags = UE_ARRAY_COUNT(FragmentsAndTags) - (bBench ? 0 : 1);
+    SpawnArchetype = EntityManager->CreateArchetype(TConstArrayView<const UScriptStruct*>(FragmentsAndTags, NumFragmentsAndTags));
+  }
+  TArray<FMassEntityHandle> NewEntities;
+  {
+    // observers are notified when the creation context goes out of scope
+    auto CreationContext = EntityManager->BatchCreateEntities(SpawnArchetype, Count, NewEntities);
+    FCollisionQueryParams GroundParams(SCENE_QUERY_STAT(WotWildlifeSpawn), false, InstanceHost);
+    for (const FMassEntityHandle Entity : NewEntities) {
+      const FVector2D Offset = FMath::RandPointInCircle(Radius);
+      FVector Location = Center + FVector(Offset.X, Offset.Y, 0.0f);
+      FHitResult Hit;
+      if (!bBench && GetWorld()->LineTraceSingleByChannel(Hit, Location + FVector(0.0f, 0.0f, SpawnTraceUp),
+                                                               Location - FVector(0.0f, 0.0f, SpawnTraceDown), ECC_Visibility, GroundParams)) {
+        Location.Z = Hit.ImpactPoint.Z;
+      }
+      FWotWildlifeTransformFragment& Transform = EntityManager->GetFragmentDataChecked<FWotWildlifeTransformFragment>(Entity);
+      Transform.Location = Location;
+      Transform.Yaw = FMath::FRandRange(-180.0f, 180.0f);
+      FWotWildlifeMovementFragment& Movement = EntityManager->GetFragmentDataChecked<FWotWildlifeMovementFragment>(Entity);
+      Movement.Home = Center;
+      Movement.Goal = Location;
+      // start out foraging for a random while so the herd doesn't move in sync
+      FWotWildlifeBehaviorFragment& Behavior = EntityManager->GetFragmentDataChecked<FWotWildlifeBehaviorFragment>(Entity);
+      Behavior.State = EWotWildlifeState::Forage;
+      Behavior.TimeLeft = FMath::FRandRange(0.0f, HerdSpecies->ForageDuration.Y);
+      EntityManager->GetFragmentDataChecked<FWotWildlifeSpeciesFragment>(Entity).SpeciesIndex = SpeciesIndex;
+      Entities.Add(Entity);
+    }
+  }
+  Counters.Spawned += NewEntities.Num();
+  if (OutEntities) {
+    OutEntities->Append(NewEntities);
+  }
+  return NewEntities.Num();
+}
+
+void UWotWildlifeSubsystem::DespawnEntities(TConstArrayView<FMassEntityHandle> EntitiesToRemove)
+{
+  FMassEntityManager* EntityManager = GetEntityManager();
+  if (!EntityManager) {
+    return;
+  }
+  TArray<FMassEntityHandle> ValidEntities;
+  ValidEntities.Reserve(EntitiesToRemove.Num());
+  for (const FMassEntityHandle Entity : EntitiesToRemove) {
+    if (!Entities.Remove(Entity) || !EntityManager->IsEntityValid(Entity)) {
+      continue;
+    }
+    const FWotWildlifeRepresentationFragment& Representation = EntityManager->GetFragmentDataChecked<FWotWildlifeRepresentationFragment>(Entity);
+    if (AWotAICharacter* Actor = Representation.Actor.Get()) {
+      UWotActorPoolSubsystem::ReleasePooled(Actor);
+      NumPromoted--;
+    }
+    ValidEntities.Add(Entity);
+  }
+  EntityManager->BatchDestroyEntities(ValidEntities);
+}
+
+void UWotWildlifeSubsystem::DespawnAll()
+{
+  DespawnEntities(Entities.Array());
+  Entities.Reset();
+  NumPromoted = 0;
+  for (int32 SpeciesIndex = 0; SpeciesIndex < Species.Num(); SpeciesIndex++) {
+    InstanceTransforms[SpeciesIndex].Reset();
+    InstanceEntities[SpeciesIndex].Reset();
+  }
+  FlushInstances();
+}
+
+void UWotWildlifeSubsystem::Tick(float DeltaTime)
+{
+  if (!CVarWildlifeEnabled.GetValueOnGameThread()) {
+    return;
+  }
+  const uint64 StartCycles = FPlatformTime::Cycles64();
+  Simulate(DeltaTime, false);
+  LastTickMicroseconds = FPlatformTime::ToMilliseconds64(FPlatformTime::Cycles64() - StartCycles) * 1000.0;
+}
+
+void UWotWildlifeSubsystem::Simulate(float DeltaTime, bool bBench)
+{
+  FMassEntityManager* EntityManager = GetEntityManager();
+  if (!EntityManager) {
+    return;
+  }
+  ThreatLocations.Reset();
+  for (FConstPlayerControllerIterator It = GetWorld()->GetPlayerControllerIterator(); It; ++It) {
+    const APlayerController* PC = It->Get();
+    if (PC && PC->GetPawn()) {
+      ThreatLocations.Add(PC->GetPawn()->GetActorLocation());
+    }
+  }
+  FMassProcessingContext ProcessingContext(*EntityManager, DeltaTime);
+  UE::Mass::Executor::RunProcessorsView(bBench ? BenchProcessors : SimulationProcessors, ProcessingContext);
+  if (bBench) {
+    return;
+  }
+  for (int32 SpeciesIndex = 0; SpeciesIndex < Species.Num(); SpeciesIndex++) {
+    InstanceTransforms[SpeciesIndex].Reset();
+    InstanceEntities[SpeciesIndex].Reset();
+  }
+  GroundTracesLeft = CVarWildlifeMaxGroundTracesPerFrame.GetValueOnGameThread();
+  FMassProcessingContext RepresentationContext(*EntityManager, DeltaTime);
+  UE::Mass::Executor::RunProcessorsView(MakeArrayView(&RepresentationProcessor, 1), RepresentationContext);
+  FlushInstances();
+}
+
+double UWotWildlifeSubsystem::RunBench(int32 Count, int32 Frames)
+{
+  if (BenchProcessors.Num() == 0) {
+    UWotWildlifeBehaviorProcessor* BehaviorProcessor = NewObject<UWotWildlifeBehaviorProcessor>(this);
+    BehaviorProcessor->bBench = true;
+    BenchProcessors.Add(BehaviorProcessor);
+    UWotWildlifeMovementProcessor* MovementProcessor = NewObject<UWotWildlifeMovementProcessor>(this);
+    MovementProcessor->bBench = true;
+    BenchProcessors.Add(MovementProcessor);
+    for (UMassProcessor* Processor : BenchProcessors) {
+      Processor->CallInitialize(this);
+    }
+  }
+  // a species without visuals, the bench never promotes or draws
+  UWotWildlifeSpecies* BenchSpecies = NewObject<UWotWildlifeSpecies>(this);
+  TArray<FMassEntityHandle> BenchEntities;
+  SpawnEntities(BenchSpecies, FVector::ZeroVector, Count, FMath::Sqrt((float)Count) * 200.0f, true, &BenchEntities);
+  const uint64 StartCycles = FPlatformTime::Cycles64();
+  for (int32 Frame = 0; Frame < Frames; Frame++) {
+    Simulate(1.0f / 30.0f, true);
+  }
+  const double Microseconds = FPlatformTime::ToMilliseconds64(FPlatformTime::Cycles64() - StartCycles) * 1000.0 / FMath::Max(Frames, 1);
+  DespawnEntities(BenchEntities);
+  UnregisterLastSpecies(BenchSpecies);
+  return Microseconds;
+}
+
+AWotAICharacter* UWotWildlifeSubsystem::Promote(FMassEntityHandle Entity, int32 SpeciesIndex, const FVector& Location, float Yaw, float Health, FMassCommandBuffer& CommandBuffer)
+{
+  const UWotWildlifeSpecies* EntitySpecies = GetSpecies(SpeciesIndex);
+  if (!EntitySpecies || !EntitySpecies->CharacterClass) {
+    return nullptr;
+  }
+  // entities stand on the ground, characters on the bottom of their capsule
+  const AWotAICharacter* DefaultCharacter = EntitySpecies->CharacterClass.GetDefaultObject();
+  const float HalfHeight = DefaultCharacter->GetCapsuleComponent() ? DefaultCharacter->GetCapsuleComponent()->GetScaledCapsuleHalfHeight() : 0.0f;
+  FActorSpawnParameters SpawnParams;
+  SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButAlwaysSpawn;
+  AWotAICharacter* Actor = UWotActorPoolSubsystem::SpawnPooled<AWotAICharacter>(this, EntitySpecies->CharacterClass,
+    FTransform(FRotator(0.0f, Yaw, 0.0f), Location + FVector(0.0f, 0.0f, HalfHeight)), SpawnParams);
+  if (!Actor) {
+    return nullptr;
+  }
+  // registered by acquiring it; animals aren't enemies, they don't hold
+  // back enemy spawns or get killed by KillAll
+  if (UWotBotRegistrySubsystem* Registry = UWotBotRegistrySubsystem::Get(this)) {
+    Registry->UnregisterBot(Actor);
+  }
+  UWotAttributeComponent* AttributeComp = UWotAttributeComponent::GetAttributes(Actor);
+  if (AttributeComp && Health >= 0.0f) {
+    AttributeComp->RestoreHealth(Health);
+  }
+  CommandBuffer.AddTag<FWotWildlifePromotedTag>(Entity);
+  NumPromoted++;
+  Counters.Promotions++;
+  return Actor;
+}
+
+void UWotWildlifeSubsystem::Demote(FMassEntityHandle Entity, AWotAICharacter* Actor, FMassCommandBuffer& CommandBuffer)
+{
+  UWotActorPoolSubsystem::ReleasePooled(Actor);
+  CommandBuffer.RemoveTag<FWotWildlifePromotedTag>(Entity);
+  NumPromoted--;
+  Counters.Demotions++;
+}
+
+void UWotWildlifeSubsystem::RemoveKilled(FMassEntityHandle Entity, FMassCommandBuffer& CommandBuffer)
+{
+  CommandBuffer.DestroyEntity(Entity);
+  Entities.Remove(Entity);
+  NumPromoted--;
+  Counters.Killed++;
+}
+
+AActor* UWotWildlifeSubsystem::ResolveHitActor(AActor* HitActor, const FHitResult& Hit)
+{
+  UWotWildlifeSubsystem* Wildlife = Get(HitActor);
+  if (!Wildlife || !HitActor || HitActor != Wildlife->InstanceHost) {
+    return HitActor;
+  }
+  // instance indices match the instance entities until the next update
+  const int32 SpeciesIndex = Wildlife->InstanceComps.IndexOfByKey(Hit.GetComponent());
+  FMassEntityManager* EntityManager = Wildlife->GetEntityManager();
+  if (SpeciesIndex == INDEX_NONE || !EntityManager || !Wildlife->InstanceEntities[SpeciesIndex].IsValidIndex(Hit.Item)) {
+    return HitActor;
+  }
+  const FMassEntityHandle Entity = Wildlife->InstanceEntities[SpeciesIndex][Hit.Item];
+  if (!EntityManager->IsEntityValid(Entity)) {
+    return HitActor;
+  }
+  FWotWildlifeRepresentationFragment& Representation = EntityManager->GetFragmentDataChecked<FWotWildlifeRepresentationFragment>(Entity);
+  if (Representation.Actor.IsValid()) {
+    return Representation.Actor.Get();
+  }
+  const FWotWildlifeTransformFragment& Transform = EntityManager->GetFragmentDataChecked<FWotWildlifeTransformFragment>(Entity);
+  const float Health = EntityManager->GetFragmentDataChecked<FWotWildlifeHealthFragment>(Entity).Health;
+  AWotAICharacter* Actor = Wildlife->Promote(Entity, SpeciesIndex, Transform.Location, Transform.Yaw, Health, EntityManager->Defer());
+  if (!Actor) {
+    return HitActor;
+  }
+  // before flushing, adding the tag moves the entity's fragments
+  Representation.Actor = Actor;
+  EntityManager->FlushCommands();
+  return Actor;
+}
+
+void UWotWildlifeSubsystem::AddInstance(int32 SpeciesIndex, FMassEntityHandle Entity, const FTransform& Transform)
+{
+  InstanceTransforms[SpeciesIndex].Add(Transform);
+  InstanceEntities[SpeciesIndex].Add(Entity);
+}
+
+bool UWotWildlifeSubsystem::TryUseGroundTrace()
+{
+  if (GroundTracesLeft <= 0) {
+    return false;
+  }
+  GroundTracesLeft--;
+  Counters.GroundTraces++;
+  return true;
+}
+
+UInstancedStaticMeshComponent* UWotWildlifeSubsystem::GetOrCreateInstanceComp(int32 SpeciesIndex)
+{
+  if (InstanceComps[SpeciesIndex]) {
+    return InstanceComps[SpeciesIndex];
+  }
+  UStaticMesh* Mesh = Species[SpeciesIndex]->Mesh;
+  if (!Mesh) {
+    return nullptr;
+  }
+  if (!InstanceHost) {
+    FActorSpawnParameters SpawnParams;
+    SpawnParams.ObjectFlags |= RF_Transient;
+    InstanceHost = GetWorld()->SpawnActor<AActor>(AActor::StaticClass(), FTransform::Identity, SpawnParams);
+    USceneComponent* Root = NewObject<USceneComponent>(InstanceHost, "Root");
+    InstanceHost->SetRootComponent(Root);
+    Root->RegisterComponent();
+  }
+  UInstancedStaticMeshComponent* InstanceComp = NewObject<UInstancedStaticMeshComponent>(InstanceHost);
+  InstanceComp->SetMobility(EComponentMobility::Movable);
+  InstanceComp->SetStaticMesh(Mesh);
+  // only queried, so hits on an animal can promote it
+  InstanceComp->SetCollisionProfileName(UCollisionProfile::Pawn_ProfileName);
+  InstanceComp->SetCollisionEnabled(ECollisionEnabled::QueryOnly);
+  InstanceComp->SetGenerateOverlapEvents(true);
+  InstanceComp->SetupAttachment(InstanceHost->GetRootComponent());
+  InstanceComp->RegisterComponent();
+  InstanceHost->AddInstanceComponent(InstanceComp);
+  InstanceComps[SpeciesIndex] = InstanceComp;
+  return InstanceComp;
+}
+
+void UWotWildlifeSubsystem::FlushInstances()
+{
+  Counters.InstancesDrawn = 0;
+  for (int32 SpeciesIndex = 0; SpeciesIndex < Species.Num(); SpeciesIndex++) {
+    const TArray<FTransform>& Transforms = InstanceTransforms[SpeciesIndex];
+    UInstancedStaticMeshComponent* InstanceComp = Transforms.Num() > 0 ? GetOrCreateInstanceComp(SpeciesIndex) : InstanceComps[SpeciesIndex];
+    if (!InstanceComp) {
+      continue;
+    }
+    // grow or shrink at the end, then move all instances in one batch
+    const int32 NumInstances = InstanceComp->GetInstanceCount();
+    if (NumInstances > Transforms.Num()) {
+      TArray<int32> Removed;
+      for (int32 Index = Transforms.Num(); Index < NumInstances; Index++) {
+        Removed.Add(Index);
+      }
+      InstanceComp->RemoveInstances(Removed);
+    } else if (NumInstances < Transforms.Num()) {
+      const TArray<FTransform> Added(Transforms.GetData() + NumInstances, Transforms.Num() - NumInstances);
+      InstanceComp->AddInstances(Added, false, true, false);
+    }
+    if (Transforms.Num() > 0) {
+      InstanceComp->BatchUpdateInstancesTransforms(0, Transforms, true, true, true);
+    }
+    Counters.InstancesDrawn += Transforms.Num();
+  }
+}
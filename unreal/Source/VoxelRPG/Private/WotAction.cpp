@@ -1,5 +1,6 @@
 #include "WotAction.h"
 #include "WotActionComponent.h"
+#include "WotAttributeComponent.h"
 #include "GameFramework/Pawn.h"
 #include "GameFramework/PawnMovementComponent.h"
 
@@ -13,14 +14,43 @@ bool UWotAction::CanStart_Implementation(AActor* Instigator)
   if (IsRunning()) {
     return false;
   }
+  if (GetCooldownRemaining() > 0.0f) {
+    return false;
+  }
 
   UWotActionComponent* Comp = GetOwningComponent();
 
-  if (Comp->ActiveGameplayTags.HasAny(BlockedTags)) {
-    return false;
+  if (!bTagMasksBuilt) {
+    BlockedTagMask = FWotGameplayTagMask::MakeRequirement(BlockedTags);
+    RequiredTagMask = FWotGameplayTagMask::MakeRequirement(RequiredTags);
+    bTagMasksBuilt = true;
   }
-  if (!Comp->ActiveGameplayTags.HasAll(RequiredTags)) {
-    return false;
+  if (BlockedTagMask.bValid && RequiredTagMask.bValid) {
+    const FWotGameplayTagMask& ActiveTagMask = Comp->GetActiveTagMask();
+    if (ActiveTagMask.HasAny(BlockedTagMask) || !ActiveTagMask.HasAll(RequiredTagMask)) {
+      return false;
+    }
+  } else {
+    if (Comp->ActiveGameplayTags.HasAny(BlockedTags)) {
+      return false;
+    }
+    if (!Comp->ActiveGameplayTags.HasAll(RequiredTags)) {
+      return false;
+    }
+  }
+
+  if (StaminaCost > 0.0f || MagicCost > 0.0f || StaminaCostPerSecond > 0.0f) {
+    UWotAttributeComponent* AttributeComp = UWotAttributeComponent::GetAttributes(Comp->GetOwner());
+    // a drain needs some stamina left to start from
+    const float StaminaNeeded = StaminaCostPerSecond > 0.0f ? FMath::Max(StaminaCost, KINDA_SMALL_NUMBER) : StaminaCost;
+    if (AttributeComp) {
+      if (AttributeComp->GetStamina() < StaminaNeeded) {
+        return false;
+      }
+      if (AttributeComp->GetMagic() < MagicCost) {
+        return false;
+      }
+    }
   }
 
   // check if the instigator is falling
@@ -45,11 +75,29 @@ void UWotAction::Start_Implementation(AActor* Instigator)
     return;
   }
   // add the tags we grant
-  Comp->ActiveGameplayTags.AppendTags(GrantsTags);
+  Comp->AddGameplayTags(GrantsTags);
   // remove the tags we remove
-  Comp->ActiveGameplayTags.RemoveTags(RemovesTags);
+  Comp->RemoveGameplayTags(RemovesTags);
+  // pay for the action
+  UWotAttributeComponent* AttributeComp = UWotAttributeComponent::GetAttributes(Comp->GetOwner());
+  if (AttributeComp) {
+    if (StaminaCost > 0.0f) {
+      AttributeComp->ApplyStaminaChange(-StaminaCost);
+    }
+    if (MagicCost > 0.0f) {
+      AttributeComp->ApplyMagicChangeInstigator(Instigator, -MagicCost);
+    }
+    if (StaminaCostPerSecond > 0.0f) {
+      AttributeComp->AddStaminaDrain(StaminaCostPerSecond);
+    }
+  }
   // make sure to update the running flag
   bIsRunning = true;
+  if (AttributeComp && StaminaCostPerSecond > 0.0f) {
+    SetStaminaDepletedTimer(Instigator);
+  }
+  RunningInstigator = Instigator;
+  EnterPhase(WindupDuration > 0.0f ? EWotActionPhase::Windup : EWotActionPhase::Active);
 }
 
 void UWotAction::Stop_Implementation(AActor* Instigator)
@@ -64,11 +112,114 @@ void UWotAction::Stop_Implementation(AActor* Instigator)
     return;
   }
   // remove the tags we grant
-  Comp->ActiveGameplayTags.RemoveTags(GrantsTags);
+  Comp->RemoveGameplayTags(GrantsTags);
+  if (StaminaCostPerSecond > 0.0f) {
+    UWotTimingWheelSubsystem::ClearTimer(this, TimerHandle_StaminaDepleted);
+    if (UWotAttributeComponent* AttributeComp = UWotAttributeComponent::GetAttributes(Comp->GetOwner())) {
+      AttributeComp->RemoveStaminaDrain(StaminaCostPerSecond);
+    }
+  }
+  UWotTimingWheelSubsystem::ClearTimer(this, TimerHandle_Phase);
+  Phase = EWotActionPhase::None;
+  RunningInstigator.Reset();
+  if (Cooldown > 0.0f && GetWorld()) {
+    CooldownEndTime = GetWorld()->GetTimeSeconds() + Cooldown;
+  }
   // make sure to update the running flag
   bIsRunning = false;
 }
 
+void UWotAction::OnPhaseStarted_Implementation(AActor* Instigator, EWotActionPhase NewPhase)
+{
+}
+
+void UWotAction::EnterPhase(EWotActionPhase NewPhase)
+{
+  Phase = NewPhase;
+  OnPhaseStarted(RunningInstigator.Get(), NewPhase);
+  // the hook may have stopped the action
+  if (!bIsRunning || Phase != NewPhase) {
+    return;
+  }
+  float Duration = 0.0f;
+  switch (NewPhase) {
+    case EWotActionPhase::Windup:
+      Duration = WindupDuration;
+      break;
+    case EWotActionPhase::Active:
+      if (!bAutoStop) {
+        // active until stopped
+        return;
+      }
+      Duration = ActiveDuration;
+      break;
+    case EWotActionPhase::Recovery:
+      Duration = RecoveryDuration;
+      break;
+    default:
+      return;
+  }
+  // even zero length phases end on the next wheel tick, so hooks never
+  // recurse into the next phase
+  UWotTimingWheelSubsystem::SetTimer(this, TimerHandle_Phase, &UWotAction::PhaseElapsed, Duration);
+}
+
+void UWotAction::PhaseElapsed()
+{
+  if (!bIsRunning) {
+    return;
+  }
+  switch (Phase) {
+    case EWotActionPhase::Windup:
+      EnterPhase(EWotActionPhase::Active);
+      break;
+    case EWotActionPhase::Active:
+      if (RecoveryDuration > 0.0f) {
+        EnterPhase(EWotActionPhase::Recovery);
+      } else {
+        Stop(RunningInstigator.Get());
+      }
+      break;
+    case EWotActionPhase::Recovery:
+      Stop(RunningInstigator.Get());
+      break;
+    default:
+      break;
+  }
+}
+
+void UWotAction::SetStaminaDepletedTimer(AActor* Instigator)
+{
+  UWotActionComponent* Comp = GetOwningComponent();
+  UWotAttributeComponent* AttributeComp = Comp ? UWotAttributeComponent::GetAttributes(Comp->GetOwner()) : nullptr;
+  if (!AttributeComp) {
+    return;
+  }
+  const float Seconds = AttributeComp->GetSecondsUntilStaminaDepleted();
+  if (Seconds < 0.0f) {
+    // regeneration outpaces the drain, nothing to wait for
+    return;
+  }
+  UWotTimingWheelSubsystem::SetTimer(this, TimerHandle_StaminaDepleted, Seconds,
+    FTimerDelegate::CreateUObject(this, &UWotAction::StaminaDepleted_TimeElapsed, TWeakObjectPtr<AActor>(Instigator)));
+}
+
+void UWotAction::StaminaDepleted_TimeElapsed(TWeakObjectPtr<AActor> Instigator)
+{
+  if (!bIsRunning) {
+    return;
+  }
+  UWotActionComponent* Comp = GetOwningComponent();
+  UWotAttributeComponent* AttributeComp = Comp ? UWotAttributeComponent::GetAttributes(Comp->GetOwner()) : nullptr;
+  // other costs or regeneration may have moved the moment stamina runs out
+  // since the timer was set
+  if (AttributeComp && AttributeComp->GetStamina() > KINDA_SMALL_NUMBER) {
+    SetStaminaDepletedTimer(Instigator.Get());
+    return;
+  }
+  Stop(Instigator.Get());
+}
+
 UWorld* UWotAction::GetWorld() const
 {
   // Outer is set when creating action via NewObject<T>
@@ -88,3 +239,17 @@ bool UWotAction::IsRunning() const
 {
   return bIsRunning;
 }
+
+EWotActionPhase UWotAction::GetPhase() const
+{
+  return Phase;
+}
+
+float UWotAction::GetCooldownRemaining() const
+{
+  const UWorld* World = GetWorld();
+  if (!World) {
+    return 0.0f;
+  }
+  return FMath::Max((float)(CooldownEndTime - World->GetTimeSeconds()), 0.0f);
+}
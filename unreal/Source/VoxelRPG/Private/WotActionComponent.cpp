@@ -1,14 +1,33 @@
 #include "WotActionComponent.h"
+#include "WotComponentHost.h"
 #include "WotAction.h"
+#include "UObject/UObjectIterator.h"
 
-UWotActionComponent::UWotActionComponent()
+static void OnDebugActionTagsChanged(IConsoleVariable* Variable)
 {
+  // the components only tick to print their tags
+  const bool bEnabled = Variable->GetBool();
+  for (TObjectIterator<UWotActionComponent> It; It; ++It) {
+    if (It->HasBegunPlay()) {
+      It->SetComponentTickEnabled(bEnabled);
+    }
+  }
+}
 
+static TAutoConsoleVariable<bool> CVarDebugActionTags(TEXT("wot.Debug.ActionTags"), false, TEXT("Print the active gameplay tags of every action component on screen each frame (see the VoxelRPG gameplay debugger category for the selected actor only)"), FConsoleVariableDelegate::CreateStatic(&OnDebugActionTagsChanged), ECVF_Cheat);
+static TAutoConsoleVariable<bool> CVarDebugActionFailures(TEXT("wot.Debug.ActionFailures"), false, TEXT("Print actions that failed to start on screen"), ECVF_Cheat);
+
+UWotActionComponent::UWotActionComponent()
+{
+  // only ticks for wot.Debug.ActionTags
+  PrimaryComponentTick.bCanEverTick = true;
+  PrimaryComponentTick.bStartWithTickEnabled = false;
 }
 
 void UWotActionComponent::BeginPlay()
 {
   Super::BeginPlay();
+  SetComponentTickEnabled(CVarDebugActionTags.GetValueOnGameThread());
   // Start the owning actor with the default actions
   for (auto& ActionClass : DefaultActions) {
     AddAction(ActionClass);
@@ -31,16 +50,23 @@ void UWotActionComponent::AddAction(TSubclassOf<UWotAction> ActionClass)
   UWotAction* NewAction = NewObject<UWotAction>(this, ActionClass);
   if (ensure(NewAction)) {
     Actions.Add(NewAction);
+    ActionsByName.FindOrAdd(NewAction->ActionName).Add(NewAction);
   }
 }
 
 bool UWotActionComponent::StartActionByName(AActor* Instigator, FName ActionName)
 {
-  for (UWotAction* Action : Actions) {
-    if (Action && Action->ActionName == ActionName) {
+  const auto* NamedActions = ActionsByName.Find(ActionName);
+  if (!NamedActions) {
+    return false;
+  }
+  for (UWotAction* Action : *NamedActions) {
+    if (Action) {
       if (!Action->CanStart(Instigator)) {
-        FString FailedMsg = FString::Printf(TEXT("Failed to run: %s"), *ActionName.ToString());
-        GEngine->AddOnScreenDebugMessage(-1, 2.0f, FColor::Red, FailedMsg);
+        if (CVarDebugActionFailures.GetValueOnGameThread()) {
+          FString FailedMsg = FString::Printf(TEXT("Failed to run: %s"), *ActionName.ToString());
+          GEngine->AddOnScreenDebugMessage(-1, 2.0f, FColor::Red, FailedMsg);
+        }
         // can't start this action, so continue on to the next action in the array
         continue;
       }
@@ -53,8 +79,12 @@ bool UWotActionComponent::StartActionByName(AActor* Instigator, FName ActionName
 
 bool UWotActionComponent::StopActionByName(AActor* Instigator, FName ActionName)
 {
-  for (UWotAction* Action : Actions) {
-    if (Action && Action->ActionName == ActionName) {
+  const auto* NamedActions = ActionsByName.Find(ActionName);
+  if (!NamedActions) {
+    return false;
+  }
+  for (UWotAction* Action : *NamedActions) {
+    if (Action) {
       if (Action->IsRunning()) {
         Action->Stop(Instigator);
         return true;
@@ -64,10 +94,42 @@ bool UWotActionComponent::StopActionByName(AActor* Instigator, FName ActionName)
   return false;
 }
 
+void UWotActionComponent::AddGameplayTags(const FGameplayTagContainer& Tags)
+{
+  ActiveGameplayTags.AppendTags(Tags);
+  ActiveTagMaskGeneration = 0;
+}
+
+void UWotActionComponent::RemoveGameplayTags(const FGameplayTagContainer& Tags)
+{
+  ActiveGameplayTags.RemoveTags(Tags);
+  ActiveTagMaskGeneration = 0;
+}
+
+void UWotActionComponent::AddGameplayTag(const FGameplayTag& Tag)
+{
+  ActiveGameplayTags.AddTag(Tag);
+  ActiveTagMaskGeneration = 0;
+}
+
+void UWotActionComponent::RemoveGameplayTag(const FGameplayTag& Tag)
+{
+  ActiveGameplayTags.RemoveTag(Tag);
+  ActiveTagMaskGeneration = 0;
+}
+
+const FWotGameplayTagMask& UWotActionComponent::GetActiveTagMask() const
+{
+  // also rebuilt when requirements registered new tag bits
+  const uint32 Generation = FWotGameplayTagMask::GetGeneration();
+  if (ActiveTagMaskGeneration != Generation) {
+    ActiveTagMask = FWotGameplayTagMask::MakeActive(ActiveGameplayTags);
+    ActiveTagMaskGeneration = Generation;
+  }
+  return ActiveTagMask;
+}
+
 UWotActionComponent* UWotActionComponent::GetActions(AActor* FromActor)
 {
-	if (FromActor) {
-		return Cast<UWotActionComponent>(FromActor->GetComponentByClass(UWotActionComponent::StaticClass()));
-	}
-	return nullptr;
+	return FWotComponentCache::Find<UWotActionComponent>(FromActor);
 }
@@ -2,10 +2,14 @@
 #include "GameFramework/Character.h"
 #include "NiagaraFunctionLibrary.h"
 #include "NiagaraComponent.h"
+#include "WotActorPoolSubsystem.h"
+#include "WotFXSubsystem.h"
 
 UWotAction_ProjectileAttack::UWotAction_ProjectileAttack()
 {
-  AttackAnimDelay = 0.2f;
+  // the casting animation plays during the windup
+  WindupDuration = 0.2f;
+  bAutoStop = true;
   HandSocketName = "Hand_R";
 }
 
@@ -25,20 +29,12 @@ void UWotAction_ProjectileAttack::Start_Implementation(AActor* Instigator)
 
   // We don't require a casting system, so don't ensure it
   if (CastingNiagaraSystem) {
-    auto CastingNiagaraComp = UNiagaraFunctionLibrary::SpawnSystemAttached(CastingNiagaraSystem,
-                                                                           Character->GetMesh(),
-                                                                           HandSocketName,
-                                                                           FVector(0.f),
-                                                                           FRotator(0.f),
-                                                                           EAttachLocation::Type::KeepRelativeOffset,
-                                                                           true);
+    UWotFXSubsystem::SpawnSystemAttached(CastingNiagaraSystem,
+                                         Character->GetMesh(),
+                                         HandSocketName,
+                                         FVector(0.f),
+                                         FRotator(0.f));
   }
-
-  // Start the timer for launching the projectile
-  FTimerHandle TimerHandle_AttackDelay;
-  FTimerDelegate Delegate;
-  Delegate.BindUFunction(this, "AttackDelay_TimerElapsed", Character);
-  GetWorld()->GetTimerManager().SetTimer(TimerHandle_AttackDelay, Delegate, AttackAnimDelay, false);
 }
 
 void UWotAction_ProjectileAttack::Stop_Implementation(AActor* Instigator)
@@ -46,8 +42,15 @@ void UWotAction_ProjectileAttack::Stop_Implementation(AActor* Instigator)
   Super::Stop_Implementation(Instigator);
 }
 
-void UWotAction_ProjectileAttack::AttackDelay_TimerElapsed(ACharacter* InstigatorCharacter)
+void UWotAction_ProjectileAttack::OnPhaseStarted_Implementation(AActor* Instigator, EWotActionPhase NewPhase)
 {
+  Super::OnPhaseStarted_Implementation(Instigator, NewPhase);
+
+  if (NewPhase != EWotActionPhase::Active) {
+    return;
+  }
+
+  ACharacter* InstigatorCharacter = Cast<ACharacter>(Instigator);
   if (!InstigatorCharacter) {
     UE_LOG(LogTemp, Warning, TEXT("Provided instigatorcharacter is null!"));
     return;
@@ -65,8 +68,6 @@ void UWotAction_ProjectileAttack::AttackDelay_TimerElapsed(ACharacter* Instigato
   SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
   // Set the instigator so the projectile doesn't interact / damage the owner pawn
   SpawnParams.Instigator = InstigatorCharacter;
-  GetWorld()->SpawnActor<AActor>(ProjectileClass, SpawnTM, SpawnParams);
-
-  // Now actually stop the action since we're done
-  Stop(InstigatorCharacter);
+  UWotActorPoolSubsystem::SpawnPooled(this, ProjectileClass, SpawnTM, SpawnParams);
+  // the action stops on its own once the (empty) active phase is over
 }
@@ -0,0 +1,154 @@
+#include "WotActorPoolSubsystem.h"
+#include "WotPoolableInterface.h"
+#include "WotInteractableGridSubsystem.h"
+#include "TimerManager.h"
+
+static TAutoConsoleVariable<bool> CVarActorPoolEnabled(TEXT("wot.ActorPool.Enabled"), true, TEXT("Reuse pooled actors instead of spawning / destroying them"), ECVF_Cheat);
+static TAutoConsoleVariable<int32> CVarActorPoolMaxFree(TEXT("wot.ActorPool.MaxFreePerClass"), 64, TEXT("Maximum number of free actors kept per class, extra released actors are destroyed"), ECVF_Cheat);
+
+UWotActorPoolSubsystem* UWotActorPoolSubsystem::Get(const UObject* WorldContextObject)
+{
+  if (!WorldContextObject) {
+    return nullptr;
+  }
+  UWorld* World = WorldContextObject->GetWorld();
+  return World ? World->GetSubsystem<UWotActorPoolSubsystem>() : nullptr;
+}
+
+AActor* UWotActorPoolSubsystem::SpawnPooled(const UObject* WorldContextObject, UClass* ActorClass, const FTransform& Transform, const FActorSpawnParameters& SpawnParams)
+{
+  if (UWotActorPoolSubsystem* Pool = Get(WorldContextObject)) {
+    return Pool->AcquireActor(ActorClass, Transform, SpawnParams);
+  }
+  UWorld* World = WorldContextObject ? WorldContextObject->GetWorld() : nullptr;
+  return World ? World->SpawnActor(ActorClass, &Transform, SpawnParams) : nullptr;
+}
+
+void UWotActorPoolSubsystem::ReleasePooled(AActor* Actor)
+{
+  if (!IsValid(Actor)) {
+    return;
+  }
+  if (UWotActorPoolSubsystem* Pool = Get(Actor)) {
+    Pool->ReleaseActor(Actor);
+  } else {
+    Actor->Destroy();
+  }
+}
+
+bool UWotActorPoolSubsystem::CanPool(const UClass* ActorClass) const
+{
+  return CVarActorPoolEnabled.GetValueOnGameThread() &&
+    ActorClass &&
+    ActorClass->ImplementsInterface(UWotPoolableInterface::StaticClass());
+}
+
+AActor* UWotActorPoolSubsystem::AcquireActor(UClass* ActorClass, const FTransform& Transform, const FActorSpawnParameters& SpawnParams)
+{
+  if (!ensure(ActorClass)) {
+    return nullptr;
+  }
+  UWorld* World = GetWorld();
+  if (!CanPool(ActorClass)) {
+    return World->SpawnActor(ActorClass, &Transform, SpawnParams);
+  }
+  if (FWotActorPool* Pool = Pools.Find(ActorClass)) {
+    while (Pool->FreeActors.Num() > 0) {
+      AActor* Actor = Pool->FreeActors.Pop(EAllowShrinking::No);
+      // something else may have destroyed it while it was in the pool
+      if (IsValid(Actor)) {
+        ActivateActor(Actor, Transform, SpawnParams);
+        IWotPoolableInterface::Execute_OnAcquiredFromPool(Actor);
+        return Actor;
+      }
+    }
+  }
+  AActor* Actor = World->SpawnActor(ActorClass, &Transform, SpawnParams);
+  if (Actor) {
+    ManagedActors.Add(Actor);
+  }
+  return Actor;
+}
+
+void UWotActorPoolSubsystem::ReleaseActor(AActor* Actor)
+{
+  if (!IsValid(Actor)) {
+    return;
+  }
+  if (!ManagedActors.Contains(Actor) || !CanPool(Actor->GetClass())) {
+    ManagedActors.Remove(Actor);
+    Actor->Destroy();
+    return;
+  }
+  FWotActorPool& Pool = Pools.FindOrAdd(Actor->GetClass());
+  if (Pool.FreeActors.Contains(Actor)) {
+    UE_LOG(LogTemp, Warning, TEXT("ActorPool: %s released twice!"), *GetNameSafe(Actor));
+    return;
+  }
+  if (Pool.FreeActors.Num() >= CVarActorPoolMaxFree.GetValueOnGameThread()) {
+    ManagedActors.Remove(Actor);
+    Actor->Destroy();
+    return;
+  }
+  IWotPoolableInterface::Execute_OnReleasedToPool(Actor);
+  DeactivateActor(Actor);
+  Pool.FreeActors.Push(Actor);
+}
+
+void UWotActorPoolSubsystem::Prewarm(TSubclassOf<AActor> ActorClass, int32 Count)
+{
+  if (!CanPool(ActorClass)) {
+    UE_LOG(LogTemp, Warning, TEXT("ActorPool: cannot prewarm %s, it does not implement IWotPoolableInterface"), *GetNameSafe(ActorClass));
+    return;
+  }
+  FActorSpawnParameters SpawnParams;
+  SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+  const int32 NumToSpawn = Count - GetNumFree(ActorClass);
+  for (int32 i = 0; i < NumToSpawn; i++) {
+    AActor* Actor = GetWorld()->SpawnActor(ActorClass, &FTransform::Identity, SpawnParams);
+    if (Actor) {
+      ManagedActors.Add(Actor);
+      ReleaseActor(Actor);
+    }
+  }
+}
+
+int32 UWotActorPoolSubsystem::GetNumFree(TSubclassOf<AActor> ActorClass) const
+{
+  const FWotActorPool* Pool = Pools.Find(ActorClass.Get());
+  return Pool ? Pool->FreeActors.Num() : 0;
+}
+
+void UWotActorPoolSubsystem::ActivateActor(AActor* Actor, const FTransform& Transform, const FActorSpawnParameters& SpawnParams)
+{
+  const AActor* Defaults = Actor->GetClass()->GetDefaultObject<AActor>();
+  Actor->SetOwner(SpawnParams.Owner);
+  Actor->SetInstigator(SpawnParams.Instigator);
+  Actor->SetActorTransform(Transform, false, nullptr, ETeleportType::ResetPhysics);
+  // restore to how a freshly spawned actor would be
+  Actor->SetActorHiddenInGame(Defaults->IsHidden());
+  Actor->SetActorEnableCollision(Defaults->GetActorEnableCollision());
+  Actor->SetActorTickEnabled(Actor->PrimaryActorTick.bStartWithTickEnabled);
+  for (UActorComponent* Component : Actor->GetComponents()) {
+    Component->SetComponentTickEnabled(Component->PrimaryComponentTick.bStartWithTickEnabled);
+  }
+  // it may come back with other bounds than when it was registered
+  if (UWotInteractableGridSubsystem* Grid = UWotInteractableGridSubsystem::Get(Actor)) {
+    Grid->RefreshBounds(Actor);
+  }
+}
+
+void UWotActorPoolSubsystem::DeactivateActor(AActor* Actor)
+{
+  Actor->DetachFromActor(FDetachmentTransformRules::KeepWorldTransform);
+  Actor->SetActorHiddenInGame(true);
+  Actor->SetActorEnableCollision(false);
+  Actor->SetActorTickEnabled(false);
+  // components tick on their own, e.g. movement
+  for (UActorComponent* Component : Actor->GetComponents()) {
+    Component->SetComponentTickEnabled(false);
+  }
+  // also clears any pending lifespan
+  Actor->SetLifeSpan(0.0f);
+  GetWorld()->GetTimerManager().ClearAllTimersForObject(Actor);
+}
@@ -3,6 +3,7 @@
 #include "WotAttributeComponent.h"
 #include "Items/WotItem.h"
 #include "Items/WotItemInteractableActor.h"
+#include "Items/WotStuckItemsComponent.h"
 #include "Camera/CameraShakeBase.h"
 #include "Components/AudioComponent.h"
 #include "Components/SphereComponent.h"
@@ -10,6 +11,9 @@
 #include "GameFramework/ProjectileMovementComponent.h"
 #include "Kismet/GameplayStatics.h"
 #include "WotGameplayFunctionLibrary.h"
+#include "WotActorPoolSubsystem.h"
+#include "WotSoundSubsystem.h"
+#include "Wildlife/WotWildlifeSubsystem.h"
 #include "NiagaraFunctionLibrary.h"
 #include "NiagaraComponent.h"
 #include "Math/UnrealMathUtility.h"
@@ -39,6 +43,19 @@ void AWotArrowProjectile::PostInitializeComponents()
   SphereComp->OnComponentHit.AddDynamic(this, &AWotArrowProjectile::OnComponentHit);
 }
 
+void AWotArrowProjectile::OnAcquiredFromPool_Implementation()
+{
+  Super::OnAcquiredFromPool_Implementation();
+  // same as a newly spawned arrow: no collision, movement or audio until fired
+  EndManagedFlight();
+  SphereComp->SetCollisionProfileName("NoCollision");
+  MovementComp->Deactivate();
+  EffectAudioComp->Stop();
+  Shooter = nullptr;
+  BowCharge = 0.0f;
+  CurrentState = EWotArrowState::Default;
+}
+
 void AWotArrowProjectile::Fire(AActor* NewShooter, float NewBowCharge)
 {
   Shooter = NewShooter;
@@ -81,6 +98,7 @@ void AWotArrowProjectile::OnStateBegin(EWotArrowState BeginArrowState)
         float Velocity = FMath::Lerp(MinVelocity, MaxVelocity, BowCharge);
         MovementComp->Velocity = ForwardVector * Velocity;
         MovementComp->Activate();
+        BeginManagedFlight();
       }
       break;
     }
@@ -110,6 +128,7 @@ void AWotArrowProjectile::OnStateEnd(EWotArrowState EndArrowState)
     case EWotArrowState::InAir: {
       UE_LOG(LogTemp, Log, TEXT("On State End: InAir"));
       MovementComp->Deactivate();
+      EndManagedFlight();
       break;
     }
     case EWotArrowState::Unobtained: {
@@ -143,6 +162,8 @@ void AWotArrowProjectile::HandleCollision(AActor* OtherActor, const FHitResult&
     UE_LOG(LogTemp, Log, TEXT("HandleCollision: !OtherActor"));
     return;
   }
+  // hitting a wildlife animal hits the character it is promoted to
+  OtherActor = UWotWildlifeSubsystem::ResolveHitActor(OtherActor, SweepResult);
   // TODO: this is a hack to ignore overlap with the fluid flux surfaces /
   // actors!
   if (GetNameSafe(OtherActor).Contains("flux")) {
@@ -183,38 +204,47 @@ void AWotArrowProjectile::HandleCollision(AActor* OtherActor, const FHitResult&
   FVector CurrentLocation = GetActorLocation();
   FRotator CurrentRotation = GetActorRotation();
   // play impact sound
-  UGameplayStatics::PlaySoundAtLocation(this, ImpactSound, CurrentLocation, 1.0f, 1.0f, 0.0f);
+  UWotSoundSubsystem::PlaySoundAtLocation(this, ImpactSound, CurrentLocation, EWotSoundCategory::Impact);
   // set the location
   FVector NewLocation = CurrentLocation + GetActorForwardVector() * PenetrationDepth;
   SetActorLocation(NewLocation, false, nullptr, ETeleportType::ResetPhysics);
-  // Create WotItemInteractableActor (Actor in world)
-  FActorSpawnParameters SpawnParams;
-  SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
-  // Spawn one actor for each item dropped
-  UE_LOG(LogTemp, Log, TEXT("Spawning New ItemInteractable for arrow!"));
-  AWotItemInteractableActor* NewItemInteractable =
-    GetWorld()->SpawnActor<AWotItemInteractableActor>(AWotItemInteractableActor::StaticClass(),
-                                                      NewLocation,
-                                                      CurrentRotation,
-                                                      SpawnParams);
-  // and create WotItem (for collecting into inventory)
-  UE_LOG(LogTemp, Log, TEXT("Creating New Item!"));
-  UWotItem* NewItem = NewObject<UWotItem>(NewItemInteractable, ItemClass);
-  NewItem->OwningInventory = nullptr;
-  NewItem->Count = 1;
-  NewItem->World = GetWorld();
-  NewItemInteractable->SetPhysicsAndCollision("Projectile", false, true);
-  NewItemInteractable->SetItem(NewItem);
-  // attach new item interactible to other (collided) actor
-  FAttachmentTransformRules AttachmentRules(EAttachmentRule::KeepWorld,
-                                            EAttachmentRule::KeepWorld,
-                                            EAttachmentRule::KeepWorld,
-                                            true);
-  NewItemInteractable->AttachToActor(OtherActor, AttachmentRules, FName());
+  // Stick an instance of the item into what we hit; only fall back to a
+  // separate interactable actor if that isn't possible
+  const bool bStuck = UWotStuckItemsComponent::AddStuckItem(OtherActor,
+                                                            SweepResult.GetComponent(),
+                                                            SweepResult.BoneName,
+                                                            ItemClass,
+                                                            FTransform(CurrentRotation, NewLocation));
+  if (!bStuck) {
+    // Create WotItemInteractableActor (Actor in world)
+    FActorSpawnParameters SpawnParams;
+    SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+    // Spawn one actor for each item dropped
+    UE_LOG(LogTemp, Log, TEXT("Spawning New ItemInteractable for arrow!"));
+    AWotItemInteractableActor* NewItemInteractable =
+      UWotActorPoolSubsystem::SpawnPooled<AWotItemInteractableActor>(this,
+                                                                     AWotItemInteractableActor::StaticClass(),
+                                                                     FTransform(CurrentRotation, NewLocation),
+                                                                     SpawnParams);
+    // and create WotItem (for collecting into inventory)
+    UE_LOG(LogTemp, Log, TEXT("Creating New Item!"));
+    UWotItem* NewItem = NewObject<UWotItem>(NewItemInteractable, ItemClass);
+    NewItem->OwningInventory = nullptr;
+    NewItem->Count = 1;
+    NewItem->World = GetWorld();
+    NewItemInteractable->SetPhysicsAndCollision("Projectile", false, true);
+    NewItemInteractable->SetItem(NewItem);
+    // attach new item interactible to other (collided) actor
+    FAttachmentTransformRules AttachmentRules(EAttachmentRule::KeepWorld,
+                                              EAttachmentRule::KeepWorld,
+                                              EAttachmentRule::KeepWorld,
+                                              true);
+    NewItemInteractable->AttachToActor(OtherActor, AttachmentRules, FName());
+  }
   // if the actor is damage-able, then damage them
   UWotGameplayFunctionLibrary::ApplyDamage(Shooter, OtherActor, Damage + Damage * BowCharge);
   // Destroy this actor since we've now created the interactible item for it
-  Destroy();
+  UWotActorPoolSubsystem::ReleasePooled(this);
 }
 
 // _Implementation from it being marked as BlueprintNativeEvent
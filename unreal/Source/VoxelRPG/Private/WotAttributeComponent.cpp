@@ -1,6 +1,8 @@
 // Fill out your copyright notice in the Description page of Project Settings.
 #include "WotAttributeComponent.h"
+#include "WotComponentHost.h"
 #include "WotGameModeBase.h"
+#include "WotDamageSubsystem.h"
 
 #include <algorithm>
 
@@ -15,9 +17,26 @@ UWotAttributeComponent::UWotAttributeComponent()
 	Magic = MagicMax;
 }
 
+void UWotAttributeComponent::ResetAttributes()
+{
+	Health = GetHealthMax();
+	Stamina = GetStaminaMax();
+	Magic = GetMagicMax();
+	StaminaUpdateTime = GetTimeSeconds();
+	MagicUpdateTime = StaminaUpdateTime;
+	bIsStunned = false;
+	UWotTimingWheelSubsystem::ClearTimer(this, TimerHandle_Stunned);
+}
+
+void UWotAttributeComponent::RestoreHealth(float NewHealth)
+{
+	Health = std::clamp(NewHealth, 0.0f, GetHealthMax());
+}
+
 bool UWotAttributeComponent::Kill(AActor* InstigatorActor)
 {
-	return ApplyHealthChangeInstigator(InstigatorActor, -GetHealthMax());
+	// a kill always takes all health, defense doesn't apply
+	return ApplyUnmitigatedHealthChange(InstigatorActor, -GetHealthMax());
 }
 
 float UWotAttributeComponent::GetHealth() const
@@ -27,7 +46,7 @@ float UWotAttributeComponent::GetHealth() const
 
 float UWotAttributeComponent::GetHealthMax() const
 {
-	return HealthMax;
+	return GetAttributeValue(EWotAttribute::HealthMax);
 }
 
 bool UWotAttributeComponent::IsAlive() const
@@ -42,17 +61,204 @@ bool UWotAttributeComponent::IsStunned() const
 
 bool UWotAttributeComponent::IsFullHealth() const
 {
-	return Health == HealthMax;
+	return Health == GetHealthMax();
 }
 
 float UWotAttributeComponent::GetMagic() const
 {
-	return Magic;
+	const float Elapsed = (float)(GetTimeSeconds() - MagicUpdateTime);
+	return std::clamp(Magic + MagicRegenRate * Elapsed, 0.0f, GetMagicMax());
+}
+
+float UWotAttributeComponent::GetStamina() const
+{
+	// the rate only changes through UpdateStamina, so the value is linear
+	// (then clamped) since the last update
+	const float Elapsed = (float)(GetTimeSeconds() - StaminaUpdateTime);
+	return std::clamp(Stamina + GetStaminaRate() * Elapsed, 0.0f, GetStaminaMax());
+}
+
+float UWotAttributeComponent::GetStaminaRate() const
+{
+	return StaminaRegenRate - StaminaDrainRate;
+}
+
+float UWotAttributeComponent::GetSecondsUntilStaminaDepleted() const
+{
+	const float Rate = GetStaminaRate();
+	if (Rate >= 0.0f) {
+		return -1.0f;
+	}
+	return GetStamina() / -Rate;
+}
+
+double UWotAttributeComponent::GetTimeSeconds() const
+{
+	const UWorld* World = GetWorld();
+	return World ? World->GetTimeSeconds() : 0.0;
+}
+
+void UWotAttributeComponent::UpdateStamina()
+{
+	Stamina = GetStamina();
+	StaminaUpdateTime = GetTimeSeconds();
+}
+
+void UWotAttributeComponent::UpdateMagic()
+{
+	Magic = GetMagic();
+	MagicUpdateTime = GetTimeSeconds();
+}
+
+bool UWotAttributeComponent::ApplyStaminaChange(float Delta)
+{
+	UpdateStamina();
+	const auto PriorStamina = Stamina;
+	Stamina = std::clamp(Stamina+Delta, 0.0f, GetStaminaMax());
+	return Stamina != PriorStamina;
+}
+
+void UWotAttributeComponent::AddStaminaDrain(float PerSecond)
+{
+	UpdateStamina();
+	StaminaDrainRate += PerSecond;
+}
+
+void UWotAttributeComponent::RemoveStaminaDrain(float PerSecond)
+{
+	UpdateStamina();
+	StaminaDrainRate = FMath::Max(StaminaDrainRate - PerSecond, 0.0f);
 }
 
 float UWotAttributeComponent::GetMagicMax() const
 {
-	return MagicMax;
+	return GetAttributeValue(EWotAttribute::MagicMax);
+}
+
+float UWotAttributeComponent::GetStaminaMax() const
+{
+	return GetAttributeValue(EWotAttribute::StaminaMax);
+}
+
+float UWotAttributeComponent::GetStrengthMax() const
+{
+	return GetAttributeValue(EWotAttribute::StrengthMax);
+}
+
+float UWotAttributeComponent::GetDefense() const
+{
+	return GetAttributeValue(EWotAttribute::Defense);
+}
+
+float UWotAttributeComponent::GetBaseValue(EWotAttribute Attribute) const
+{
+	switch (Attribute) {
+		case EWotAttribute::HealthMax:
+			return HealthMax;
+		case EWotAttribute::StaminaMax:
+			return StaminaMax;
+		case EWotAttribute::StrengthMax:
+			return StrengthMax;
+		case EWotAttribute::MagicMax:
+			return MagicMax;
+		case EWotAttribute::Defense:
+			return Defense;
+		default:
+			return 0.0f;
+	}
+}
+
+float UWotAttributeComponent::GetAttributeValue(EWotAttribute Attribute) const
+{
+	const int32 Index = (int32)Attribute;
+	if (!ensure(Index >= 0 && Index < (int32)EWotAttribute::MAX)) {
+		return 0.0f;
+	}
+	// base values can still be edited directly (e.g. from blueprints), so a
+	// changed base also counts as dirty
+	const float BaseValue = GetBaseValue(Attribute);
+	if ((DirtyAttributes & (1u << Index)) || CachedBaseValues[Index] != BaseValue) {
+		float Added = 0.0f;
+		float Multiplier = 1.0f;
+		bool bOverridden = false;
+		float OverrideValue = 0.0f;
+		for (const FWotAttributeModifier& Modifier : Modifiers) {
+			if (Modifier.Attribute != Attribute) {
+				continue;
+			}
+			switch (Modifier.Op) {
+				case EWotModifierOp::Add:
+					Added += Modifier.Value;
+					break;
+				case EWotModifierOp::Multiply:
+					Multiplier *= Modifier.Value;
+					break;
+				case EWotModifierOp::Override:
+					bOverridden = true;
+					OverrideValue = Modifier.Value;
+					break;
+			}
+		}
+		CachedValues[Index] = bOverridden ? OverrideValue : (BaseValue + Added) * Multiplier;
+		CachedBaseValues[Index] = BaseValue;
+		DirtyAttributes &= ~(1u << Index);
+	}
+	return CachedValues[Index];
+}
+
+void UWotAttributeComponent::AddModifier(EWotAttribute Attribute, EWotModifierOp Op, float Value, UObject* Source)
+{
+	if (!ensure(Attribute != EWotAttribute::MAX)) {
+		return;
+	}
+	FWotAttributeModifier& Modifier = Modifiers.AddDefaulted_GetRef();
+	Modifier.Attribute = Attribute;
+	Modifier.Op = Op;
+	Modifier.Value = Value;
+	Modifier.Source = Source;
+	MarkAttributeDirty(Attribute);
+}
+
+int32 UWotAttributeComponent::RemoveModifiersFromSource(UObject* Source)
+{
+	uint32 RemovedAttributes = 0;
+	// keeps the order, the latest override has to stay the latest
+	const int32 NumRemoved = Modifiers.RemoveAll([Source, &RemovedAttributes](const FWotAttributeModifier& Modifier) {
+		if (Modifier.Source.Get() != Source) {
+			return false;
+		}
+		RemovedAttributes |= 1u << (int32)Modifier.Attribute;
+		return true;
+	});
+	for (int32 Index = 0; Index < (int32)EWotAttribute::MAX; Index++) {
+		if (RemovedAttributes & (1u << Index)) {
+			MarkAttributeDirty((EWotAttribute)Index);
+		}
+	}
+	return NumRemoved;
+}
+
+void UWotAttributeComponent::MarkAttributeDirty(EWotAttribute Attribute)
+{
+	// regeneration up to now counts against the old max
+	if (Attribute == EWotAttribute::StaminaMax) {
+		UpdateStamina();
+	} else if (Attribute == EWotAttribute::MagicMax) {
+		UpdateMagic();
+	}
+	DirtyAttributes |= 1u << (int32)Attribute;
+	// a lowered max pulls the current value down with it
+	if (Attribute == EWotAttribute::HealthMax) {
+		// like any other health change, a max of 0 kills; the owner counts
+		// as the instigator since whatever lowered the max isn't known here
+		if (Health > GetHealthMax()) {
+			SetHealth(GetOwner(), GetHealthMax());
+		}
+	} else if (Attribute == EWotAttribute::StaminaMax) {
+		Stamina = FMath::Min(Stamina, GetStaminaMax());
+	} else if (Attribute == EWotAttribute::MagicMax) {
+		Magic = FMath::Min(Magic, GetMagicMax());
+	}
 }
 
 bool UWotAttributeComponent::ApplyHealthChange(float Delta)
@@ -61,6 +267,14 @@ bool UWotAttributeComponent::ApplyHealthChange(float Delta)
 }
 
 bool UWotAttributeComponent::ApplyHealthChangeInstigator(AActor* InstigatorActor, float Delta)
+{
+	if (Delta < 0.0f) {
+		Delta *= DefenseForHalfDamage / (DefenseForHalfDamage + FMath::Max(GetDefense(), 0.0f));
+	}
+	return ApplyUnmitigatedHealthChange(InstigatorActor, Delta);
+}
+
+bool UWotAttributeComponent::ApplyUnmitigatedHealthChange(AActor* InstigatorActor, float Delta)
 {
 	if (!GetOwner()->CanBeDamaged() && Delta < 0.0f) {
 		UE_LOG(LogTemp, Warning, TEXT("Owner cannot be damaged, not applying damage"));
@@ -70,44 +284,77 @@ bool UWotAttributeComponent::ApplyHealthChangeInstigator(AActor* InstigatorActor
 	if (bIsStunned && Delta < 0.0f) {
 		return false;
 	}
+	return ChangeHealth(InstigatorActor, Delta, true);
+}
+
+bool UWotAttributeComponent::ApplyPeriodicHealthChange(AActor* InstigatorActor, float Delta)
+{
+	if (!GetOwner()->CanBeDamaged() && Delta < 0.0f) {
+		return false;
+	}
+	return ChangeHealth(InstigatorActor, Delta, false);
+}
 
+bool UWotAttributeComponent::ChangeHealth(AActor* InstigatorActor, float Delta, bool bUpdateStun)
+{
 	if (Delta < 0.0f) {
 		float DamageMultiplier = CVarDamageMultiplier.GetValueOnGameThread();
 		Delta *= DamageMultiplier;
 	}
 
-	const auto PriorHealth = Health;
-	Health = std::clamp(Health+Delta, 0.0f, HealthMax);
-	const auto ActualDelta = Health - PriorHealth;
-	if (ActualDelta != 0) {
-		OnHealthChanged.Broadcast(InstigatorActor, this, Health, ActualDelta);
-		if (Health <= 0.0f) {
-			// Health drops to or below 0, trigger kill event
-			OnKilled.Broadcast(InstigatorActor, this);
-			AWotGameModeBase* GM = GetWorld()->GetAuthGameMode<AWotGameModeBase>();
-			if (GM) {
-				GM->OnActorKilled(GetOwner(), InstigatorActor);
-			}
-		}
+	const auto ActualDelta = SetHealth(InstigatorActor, Health+Delta);
+	if (!bUpdateStun) {
+		return ActualDelta != 0;
 	}
 	if (ActualDelta < 0.0f) {
 		// if we are being damaged, set stunned flag so we can't get damaged
 		// again too soon
 		bIsStunned = true;
 		// set the timer to reset stunned flag after the duration has elapsed
-		GetWorld()->GetTimerManager().SetTimer(TimerHandle_Stunned,
-											   this,
-											   &UWotAttributeComponent::Stunned_TimeElapsed,
-											   StunDuration);
+		UWotTimingWheelSubsystem::SetTimer(this, TimerHandle_Stunned, &UWotAttributeComponent::Stunned_TimeElapsed, StunDuration);
 	} else if (ActualDelta > 0.0f) {
 		// if we are being healed, reset the stunned flag
 		bIsStunned = false;
 		// and cancel the stunned timer
-		GetWorld()->GetTimerManager().ClearTimer(TimerHandle_Stunned);
+		UWotTimingWheelSubsystem::ClearTimer(this, TimerHandle_Stunned);
 	}
 	return ActualDelta != 0;
 }
 
+float UWotAttributeComponent::SetHealth(AActor* InstigatorActor, float NewHealth)
+{
+	const auto PriorHealth = Health;
+	Health = std::clamp(NewHealth, 0.0f, GetHealthMax());
+	const auto ActualDelta = Health - PriorHealth;
+	if (ActualDelta != 0) {
+		// coalesced into one event per victim per frame, see UWotDamageSubsystem
+		UWotDamageSubsystem* DamageSubsystem = UWotDamageSubsystem::GetIfEnabled(this);
+		if (DamageSubsystem) {
+			DamageSubsystem->QueueHealthChanged(this, InstigatorActor, ActualDelta);
+		} else {
+			BroadcastHealthChanged(InstigatorActor, ActualDelta);
+		}
+		if (Health <= 0.0f) {
+			// listeners get the health change before the kill
+			if (DamageSubsystem) {
+				DamageSubsystem->FlushVictim(this);
+			}
+			// Health drops to or below 0, trigger kill event
+			OnKilled.Broadcast(InstigatorActor, this);
+			AWotGameModeBase* GM = GetWorld()->GetAuthGameMode<AWotGameModeBase>();
+			if (GM) {
+				GM->OnActorKilled(GetOwner(), InstigatorActor);
+			}
+		}
+	}
+	return ActualDelta;
+}
+
+void UWotAttributeComponent::BroadcastHealthChanged(AActor* InstigatorActor, float Delta)
+{
+	OnHealthChanged.Broadcast(InstigatorActor, this, Health, Delta);
+}
+
 void UWotAttributeComponent::Stunned_TimeElapsed()
 {
 	bIsStunned = false;
@@ -120,18 +367,16 @@ bool UWotAttributeComponent::ApplyMagicChange(float Delta)
 
 bool UWotAttributeComponent::ApplyMagicChangeInstigator(AActor* InstigatorActor, float Delta)
 {
+	UpdateMagic();
 	const auto PriorMagic = Magic;
-	Magic = std::clamp(Magic+Delta, 0.0f, MagicMax);
+	Magic = std::clamp(Magic+Delta, 0.0f, GetMagicMax());
 	const auto ActualDelta = Magic - PriorMagic;
 	return ActualDelta != 0;
 }
 
 UWotAttributeComponent* UWotAttributeComponent::GetAttributes(AActor* FromActor)
 {
-	if (FromActor) {
-		return Cast<UWotAttributeComponent>(FromActor->GetComponentByClass(UWotAttributeComponent::StaticClass()));
-	}
-	return nullptr;
+	return FWotComponentCache::Find<UWotAttributeComponent>(FromActor);
 }
 
 bool UWotAttributeComponent::IsActorAlive(AActor* Actor)
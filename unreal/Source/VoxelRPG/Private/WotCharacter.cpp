@@ -16,6 +16,9 @@
 #include "Math/Color.h"
 #include "NiagaraFunctionLibrary.h"
 #include "NiagaraComponent.h"
+#include "WotFXSubsystem.h"
+#include "WotSoundSubsystem.h"
+#include "AI/WotPerceptionSubsystem.h"
 #include "Engine/EngineTypes.h"
 #include "Blueprint/UserWidget.h"
 #include "UI/WotUWInventoryPanel.h"
@@ -67,6 +70,7 @@ AWotCharacter::AWotCharacter()
 void AWotCharacter::PostInitializeComponents()
 {
 	Super::PostInitializeComponents();
+	ComponentCache.Fill(this);
 	AttributeComp->OnHealthChanged.AddDynamic(this, &AWotCharacter::OnHealthChanged);
 	AttributeComp->OnKilled.AddDynamic(this, &AWotCharacter::OnKilled);
 }
@@ -78,10 +82,23 @@ void AWotCharacter::BeginPlay()
 	bCanOpenMenu = true;
 	SetupSpringArm();
 	SetupCineCamera();
+	// let the bots see us
+	if (UWotPerceptionSubsystem* Perception = UWotPerceptionSubsystem::Get(this)) {
+		Perception->RegisterStimulus(this);
+	}
 	// start the interaction check timer
 	GetWorldTimerManager().SetTimer(TimerHandle_InteractionCheck, this, &AWotCharacter::InteractionCheck_TimeElapsed, InteractionCheckPeriod, true);
 }
 
+void AWotCharacter::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	// so the bots don't keep seeing a destroyed player
+	if (UWotPerceptionSubsystem* Perception = UWotPerceptionSubsystem::Get(this)) {
+		Perception->UnregisterStimulus(this);
+	}
+	Super::EndPlay(EndPlayReason);
+}
+
 void AWotCharacter::SetupSpringArm()
 {
 	// SpringArmComp->bUsePawnControlRotation = true;
@@ -277,8 +294,7 @@ void AWotCharacter::Landed(const FHitResult& Hit)
 	// spawn a particle effect when we land (if it has been set)
 	if (LandingEffect) {
 		// spawn it at the impact point
-		auto LandingSystemComp = UNiagaraFunctionLibrary::SpawnSystemAtLocation(this,
-			LandingEffect, Hit.ImpactPoint, FRotator::ZeroRotator);
+		UWotFXSubsystem::SpawnSystemAtLocation(this, LandingEffect, Hit.ImpactPoint, FRotator::ZeroRotator, EWotFXPriority::Low);
 	}
 }
 
@@ -349,7 +365,7 @@ void AWotCharacter::OnKilled(AActor* InstigatorActor, UWotAttributeComponent* Ow
 	// Drop all items the character is carrying
 	InventoryComp->DropAll();
 	// Then destroy after a delay
-	GetWorldTimerManager().SetTimer(TimerHandle_Destroy, this, &AWotCharacter::Destroy_TimeElapsed, KilledDestroyDelay);
+	UWotTimingWheelSubsystem::SetTimer(this, TimerHandle_Destroy, &AWotCharacter::Destroy_TimeElapsed, KilledDestroyDelay);
 }
 
 void AWotCharacter::ShowInventoryWidget()
@@ -364,8 +380,7 @@ void AWotCharacter::ShowInventoryWidget()
 
 void AWotCharacter::PlaySoundGet()
 {
-    EffectAudioComp->SetSound(GetSound);
-    EffectAudioComp->Play(0);
+    UWotSoundSubsystem::PlaySoundAttached(GetSound, EffectAudioComp, EWotSoundCategory::Pickup);
 }
 
 void AWotCharacter::RotateCamera()
@@ -474,11 +489,13 @@ void AWotCharacter::InteractionCheck_TimeElapsed()
 		return;
 	}
 	// use the interaction component to get the closest interactable
-	AActor *ClosestInteractable = nullptr;
-	UActorComponent *ClosestInteractionComp = nullptr;
-	FHitResult HitResult;
-	bool got_interactable = InteractionComp->GetInteractableInRange(ClosestInteractable, ClosestInteractionComp, HitResult);
-	if (!got_interactable) {
+	InteractionComp->RequestInteractableInRange(FWotInteractableResultDelegate::CreateUObject(this, &AWotCharacter::OnInteractableInRange));
+}
+
+void AWotCharacter::OnInteractableInRange(AActor* ClosestInteractable, UActorComponent* ClosestInteractionComp, const FHitResult& HitResult)
+{
+	// the sweep may have finished a frame after it was requested
+	if (bMenuActive || !IsValid(ClosestInteractable)) {
 		return;
 	}
 	FText InteractionText;
@@ -0,0 +1,63 @@
+#include "WotComponentHost.h"
+#include "WotActionComponent.h"
+#include "WotAttributeComponent.h"
+#include "WotEquipmentComponent.h"
+#include "WotInventoryComponent.h"
+#include "Engine/World.h"
+#include "EngineUtils.h"
+
+static FAutoConsoleCommandWithWorldAndArgs BenchComponentLookupCommand(
+  TEXT("wot.BenchComponentLookup"),
+  TEXT("Times looking up the gameplay components of every component host in the world, with a component scan and with the cache. Optional argument: number of iterations (default 10000)"),
+  FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World) {
+    const int32 Iterations = Args.Num() > 0 ? FMath::Max(FCString::Atoi(*Args[0]), 1) : 10000;
+    TArray<AActor*> Hosts;
+    for (AActor* Actor : TActorRange<AActor>(World)) {
+      if (Cast<IWotComponentHost>(Actor)) {
+        Hosts.Add(Actor);
+      }
+    }
+    if (Hosts.Num() == 0) {
+      UE_LOG(LogTemp, Warning, TEXT("wot.BenchComponentLookup: no component hosts in the world"));
+      return;
+    }
+    // count the found components so the lookups can't be optimized away
+    int32 NumFound = 0;
+    double StartTime = FPlatformTime::Seconds();
+    for (int32 Iteration = 0; Iteration < Iterations; Iteration++) {
+      for (AActor* Actor : Hosts) {
+        NumFound += Actor->FindComponentByClass<UWotAttributeComponent>() != nullptr;
+        NumFound += Actor->FindComponentByClass<UWotInventoryComponent>() != nullptr;
+        NumFound += Actor->FindComponentByClass<UWotEquipmentComponent>() != nullptr;
+        NumFound += Actor->FindComponentByClass<UWotActionComponent>() != nullptr;
+      }
+    }
+    const double ScanTime = FPlatformTime::Seconds() - StartTime;
+    StartTime = FPlatformTime::Seconds();
+    for (int32 Iteration = 0; Iteration < Iterations; Iteration++) {
+      for (AActor* Actor : Hosts) {
+        NumFound += UWotAttributeComponent::GetAttributes(Actor) != nullptr;
+        NumFound += UWotInventoryComponent::GetInventory(Actor) != nullptr;
+        NumFound += UWotEquipmentComponent::GetEquipment(Actor) != nullptr;
+        NumFound += UWotActionComponent::GetActions(Actor) != nullptr;
+      }
+    }
+    const double CacheTime = FPlatformTime::Seconds() - StartTime;
+    const int32 NumLookups = Iterations * Hosts.Num() * 4;
+    UE_LOG(LogTemp, Log, TEXT("wot.BenchComponentLookup: %d lookups on %d actors (%d found), scan %.2f ms (%.1f ns each), cache %.2f ms (%.1f ns each)"),
+           NumLookups, Hosts.Num(), NumFound,
+           ScanTime * 1000.0, ScanTime * 1e9 / NumLookups,
+           CacheTime * 1000.0, CacheTime * 1e9 / NumLookups);
+  }));
+
+void FWotComponentCache::Fill(AActor* Owner)
+{
+  if (!ensure(Owner)) {
+    return;
+  }
+  Attributes = Owner->FindComponentByClass<UWotAttributeComponent>();
+  Inventory = Owner->FindComponentByClass<UWotInventoryComponent>();
+  Equipment = Owner->FindComponentByClass<UWotEquipmentComponent>();
+  Actions = Owner->FindComponentByClass<UWotActionComponent>();
+  bFilled = true;
+}
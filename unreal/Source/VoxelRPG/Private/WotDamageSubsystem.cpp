@@ -0,0 +1,124 @@
+#include "WotDamageSubsystem.h"
+#include "WotAttributeComponent.h"
+#include "Engine/World.h"
+
+static TAutoConsoleVariable<bool> CVarDamageCoalesce(TEXT("wot.Damage.Coalesce"), true, TEXT("Broadcast one OnHealthChanged per victim per frame with the summed delta instead of one per health change"), ECVF_Cheat);
+
+static FAutoConsoleCommandWithWorld DamageStatsCommand(
+  TEXT("wot.Damage.Stats"),
+  TEXT("Logs the damage subsystem counters"),
+  FConsoleCommandWithWorldDelegate::CreateLambda([](UWorld* World) {
+    UWotDamageSubsystem* Damage = UWotDamageSubsystem::Get(World);
+    if (!Damage) {
+      return;
+    }
+    const FWotDamageCounters Counters = Damage->GetCounters();
+    UE_LOG(LogTemp, Log, TEXT("Damage: health changes %d, events broadcast %d, coalesced %d"),
+           Counters.HealthChanges, Counters.EventsBroadcast, Counters.Coalesced);
+  }));
+
+UWotDamageSubsystem* UWotDamageSubsystem::Get(const UObject* WorldContextObject)
+{
+  if (!WorldContextObject) {
+    return nullptr;
+  }
+  UWorld* World = WorldContextObject->GetWorld();
+  return World ? World->GetSubsystem<UWotDamageSubsystem>() : nullptr;
+}
+
+UWotDamageSubsystem* UWotDamageSubsystem::GetIfEnabled(const UObject* WorldContextObject)
+{
+  return CVarDamageCoalesce.GetValueOnGameThread() ? Get(WorldContextObject) : nullptr;
+}
+
+void UWotDamageSubsystem::QueueHealthChanged(UWotAttributeComponent* Victim, AActor* InstigatorActor, float Delta)
+{
+  if (!ensure(Victim)) {
+    return;
+  }
+  Counters.HealthChanges++;
+  if (const int32* Index = PendingIndices.Find(Victim)) {
+    FPendingHealthChange& Change = Pending[*Index];
+    Change.Delta += Delta;
+    if (InstigatorActor) {
+      Change.InstigatorActor = InstigatorActor;
+    }
+    Counters.Coalesced++;
+    return;
+  }
+  PendingIndices.Add(Victim, Pending.Add({Victim, InstigatorActor, Delta}));
+}
+
+void UWotDamageSubsystem::FlushVictim(UWotAttributeComponent* Victim)
+{
+  // a kill raised by a listener during a flush comes before the rest of
+  // that flush, so the victim's event may still be waiting in it
+  for (int32 Index = FlushPosition + 1; Index < Flushing.Num(); Index++) {
+    if (Flushing[Index].Victim.Get() == Victim) {
+      const FPendingHealthChange Change = Flushing[Index];
+      Flushing[Index].Victim.Reset();
+      Broadcast(Change);
+      break;
+    }
+  }
+  const int32* Index = PendingIndices.Find(Victim);
+  if (!Index) {
+    return;
+  }
+  const FPendingHealthChange Change = Pending[*Index];
+  const int32 RemovedIndex = *Index;
+  PendingIndices.Remove(Victim);
+  Pending.RemoveAtSwap(RemovedIndex, 1, EAllowShrinking::No);
+  // fix up the index of the change that was swapped into the hole
+  if (Pending.IsValidIndex(RemovedIndex)) {
+    PendingIndices.Add(Pending[RemovedIndex].Victim.Get(), RemovedIndex);
+  }
+  Broadcast(Change);
+}
+
+void UWotDamageSubsystem::Flush()
+{
+  Flushing.Reset();
+  Swap(Pending, Flushing);
+  PendingIndices.Reset();
+  // listeners queue into Pending, so Flushing doesn't move under us
+  for (FlushPosition = 0; FlushPosition < Flushing.Num(); FlushPosition++) {
+    Broadcast(Flushing[FlushPosition]);
+  }
+  FlushPosition = INDEX_NONE;
+  Flushing.Reset();
+}
+
+void UWotDamageSubsystem::Broadcast(const FPendingHealthChange& Change)
+{
+  UWotAttributeComponent* Victim = Change.Victim.Get();
+  // damage and healing in the same frame can cancel out
+  if (!Victim || Change.Delta == 0.0f) {
+    return;
+  }
+  Counters.EventsBroadcast++;
+  Victim->BroadcastHealthChanged(Change.InstigatorActor.Get(), Change.Delta);
+}
+
+void UWotDamageSubsystem::ResetCounters()
+{
+  Counters = FWotDamageCounters();
+}
+
+void UWotDamageSubsystem::Deinitialize()
+{
+  Pending.Empty();
+  Flushing.Empty();
+  PendingIndices.Empty();
+  Super::Deinitialize();
+}
+
+TStatId UWotDamageSubsystem::GetStatId() const
+{
+  RETURN_QUICK_DECLARE_CYCLE_STAT(UWotDamageSubsystem, STATGROUP_Tickables);
+}
+
+void UWotDamageSubsystem::Tick(float DeltaTime)
+{
+  Flush();
+}
@@ -6,6 +6,8 @@
 #include "Kismet/GameplayStatics.h"
 #include "NiagaraFunctionLibrary.h"
 #include "NiagaraComponent.h"
+#include "WotFXSubsystem.h"
+#include "WotSoundSubsystem.h"
 #include "Components/SkeletalMeshComponent.h"
 #include "Engine/Texture.h"
 #include "RHIDefinitions.h"
@@ -55,13 +57,19 @@ void UWotDeathEffectComponent::Play()
 	  return;
   }
   // Now actually make the effect
-  auto EffectNiagaraComp = UNiagaraFunctionLibrary::SpawnSystemAttached(EffectNiagaraSystem,
-																		CharacterMesh,
-																		NAME_None,
-																		FVector(0.f),
-																		FRotator(0.f),
-																		EAttachLocation::Type::KeepRelativeOffset,
-																		true);
+  auto EffectNiagaraComp = UWotFXSubsystem::SpawnSystemAttached(EffectNiagaraSystem,
+																 CharacterMesh,
+																 NAME_None,
+																 FVector(0.f),
+																 FRotator(0.f),
+																 EWotFXPriority::Normal);
+  if (!EffectNiagaraComp) {
+	  // culled; the mesh is still hidden by the owner so just play the sound
+	  if (EffectSound) {
+		  UWotSoundSubsystem::PlaySoundAtLocation(this, EffectSound, Character->GetActorLocation(), EWotSoundCategory::Death);
+	  }
+	  return;
+  }
   // create dynamic material instance for the mesh
   UMaterialInstanceDynamic* EffectMaterial = UMaterialInstanceDynamic::Create(EffectMaterialBase, this);
   // set the texture for the new material
@@ -69,6 +77,6 @@ void UWotDeathEffectComponent::Play()
   // Set the material for the meshes (cubes) in the niagara effect
   EffectNiagaraComp->SetVariableMaterial("Material", EffectMaterial);
   if (EffectSound) {
-	  UGameplayStatics::PlaySoundAtLocation(this, EffectSound, Character->GetActorLocation(), 1.0f, 1.0f, 0.0f);
+	  UWotSoundSubsystem::PlaySoundAtLocation(this, EffectSound, Character->GetActorLocation(), EWotSoundCategory::Death);
   }
 }
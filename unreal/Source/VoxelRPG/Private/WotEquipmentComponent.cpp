@@ -1,6 +1,8 @@
 // Fill out your copyright notice in the Description page of Project Settings.
 
 #include "WotEquipmentComponent.h"
+#include "WotComponentHost.h"
+#include "WotAttributeComponent.h"
 #include "Components/StaticMeshComponent.h"
 #include "WotInventoryComponent.h"
 #include "Items/WotItemEquipment.h"
@@ -87,6 +89,10 @@ void UWotEquipmentComponent::EquipArmor(UWotItemArmor* NewItemArmor) {
   }
   // Update the ArmorItems map
   ArmorItems.Add(SocketName, NewItemArmor);
+  // the armor adds to the owner's defense until unequipped
+  if (UWotAttributeComponent* AttributeComp = UWotAttributeComponent::GetAttributes(GetOwner())) {
+    AttributeComp->AddModifier(EWotAttribute::Defense, EWotModifierOp::Add, NewItemArmor->ArmorAmount, NewItemArmor);
+  }
   // Let the item know it's equipped and have it update rendering accordingly
   NewItemArmor->Equip(Cast<ACharacter>(GetOwner()));
 }
@@ -110,10 +116,14 @@ void UWotEquipmentComponent::EquipWeapon(UWotItemWeapon* NewItemWeapon) {
 }
 
 void UWotEquipmentComponent::UnequipAll() {
+  UWotAttributeComponent* AttributeComp = UWotAttributeComponent::GetAttributes(GetOwner());
   for (auto& Elem : ArmorItems) {
     auto ArmorItem = Elem.Value;
     if (ArmorItem) {
       ArmorItem->Unequip(Cast<ACharacter>(GetOwner()));
+      if (AttributeComp) {
+        AttributeComp->RemoveModifiersFromSource(ArmorItem);
+      }
     }
   }
   for (auto& Elem : WeaponItems) {
@@ -124,6 +134,25 @@ void UWotEquipmentComponent::UnequipAll() {
   }
 }
 
+void UWotEquipmentComponent::ReequipAll() {
+  TArray<UWotItemArmor*> Armor;
+  ArmorItems.GenerateValueArray(Armor);
+  TArray<UWotItemWeapon*> Weapons;
+  WeaponItems.GenerateValueArray(Weapons);
+  for (UWotItemArmor* ArmorItem : Armor) {
+    if (ArmorItem) {
+      UnequipArmor(ArmorItem);
+      EquipArmor(ArmorItem);
+    }
+  }
+  for (UWotItemWeapon* WeaponItem : Weapons) {
+    if (WeaponItem) {
+      UnequipWeapon(WeaponItem);
+      EquipWeapon(WeaponItem);
+    }
+  }
+}
+
 void UWotEquipmentComponent::UnequipArmor(UWotItemArmor* NewItemArmor) {
   FName SocketName = NewItemArmor->EquipSocketName;
   if (!ArmorSocketNames.Contains(SocketName)) {
@@ -132,6 +161,9 @@ void UWotEquipmentComponent::UnequipArmor(UWotItemArmor* NewItemArmor) {
   }
   // Let the item know it's unequipped and update rendering accordingly
   NewItemArmor->Unequip(Cast<ACharacter>(GetOwner()));
+  if (UWotAttributeComponent* AttributeComp = UWotAttributeComponent::GetAttributes(GetOwner())) {
+    AttributeComp->RemoveModifiersFromSource(NewItemArmor);
+  }
   // remove the item from the map
   ArmorItems.Remove(SocketName);
 }
@@ -160,10 +192,7 @@ UWotItemWeapon* UWotEquipmentComponent::GetEquippedWeapon()
 
 UWotEquipmentComponent* UWotEquipmentComponent::GetEquipment(AActor* FromActor)
 {
-  if (FromActor) {
-    return Cast<UWotEquipmentComponent>(FromActor->GetComponentByClass(UWotEquipmentComponent::StaticClass()));
-  }
-  return nullptr;
+  return FWotComponentCache::Find<UWotEquipmentComponent>(FromActor);
 }
 
 UWotItemWeapon* UWotEquipmentComponent::GetEquippedWeaponFromActor(AActor* FromActor)
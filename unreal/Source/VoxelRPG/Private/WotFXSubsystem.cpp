@@ -0,0 +1,155 @@
+#include "WotFXSubsystem.h"
+#include "Engine/World.h"
+#include "Engine/Engine.h"
+#include "GameFramework/PlayerController.h"
+#include "NiagaraComponent.h"
+#include "NiagaraFunctionLibrary.h"
+#include "NiagaraSystem.h"
+
+static TAutoConsoleVariable<int32> CVarFXMaxSpawnsPerFrame(TEXT("wot.FX.MaxSpawnsPerFrame"), 16, TEXT("Maximum number of non-critical effects spawned per frame (0 = no limit)"), ECVF_Cheat);
+static TAutoConsoleVariable<float> CVarFXCullDistance(TEXT("wot.FX.CullDistance"), 6000.0f, TEXT("Non-critical effects further than this from every player are not spawned, low priority ones use half (0 = never cull)"), ECVF_Cheat);
+static TAutoConsoleVariable<float> CVarFXDedupeRadius(TEXT("wot.FX.DedupeRadius"), 50.0f, TEXT("An effect is skipped if the same system was spawned within this distance during the dedupe window (0 = off)"), ECVF_Cheat);
+static TAutoConsoleVariable<float> CVarFXDedupeWindow(TEXT("wot.FX.DedupeWindow"), 0.1f, TEXT("Time in seconds during which a spawned effect suppresses nearby duplicates"), ECVF_Cheat);
+
+static FAutoConsoleCommandWithWorld FXStatsCommand(
+  TEXT("wot.FX.Stats"),
+  TEXT("Logs the FX subsystem counters"),
+  FConsoleCommandWithWorldDelegate::CreateLambda([](UWorld* World) {
+    UWotFXSubsystem* FX = UWotFXSubsystem::Get(World);
+    if (!FX) {
+      return;
+    }
+    const FWotFXCounters Counters = FX->GetCounters();
+    UE_LOG(LogTemp, Log, TEXT("FX: requested %d, spawned %d, culled by distance %d, culled by budget %d, deduplicated %d, peak per frame %d"),
+           Counters.Requested, Counters.Spawned, Counters.CulledByDistance, Counters.CulledByBudget, Counters.Deduplicated, Counters.PeakSpawnedPerFrame);
+  }));
+
+UWotFXSubsystem* UWotFXSubsystem::Get(const UObject* WorldContextObject)
+{
+  if (!WorldContextObject) {
+    return nullptr;
+  }
+  UWorld* World = WorldContextObject->GetWorld();
+  return World ? World->GetSubsystem<UWotFXSubsystem>() : nullptr;
+}
+
+UNiagaraComponent* UWotFXSubsystem::SpawnSystemAtLocation(const UObject* WorldContextObject, UNiagaraSystem* System, FVector Location, FRotator Rotation, EWotFXPriority Priority)
+{
+  if (!System) {
+    return nullptr;
+  }
+  UWotFXSubsystem* FX = Get(WorldContextObject);
+  if (FX && !FX->AllowSpawn(System, Location, Priority)) {
+    return nullptr;
+  }
+  UNiagaraComponent* NiagaraComp = UNiagaraFunctionLibrary::SpawnSystemAtLocation(WorldContextObject,
+                                                                                  System,
+                                                                                  Location,
+                                                                                  Rotation,
+                                                                                  FVector(1.f),
+                                                                                  true,
+                                                                                  true,
+                                                                                  ENCPoolMethod::AutoRelease);
+  if (FX && NiagaraComp) {
+    FX->OnSpawned(System, Location);
+  }
+  return NiagaraComp;
+}
+
+UNiagaraComponent* UWotFXSubsystem::SpawnSystemAttached(UNiagaraSystem* System, USceneComponent* AttachToComponent, FName AttachPointName, FVector Location, FRotator Rotation, EWotFXPriority Priority)
+{
+  if (!System || !AttachToComponent) {
+    return nullptr;
+  }
+  const FVector WorldLocation = AttachToComponent->GetSocketTransform(AttachPointName).TransformPosition(Location);
+  UWotFXSubsystem* FX = Get(AttachToComponent);
+  if (FX && !FX->AllowSpawn(System, WorldLocation, Priority)) {
+    return nullptr;
+  }
+  UNiagaraComponent* NiagaraComp = UNiagaraFunctionLibrary::SpawnSystemAttached(System,
+                                                                                AttachToComponent,
+                                                                                AttachPointName,
+                                                                                Location,
+                                                                                Rotation,
+                                                                                EAttachLocation::Type::KeepRelativeOffset,
+                                                                                true,
+                                                                                true,
+                                                                                ENCPoolMethod::AutoRelease);
+  if (FX && NiagaraComp) {
+    FX->OnSpawned(System, WorldLocation);
+  }
+  return NiagaraComp;
+}
+
+void UWotFXSubsystem::ResetCounters()
+{
+  Counters = FWotFXCounters();
+}
+
+bool UWotFXSubsystem::AllowSpawn(const UNiagaraSystem* System, const FVector& Location, EWotFXPriority Priority)
+{
+  Counters.Requested++;
+  if (BudgetFrame != GFrameCounter) {
+    BudgetFrame = GFrameCounter;
+    SpawnedThisFrame = 0;
+  }
+  if (Priority == EWotFXPriority::Critical) {
+    return true;
+  }
+  float CullDistance = CVarFXCullDistance.GetValueOnGameThread();
+  if (Priority == EWotFXPriority::Low) {
+    CullDistance *= 0.5f;
+  }
+  if (CullDistance > 0.0f && !IsNearAnyPlayer(Location, CullDistance)) {
+    Counters.CulledByDistance++;
+    return false;
+  }
+  const int32 MaxSpawns = CVarFXMaxSpawnsPerFrame.GetValueOnGameThread();
+  if (MaxSpawns > 0 && SpawnedThisFrame >= MaxSpawns) {
+    Counters.CulledByBudget++;
+    return false;
+  }
+  const float DedupeRadius = CVarFXDedupeRadius.GetValueOnGameThread();
+  if (DedupeRadius > 0.0f) {
+    const double Now = GetWorld()->GetTimeSeconds();
+    const double OldestTime = Now - CVarFXDedupeWindow.GetValueOnGameThread();
+    RecentSpawns.RemoveAllSwap([OldestTime](const FRecentSpawn& Recent) { return Recent.Time < OldestTime; }, EAllowShrinking::No);
+    const float DedupeRadiusSq = DedupeRadius * DedupeRadius;
+    for (const FRecentSpawn& Recent : RecentSpawns) {
+      if (Recent.System == System && FVector::DistSquared(Recent.Location, Location) < DedupeRadiusSq) {
+        Counters.Deduplicated++;
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+void UWotFXSubsystem::OnSpawned(const UNiagaraSystem* System, const FVector& Location)
+{
+  Counters.Spawned++;
+  SpawnedThisFrame++;
+  Counters.PeakSpawnedPerFrame = FMath::Max(Counters.PeakSpawnedPerFrame, SpawnedThisFrame);
+  RecentSpawns.Add({System, Location, GetWorld()->GetTimeSeconds()});
+}
+
+bool UWotFXSubsystem::IsNearAnyPlayer(const FVector& Location, float Distance) const
+{
+  const float DistanceSq = Distance * Distance;
+  bool bHasPlayer = false;
+  for (FConstPlayerControllerIterator It = GetWorld()->GetPlayerControllerIterator(); It; ++It) {
+    APlayerController* PC = It->Get();
+    if (!PC) {
+      continue;
+    }
+    bHasPlayer = true;
+    FVector ViewLocation;
+    FRotator ViewRotation;
+    PC->GetPlayerViewPoint(ViewLocation, ViewRotation);
+    if (FVector::DistSquared(ViewLocation, Location) < DistanceSq) {
+      return true;
+    }
+  }
+  // without players (e.g. headless tests) nothing is culled by distance
+  return !bHasPlayer;
+}
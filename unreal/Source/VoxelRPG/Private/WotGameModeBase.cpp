@@ -4,10 +4,12 @@
 #include "GameFramework/PlayerStart.h"
 #include <Kismet/GameplayStatics.h>
 #include "AI/WotAICharacter.h"
+#include "AI/WotBotRegistrySubsystem.h"
+#include "AI/WotSpawnPointSubsystem.h"
 #include "WotCharacter.h"
 #include "WotAttributeComponent.h"
+#include "WotActorPoolSubsystem.h"
 #include "WotGameInstance.h"
-#include "EngineUtils.h"
 
 static TAutoConsoleVariable<bool> CVarSpawnBots(TEXT("wot.SpawnBots"), true, TEXT("Enable spawning of bots via timer"), ECVF_Cheat);
 
@@ -24,6 +26,18 @@ void AWotGameModeBase::StartPlay()
   // is allowed to spawn determined by logic later in the chain...
   GetWorldTimerManager().SetTimer(TimerHandle_SpawnBots, this, &AWotGameModeBase::SpawnBotTimerElapsed, SpawnTimerInterval, true, SpawnTimerInitialDelay);
 
+  if (bUseSpawnPointCache) {
+    if (UWotSpawnPointSubsystem* SpawnPoints = UWotSpawnPointSubsystem::Get(this)) {
+      SpawnPoints->BuildGrid(SpawnPointCacheSettings);
+    }
+  }
+
+  if (UWotActorPoolSubsystem* ActorPool = UWotActorPoolSubsystem::Get(this)) {
+    for (const auto& [PooledClass, Count] : PoolPrewarmCounts) {
+      ActorPool->Prewarm(PooledClass, Count);
+    }
+  }
+
   LoadTime();
 }
 
@@ -144,14 +158,11 @@ void AWotGameModeBase::SpawnBotTimerElapsed()
     return;
   }
 
-  int32 NumberBotsAlive = 0;
-  for (TActorIterator<AWotAICharacter> It(GetWorld()); It; ++It) {
-    AWotAICharacter* Bot = *It;
-    UWotAttributeComponent* AttributeComp = UWotAttributeComponent::GetAttributes(Bot);
-    if (AttributeComp && AttributeComp->IsAlive()) {
-      NumberBotsAlive++;
-    }
+  UWotBotRegistrySubsystem* BotRegistry = UWotBotRegistrySubsystem::Get(this);
+  if (!ensure(BotRegistry)) {
+    return;
   }
+  int32 NumberBotsAlive = BotRegistry->GetNumAliveBots();
 
   int32 MaxBotCount = 10;
 
@@ -159,18 +170,59 @@ void AWotGameModeBase::SpawnBotTimerElapsed()
     MaxBotCount = DifficultyCurve->GetFloatValue(GetWorld()->TimeSeconds - SpawnStartTime);
   }
 
-  if (NumberBotsAlive >= MaxBotCount) {
+  // in wave mode, bots still waiting to be spawned count towards the alive
+  // total and the whole deficit is refilled at once
+  if (bWaveQueryInFlight) {
     return;
   }
+  int32 Deficit = MaxBotCount - NumberBotsAlive - PendingSpawnLocations.Num();
+  if (Deficit <= 0) {
+    return;
+  }
+  int32 NumToSpawn = bSpawnInWaves ? Deficit : 1;
 
-  UEnvQueryInstanceBlueprintWrapper* QueryInstance = UEnvQueryManager::RunEQSQuery(this, SpawnBotQuery, this, EEnvQueryRunMode::RandomBest5Pct, nullptr);
+  if (bUseSpawnPointCache && SpawnBotsFromCache(NumToSpawn)) {
+    return;
+  }
+
+  if (!bSpawnInWaves) {
+    UEnvQueryInstanceBlueprintWrapper* QueryInstance = UEnvQueryManager::RunEQSQuery(this, SpawnBotQuery, this, EEnvQueryRunMode::RandomBest5Pct, nullptr);
+    if (ensure(QueryInstance) && ensure(MinionClass)) {
+      QueryInstance->GetOnQueryFinishedEvent().AddDynamic(this, &AWotGameModeBase::OnQueryCompleted);
+    }
+    return;
+  }
+
+  // need every matching item (sorted by score) to pick several locations
+  UEnvQueryInstanceBlueprintWrapper* QueryInstance = UEnvQueryManager::RunEQSQuery(this, SpawnBotQuery, this, EEnvQueryRunMode::AllMatching, nullptr);
   if (ensure(QueryInstance) && ensure(MinionClass)) {
+    PendingWaveSize = NumToSpawn;
+    bWaveQueryInFlight = true;
     QueryInstance->GetOnQueryFinishedEvent().AddDynamic(this, &AWotGameModeBase::OnQueryCompleted);
   }
 }
 
+bool AWotGameModeBase::SpawnBotsFromCache(int32 NumToSpawn)
+{
+  UWotSpawnPointSubsystem* SpawnPoints = UWotSpawnPointSubsystem::Get(this);
+  if (!SpawnPoints || !ensure(MinionClass)) {
+    return false;
+  }
+  // ask for a few extra candidates so we can still pick separated ones
+  TArray<FVector> Candidates;
+  if (SpawnPoints->GetSpawnCandidates(NumToSpawn * 4, Candidates) == 0) {
+    // cache is still warming up or has nothing valid, use the query
+    return false;
+  }
+  SelectSeparatedLocations(Candidates, NumToSpawn, WaveSpawnMinSeparation, PendingSpawnLocations);
+  SpawnPendingBots();
+  return true;
+}
+
 void AWotGameModeBase::OnQueryCompleted(UEnvQueryInstanceBlueprintWrapper* QueryInstance, EEnvQueryStatus::Type QueryStatus)
 {
+  bWaveQueryInFlight = false;
+
   if (QueryStatus != EEnvQueryStatus::Success) {
     UE_LOG(LogTemp, Warning, TEXT("Spawn bot EQS query failed!"));
     return;
@@ -180,16 +232,82 @@ void AWotGameModeBase::OnQueryCompleted(UEnvQueryInstanceBlueprintWrapper* Query
   if (Locations.Num() <= 0) {
     return;
   }
+
+  if (!bSpawnInWaves || PendingWaveSize <= 0) {
+    SpawnMinion(Locations[0]);
+    return;
+  }
+
+  SelectSeparatedLocations(Locations, PendingWaveSize, WaveSpawnMinSeparation, PendingSpawnLocations);
+  PendingWaveSize = 0;
+  SpawnPendingBots();
+}
+
+void AWotGameModeBase::SelectSeparatedLocations(const TArray<FVector>& Candidates, int32 Count, float MinSeparation, TArray<FVector>& OutLocations)
+{
+  const int32 NumWanted = FMath::Min(Count, Candidates.Num());
+  const int32 FirstNew = OutLocations.Num();
+  const float MinSeparationSq = MinSeparation * MinSeparation;
+  TBitArray<> Used(false, Candidates.Num());
+  // greedily take the best scoring candidates that are far enough away from
+  // everything already picked
+  for (int32 i = 0; i < Candidates.Num() && OutLocations.Num() - FirstNew < NumWanted; i++) {
+    bool bSeparated = true;
+    for (int32 j = FirstNew; j < OutLocations.Num(); j++) {
+      if (FVector::DistSquared(Candidates[i], OutLocations[j]) < MinSeparationSq) {
+        bSeparated = false;
+        break;
+      }
+    }
+    if (bSeparated) {
+      OutLocations.Add(Candidates[i]);
+      Used[i] = true;
+    }
+  }
+  // not enough separated candidates, fill the rest in score order
+  for (int32 i = 0; i < Candidates.Num() && OutLocations.Num() - FirstNew < NumWanted; i++) {
+    if (!Used[i]) {
+      OutLocations.Add(Candidates[i]);
+    }
+  }
+}
+
+void AWotGameModeBase::SpawnPendingBots()
+{
+  const double StartTime = FPlatformTime::Seconds();
+  const double BudgetSeconds = WaveSpawnBudgetMs / 1000.0;
+  // pending locations are best scoring first, spawn from the front
+  int32 NumSpawned = 0;
+  while (NumSpawned < PendingSpawnLocations.Num()) {
+    SpawnMinion(PendingSpawnLocations[NumSpawned]);
+    NumSpawned++;
+    if (FPlatformTime::Seconds() - StartTime >= BudgetSeconds) {
+      break;
+    }
+  }
+  PendingSpawnLocations.RemoveAt(0, NumSpawned, EAllowShrinking::No);
+  UE_LOG(LogTemp, Verbose, TEXT("Wave spawn: spawned %d bots, %d pending"), NumSpawned, PendingSpawnLocations.Num());
+  if (PendingSpawnLocations.Num() > 0) {
+    GetWorldTimerManager().SetTimerForNextTick(this, &AWotGameModeBase::SpawnPendingBots);
+  }
+}
+
+AActor* AWotGameModeBase::SpawnMinion(const FVector& Location)
+{
   FActorSpawnParameters SpawnParams;
   SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
-  GetWorld()->SpawnActor<AActor>(MinionClass, Locations[0] + FVector(0,0,10), FRotator::ZeroRotator, SpawnParams);
+  return UWotActorPoolSubsystem::SpawnPooled(this, MinionClass, FTransform(Location + FVector(0,0,10)), SpawnParams);
 }
 
 void AWotGameModeBase::KillAll()
 {
-  int32 NumberBotsAlive = 0;
-  for (TActorIterator<AWotAICharacter> It(GetWorld()); It; ++It) {
-    AWotAICharacter* Bot = *It;
+  UWotBotRegistrySubsystem* BotRegistry = UWotBotRegistrySubsystem::Get(this);
+  if (!ensure(BotRegistry)) {
+    return;
+  }
+  // copy, since killing removes bots from the registry's alive list
+  TArray<AWotAICharacter*> AliveBots = BotRegistry->GetAliveBots();
+  for (AWotAICharacter* Bot : AliveBots) {
     UWotAttributeComponent* AttributeComp = UWotAttributeComponent::GetAttributes(Bot);
     if (AttributeComp && AttributeComp->IsAlive()) {
       AttributeComp->Kill(this); // @fixme: pass in player for kill credit?
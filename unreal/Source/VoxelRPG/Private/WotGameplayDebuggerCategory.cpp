@@ -0,0 +1,99 @@
+#include "WotGameplayDebuggerCategory.h"
+
+#if WITH_GAMEPLAY_DEBUGGER
+
+#include "WotActionComponent.h"
+#include "WotAction.h"
+#include "WotAttributeComponent.h"
+#include "AIController.h"
+#include "BehaviorTree/BlackboardComponent.h"
+#include "GameFramework/Pawn.h"
+
+FWotGameplayDebuggerCategory::FWotGameplayDebuggerCategory()
+{
+  SetDataPackReplication<FRepData>(&DataPack);
+}
+
+TSharedRef<FGameplayDebuggerCategory> FWotGameplayDebuggerCategory::MakeInstance()
+{
+  return MakeShareable(new FWotGameplayDebuggerCategory());
+}
+
+void FWotGameplayDebuggerCategory::FRepData::Serialize(FArchive& Ar)
+{
+  Ar << ActorName;
+  Ar << ActiveTags;
+  Ar << RunningActions;
+  Ar << Health;
+  Ar << HealthMax;
+  Ar << Stamina;
+  Ar << StaminaMax;
+  Ar << Magic;
+  Ar << MagicMax;
+  Ar << Defense;
+  Ar << bHasAttributes;
+  Ar << bIsStunned;
+  Ar << TargetActor;
+}
+
+void FWotGameplayDebuggerCategory::CollectData(APlayerController* OwnerPC, AActor* DebugActor)
+{
+  DataPack = FRepData();
+  if (!DebugActor) {
+    return;
+  }
+  DataPack.ActorName = DebugActor->GetName();
+
+  if (UWotActionComponent* ActionComp = UWotActionComponent::GetActions(DebugActor)) {
+    DataPack.ActiveTags = ActionComp->ActiveGameplayTags.ToStringSimple();
+    for (const UWotAction* Action : ActionComp->Actions) {
+      if (Action && Action->IsRunning()) {
+        if (!DataPack.RunningActions.IsEmpty()) {
+          DataPack.RunningActions += TEXT(", ");
+        }
+        DataPack.RunningActions += Action->ActionName.ToString();
+      }
+    }
+  }
+
+  if (UWotAttributeComponent* AttributeComp = UWotAttributeComponent::GetAttributes(DebugActor)) {
+    DataPack.bHasAttributes = true;
+    DataPack.Health = AttributeComp->GetHealth();
+    DataPack.HealthMax = AttributeComp->GetHealthMax();
+    DataPack.Stamina = AttributeComp->GetStamina();
+    DataPack.StaminaMax = AttributeComp->GetStaminaMax();
+    DataPack.Magic = AttributeComp->GetMagic();
+    DataPack.MagicMax = AttributeComp->GetMagicMax();
+    DataPack.Defense = AttributeComp->GetDefense();
+    DataPack.bIsStunned = AttributeComp->IsStunned();
+  }
+
+  const APawn* Pawn = Cast<APawn>(DebugActor);
+  const AAIController* AIController = Pawn ? Cast<AAIController>(Pawn->GetController()) : nullptr;
+  const UBlackboardComponent* BlackboardComp = AIController ? AIController->GetBlackboardComponent() : nullptr;
+  if (BlackboardComp) {
+    DataPack.TargetActor = GetNameSafe(BlackboardComp->GetValueAsObject("TargetActor"));
+  }
+}
+
+void FWotGameplayDebuggerCategory::DrawData(APlayerController* OwnerPC, FGameplayDebuggerCanvasContext& CanvasContext)
+{
+  if (DataPack.ActorName.IsEmpty()) {
+    CanvasContext.Print(TEXT("{red}No actor selected"));
+    return;
+  }
+  CanvasContext.Printf(TEXT("{white}Actor: {yellow}%s"), *DataPack.ActorName);
+  CanvasContext.Printf(TEXT("{white}Tags: {yellow}%s"), DataPack.ActiveTags.IsEmpty() ? TEXT("none") : *DataPack.ActiveTags);
+  CanvasContext.Printf(TEXT("{white}Running actions: {yellow}%s"), DataPack.RunningActions.IsEmpty() ? TEXT("none") : *DataPack.RunningActions);
+  if (DataPack.bHasAttributes) {
+    CanvasContext.Printf(TEXT("{white}Health: {yellow}%.1f / %.1f  {white}Stamina: {yellow}%.1f / %.1f  {white}Magic: {yellow}%.1f / %.1f  {white}Defense: {yellow}%.1f"),
+                         DataPack.Health, DataPack.HealthMax, DataPack.Stamina, DataPack.StaminaMax,
+                         DataPack.Magic, DataPack.MagicMax, DataPack.Defense);
+    CanvasContext.Printf(TEXT("{white}Stunned: %s"), DataPack.bIsStunned ? TEXT("{red}yes") : TEXT("{green}no"));
+  }
+  if (!DataPack.TargetActor.IsEmpty()) {
+    CanvasContext.Printf(TEXT("{white}Blackboard target: {yellow}%s"), *DataPack.TargetActor);
+  }
+}
+
+#endif // WITH_GAMEPLAY_DEBUGGER
@@ -0,0 +1,53 @@
+#pragma once
+
+#if WITH_GAMEPLAY_DEBUGGER
+
+#include "CoreMinimal.h"
+#include "GameplayDebuggerCategory.h"
+
+class APlayerController;
+class AActor;
+
+/*
+ * 	Gameplay debugger category showing the gameplay state of the selected
+ * 	actor: active tags, running actions, attributes, stun and the AI's
+ * 	blackboard target. Only the selected actor is collected, and only while
+ * 	the category is shown.
+ */
+class FWotGameplayDebuggerCategory : public FGameplayDebuggerCategory
+{
+public:
+
+  FWotGameplayDebuggerCategory();
+
+  static TSharedRef<FGameplayDebuggerCategory> MakeInstance();
+
+  virtual void CollectData(APlayerController* OwnerPC, AActor* DebugActor) override;
+
+  virtual void DrawData(APlayerController* OwnerPC, FGameplayDebuggerCanvasContext& CanvasContext) override;
+
+protected:
+
+  struct FRepData
+  {
+    FString ActorName;
+    FString ActiveTags;
+    FString RunningActions;
+    float Health = 0.0f;
+    float HealthMax = 0.0f;
+    float Stamina = 0.0f;
+    float StaminaMax = 0.0f;
+    float Magic = 0.0f;
+    float MagicMax = 0.0f;
+    float Defense = 0.0f;
+    bool bHasAttributes = false;
+    bool bIsStunned = false;
+    FString TargetActor;
+
+    void Serialize(FArchive& Ar);
+  };
+
+  FRepData DataPack;
+};
+
+#endif // WITH_GAMEPLAY_DEBUGGER
@@ -1,8 +1,12 @@
 #include "WotGameplayFunctionLibrary.h"
 #include "WotInteractableInterface.h"
 #include "WotAttributeComponent.h"
+#include "WotInteractableGridSubsystem.h"
+#include "Wildlife/WotWildlifeSubsystem.h"
 #include "AssetRegistry/AssetRegistryModule.h"
 
+static TAutoConsoleVariable<bool> CVarInteractionValidateGrid(TEXT("wot.Interaction.ValidateGrid"), false, TEXT("Also run the interaction sweep when using the interactable grid and log when they disagree"), ECVF_Cheat);
+
 bool UWotGameplayFunctionLibrary::GetClosestInteractableInRange(AActor* InstigatorActor, float InteractionRange, FVector BoxHalfExtent, AActor* &ClosestActor, UActorComponent* &ClosestComponent, FHitResult &ClosestHit) {
 	FVector EyeLocation;
 	FRotator EyeRotation;
@@ -16,11 +20,35 @@ bool UWotGameplayFunctionLibrary::GetClosestInteractableInRange(AActor* Instigat
   return GetClosestInteractableInBox(InstigatorActor, BoxHalfExtent, Origin, End, ClosestActor, ClosestComponent, ClosestHit);
 }
 
-bool UWotGameplayFunctionLibrary::GetClosestInteractableInBox(AActor* InstigatorActor, FVector BoxHalfExtent, FVector Origin, FVector End, AActor* &ClosestActor, UActorComponent* &ClosestComponent, FHitResult &ClosestHit) {
+FCollisionObjectQueryParams UWotGameplayFunctionLibrary::GetInteractableObjectQueryParams() {
 	FCollisionObjectQueryParams ObjectQueryParams;
 	ObjectQueryParams.AddObjectTypesToQuery(ECC_WorldStatic);
 	ObjectQueryParams.AddObjectTypesToQuery(ECC_WorldDynamic);
 	ObjectQueryParams.AddObjectTypesToQuery(ECC_Pawn);
+	return ObjectQueryParams;
+}
+
+bool UWotGameplayFunctionLibrary::GetClosestInteractableInBox(AActor* InstigatorActor, FVector BoxHalfExtent, FVector Origin, FVector End, AActor* &ClosestActor, UActorComponent* &ClosestComponent, FHitResult &ClosestHit) {
+	UWotInteractableGridSubsystem* Grid = UWotInteractableGridSubsystem::GetIfEnabled(InstigatorActor);
+	if (!Grid) {
+		return SweepClosestInteractableInBox(InstigatorActor, BoxHalfExtent, Origin, End, ClosestActor, ClosestComponent, ClosestHit);
+	}
+	bool bFound = Grid->FindClosestInteractable(Origin, End, BoxHalfExtent, ClosestActor, ClosestComponent, ClosestHit);
+	if (CVarInteractionValidateGrid.GetValueOnGameThread()) {
+		AActor* SweepActor = nullptr;
+		UActorComponent* SweepComponent = nullptr;
+		FHitResult SweepHit;
+		SweepClosestInteractableInBox(InstigatorActor, BoxHalfExtent, Origin, End, SweepActor, SweepComponent, SweepHit);
+		if (SweepActor != ClosestActor || SweepComponent != ClosestComponent) {
+			UE_LOG(LogTemp, Warning, TEXT("Interactable grid found '%s' ('%s') but the sweep found '%s' ('%s')"),
+				   *GetNameSafe(ClosestActor), *GetNameSafe(ClosestComponent), *GetNameSafe(SweepActor), *GetNameSafe(SweepComponent));
+		}
+	}
+	return bFound;
+}
+
+bool UWotGameplayFunctionLibrary::SweepClosestInteractableInBox(AActor* InstigatorActor, FVector BoxHalfExtent, FVector Origin, FVector End, AActor* &ClosestActor, UActorComponent* &ClosestComponent, FHitResult &ClosestHit) {
+	FCollisionObjectQueryParams ObjectQueryParams = GetInteractableObjectQueryParams();
 
 	FCollisionShape Shape;
 	Chaos::TVector<float, 3> HalfExtent = BoxHalfExtent;
@@ -35,10 +63,14 @@ bool UWotGameplayFunctionLibrary::GetClosestInteractableInBox(AActor* Instigator
 														   ObjectQueryParams,
 														   Shape);
 
+	return FindClosestInteractable(Hits, Origin, End, ClosestActor, ClosestComponent, ClosestHit);
+}
+
+bool UWotGameplayFunctionLibrary::FindClosestInteractable(const TArray<FHitResult>& Hits, const FVector& Origin, const FVector& End, AActor* &ClosestActor, UActorComponent* &ClosestComponent, FHitResult &ClosestHit) {
 	// find the closest interactable actor or component from the list
 	float ClosestDistance = (End - Origin).Size();
 
-	for (auto Hit : Hits) {
+	for (const FHitResult& Hit : Hits) {
 		AActor* Actor = Hit.GetActor();
 		if (Actor) {
 			// get the distance to the hit location
@@ -107,6 +139,8 @@ bool UWotGameplayFunctionLibrary::ApplyDamage(AActor* DamageCauser, AActor* Targ
 
 bool UWotGameplayFunctionLibrary::ApplyDirectionalDamage(AActor* DamageCauser, AActor* TargetActor, float DamageAmount, const FHitResult& HitResult)
 {
+  // hitting a wildlife animal damages the character it is promoted to
+  TargetActor = UWotWildlifeSubsystem::ResolveHitActor(TargetActor, HitResult);
   if (ApplyDamage(DamageCauser, TargetActor, DamageAmount)) {
     // Ensure the actor we're going to apply an impulse (for explosion) to has
     // collision enabled
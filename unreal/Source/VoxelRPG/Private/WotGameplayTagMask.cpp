@@ -0,0 +1,46 @@
+#include "WotGameplayTagMask.h"
+
+namespace
+{
+  // game thread only, like the action components that use it
+  TMap<FGameplayTag, int32> TagBits;
+  uint32 Generation = 1;
+}
+
+FWotGameplayTagMask FWotGameplayTagMask::MakeRequirement(const FGameplayTagContainer& Tags)
+{
+  FWotGameplayTagMask Mask;
+  for (const FGameplayTag& Tag : Tags) {
+    int32* Bit = TagBits.Find(Tag);
+    if (!Bit) {
+      if (TagBits.Num() >= 64) {
+        UE_LOG(LogTemp, Warning, TEXT("More than 64 action requirement tags, '%s' falls back to container queries"), *Tag.ToString());
+        Mask.bValid = false;
+        continue;
+      }
+      Bit = &TagBits.Add(Tag, TagBits.Num());
+      Generation++;
+    }
+    Mask.Bits |= 1ull << *Bit;
+  }
+  return Mask;
+}
+
+FWotGameplayTagMask FWotGameplayTagMask::MakeActive(const FGameplayTagContainer& Tags)
+{
+  FWotGameplayTagMask Mask;
+  if (Tags.IsEmpty()) {
+    return Mask;
+  }
+  for (const FGameplayTag& Tag : Tags.GetGameplayTagParents()) {
+    if (const int32* Bit = TagBits.Find(Tag)) {
+      Mask.Bits |= 1ull << *Bit;
+    }
+  }
+  return Mask;
+}
+
+uint32 FWotGameplayTagMask::GetGeneration()
+{
+  return Generation;
+}
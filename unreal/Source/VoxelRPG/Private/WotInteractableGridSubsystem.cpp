@@ -0,0 +1,324 @@
+#include "WotInteractableGridSubsystem.h"
+#include "WotInteractableInterface.h"
+#include "Engine/World.h"
+#include "EngineUtils.h"
+
+static TAutoConsoleVariable<bool> CVarInteractionUseGrid(TEXT("wot.Interaction.UseGrid"), true, TEXT("Find interactables in the interactable grid instead of with a physics sweep"), ECVF_Cheat);
+static TAutoConsoleVariable<float> CVarInteractionGridCellSize(TEXT("wot.Interaction.GridCellSize"), 500.0f, TEXT("Cell size of the interactable grid, applied when a world starts"), ECVF_Cheat);
+
+static FAutoConsoleCommandWithWorld InteractionGridStatsCommand(
+  TEXT("wot.Interaction.GridStats"),
+  TEXT("Logs the number of interactables and cells in the interactable grid"),
+  FConsoleCommandWithWorldDelegate::CreateLambda([](UWorld* World) {
+    UWotInteractableGridSubsystem* Grid = UWotInteractableGridSubsystem::Get(World);
+    if (!Grid) {
+      return;
+    }
+    UE_LOG(LogTemp, Log, TEXT("Interactable grid: %d interactables in %d cells"), Grid->GetNumInteractables(), Grid->GetNumCells());
+  }));
+
+UWotInteractableGridSubsystem* UWotInteractableGridSubsystem::Get(const UObject* WorldContextObject)
+{
+  if (!WorldContextObject) {
+    return nullptr;
+  }
+  UWorld* World = WorldContextObject->GetWorld();
+  return World ? World->GetSubsystem<UWotInteractableGridSubsystem>() : nullptr;
+}
+
+UWotInteractableGridSubsystem* UWotInteractableGridSubsystem::GetIfEnabled(const UObject* WorldContextObject)
+{
+  return CVarInteractionUseGrid.GetValueOnGameThread() ? Get(WorldContextObject) : nullptr;
+}
+
+void UWotInteractableGridSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+  Super::Initialize(Collection);
+  CellSize = FMath::Max(CVarInteractionGridCellSize.GetValueOnGameThread(), 50.0f);
+  ActorSpawnedHandle = GetWorld()->AddOnActorSpawnedHandler(FOnActorSpawned::FDelegate::CreateUObject(this, &UWotInteractableGridSubsystem::OnActorSpawned));
+}
+
+void UWotInteractableGridSubsystem::Deinitialize()
+{
+  if (UWorld* World = GetWorld()) {
+    World->RemoveOnActorSpawnedHandler(ActorSpawnedHandle);
+  }
+  Actors.Empty();
+  Components.Empty();
+  Bounds.Empty();
+  BoundsOffsets.Empty();
+  Movable.Empty();
+  TransformHandles.Empty();
+  MinCells.Empty();
+  MaxCells.Empty();
+  QueryStamps.Empty();
+  Indices.Empty();
+  Cells.Empty();
+  MovedActors.Empty();
+  Super::Deinitialize();
+}
+
+void UWotInteractableGridSubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+  Super::OnWorldBeginPlay(InWorld);
+  // actors loaded with the level are never reported as spawned
+  for (AActor* Actor : TActorRange<AActor>(&InWorld)) {
+    RegisterInteractable(Actor);
+  }
+}
+
+void UWotInteractableGridSubsystem::OnActorSpawned(AActor* Actor)
+{
+  RegisterInteractable(Actor);
+}
+
+void UWotInteractableGridSubsystem::OnActorEndPlay(AActor* Actor, EEndPlayReason::Type EndPlayReason)
+{
+  UnregisterInteractable(Actor);
+}
+
+void UWotInteractableGridSubsystem::RegisterInteractable(AActor* Actor, UActorComponent* Component)
+{
+  if (!IsValid(Actor) || Indices.Contains(Actor)) {
+    return;
+  }
+  if (Actor->Implements<UWotInteractableInterface>()) {
+    Component = nullptr;
+  } else if (!Component) {
+    Component = Actor->FindComponentByInterface(UWotInteractableInterface::StaticClass());
+    if (!Component) {
+      return;
+    }
+  } else if (!Component->Implements<UWotInteractableInterface>()) {
+    return;
+  }
+  const FBox ActorBounds = MeasureBounds(Actor);
+  USceneComponent* Root = Actor->GetRootComponent();
+  const bool bMovable = Root && Root->Mobility == EComponentMobility::Movable;
+  const int32 Index = Actors.Add(Actor);
+  Indices.Add(Actor, Index);
+  Components.Add(Component);
+  Bounds.Add(ActorBounds);
+  BoundsOffsets.Add(ActorBounds.GetCenter() - Actor->GetActorLocation());
+  Movable.Add(bMovable);
+  TransformHandles.Add(bMovable ? Root->TransformUpdated.AddUObject(this, &UWotInteractableGridSubsystem::OnRootTransformUpdated) : FDelegateHandle());
+  MinCells.AddDefaulted();
+  MaxCells.AddDefaulted();
+  QueryStamps.Add(0);
+  AddToCells(Index);
+  Actor->OnEndPlay.AddUniqueDynamic(this, &UWotInteractableGridSubsystem::OnActorEndPlay);
+}
+
+void UWotInteractableGridSubsystem::UnregisterInteractable(AActor* Actor, UActorComponent* Component)
+{
+  const int32* Index = Indices.Find(Actor);
+  if (!Index || (Component && Components[*Index] != Component)) {
+    return;
+  }
+  RemoveAt(*Index);
+  if (IsValid(Actor)) {
+    Actor->OnEndPlay.RemoveDynamic(this, &UWotInteractableGridSubsystem::OnActorEndPlay);
+  }
+}
+
+FBox UWotInteractableGridSubsystem::MeasureBounds(AActor* Actor)
+{
+  FVector Center;
+  FVector Extent;
+  Actor->GetActorBounds(true, Center, Extent);
+  if (Extent.IsNearlyZero()) {
+    // collision may still be off, e.g. for actors spawned into the pool
+    Actor->GetActorBounds(false, Center, Extent);
+  }
+  return FBox::BuildAABB(Center, Extent);
+}
+
+void UWotInteractableGridSubsystem::RefreshBounds(AActor* Actor)
+{
+  const int32* Index = Indices.Find(Actor);
+  if (!Index) {
+    return;
+  }
+  Bounds[*Index] = MeasureBounds(Actor);
+  BoundsOffsets[*Index] = Bounds[*Index].GetCenter() - Actor->GetActorLocation();
+  UpdateCells(*Index);
+}
+
+void UWotInteractableGridSubsystem::OnRootTransformUpdated(USceneComponent* UpdatedComponent, EUpdateTransformFlags UpdateTransformFlags, ETeleportType Teleport)
+{
+  MovedActors.Add(UpdatedComponent->GetOwner());
+}
+
+void UWotInteractableGridSubsystem::UpdateCells(int32 Index)
+{
+  FIntVector NewMin;
+  FIntVector NewMax;
+  GetCellRange(Bounds[Index], NewMin, NewMax);
+  if (NewMin != MinCells[Index] || NewMax != MaxCells[Index]) {
+    RemoveFromCells(Index);
+    AddToCells(Index);
+  }
+}
+
+void UWotInteractableGridSubsystem::RemoveAt(int32 Index)
+{
+  RemoveFromCells(Index);
+  if (Movable[Index]) {
+    if (USceneComponent* Root = IsValid(Actors[Index]) ? Actors[Index]->GetRootComponent() : nullptr) {
+      Root->TransformUpdated.Remove(TransformHandles[Index]);
+    }
+    MovedActors.Remove(Actors[Index]);
+  }
+  const int32 LastIndex = Actors.Num() - 1;
+  if (Index != LastIndex) {
+    // the last interactable moves into the hole, point its cells at the new index
+    for (int32 X = MinCells[LastIndex].X; X <= MaxCells[LastIndex].X; X++) {
+      for (int32 Y = MinCells[LastIndex].Y; Y <= MaxCells[LastIndex].Y; Y++) {
+        for (int32 Z = MinCells[LastIndex].Z; Z <= MaxCells[LastIndex].Z; Z++) {
+          TArray<int32>& Cell = Cells.FindChecked(FIntVector(X, Y, Z));
+          Cell[Cell.Find(LastIndex)] = Index;
+        }
+      }
+    }
+  }
+  Indices.Remove(Actors[Index]);
+  Actors.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+  Components.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+  Bounds.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+  BoundsOffsets.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+  Movable.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+  TransformHandles.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+  MinCells.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+  MaxCells.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+  QueryStamps.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+  if (Actors.IsValidIndex(Index)) {
+    Indices[Actors[Index]] = Index;
+  }
+}
+
+void UWotInteractableGridSubsystem::GetCellRange(const FBox& Box, FIntVector& OutMin, FIntVector& OutMax) const
+{
+  OutMin = FIntVector(FMath::FloorToInt(Box.Min.X / CellSize),
+                      FMath::FloorToInt(Box.Min.Y / CellSize),
+                      FMath::FloorToInt(Box.Min.Z / CellSize));
+  OutMax = FIntVector(FMath::FloorToInt(Box.Max.X / CellSize),
+                      FMath::FloorToInt(Box.Max.Y / CellSize),
+                      FMath::FloorToInt(Box.Max.Z / CellSize));
+}
+
+void UWotInteractableGridSubsystem::AddToCells(int32 Index)
+{
+  GetCellRange(Bounds[Index], MinCells[Index], MaxCells[Index]);
+  for (int32 X = MinCells[Index].X; X <= MaxCells[Index].X; X++) {
+    for (int32 Y = MinCells[Index].Y; Y <= MaxCells[Index].Y; Y++) {
+      for (int32 Z = MinCells[Index].Z; Z <= MaxCells[Index].Z; Z++) {
+        Cells.FindOrAdd(FIntVector(X, Y, Z)).Add(Index);
+      }
+    }
+  }
+}
+
+void UWotInteractableGridSubsystem::RemoveFromCells(int32 Index)
+{
+  for (int32 X = MinCells[Index].X; X <= MaxCells[Index].X; X++) {
+    for (int32 Y = MinCells[Index].Y; Y <= MaxCells[Index].Y; Y++) {
+      for (int32 Z = MinCells[Index].Z; Z <= MaxCells[Index].Z; Z++) {
+        const FIntVector CellKey(X, Y, Z);
+        TArray<int32>& Cell = Cells.FindChecked(CellKey);
+        Cell.RemoveSingleSwap(Index, EAllowShrinking::No);
+        if (Cell.Num() == 0) {
+          Cells.Remove(CellKey);
+        }
+      }
+    }
+  }
+}
+
+TStatId UWotInteractableGridSubsystem::GetStatId() const
+{
+  RETURN_QUICK_DECLARE_CYCLE_STAT(UWotInteractableGridSubsystem, STATGROUP_Tickables);
+}
+
+void UWotInteractableGridSubsystem::Tick(float DeltaTime)
+{
+  // follow the interactables that moved, only touching the cells when they
+  // change
+  for (const AActor* Actor : MovedActors) {
+    const int32* Index = Indices.Find(Actor);
+    if (!Index || !IsValid(Actor)) {
+      continue;
+    }
+    const FVector Center = Actor->GetActorLocation() + BoundsOffsets[*Index];
+    const FVector Extent = Bounds[*Index].GetExtent();
+    Bounds[*Index] = FBox::BuildAABB(Center, Extent);
+    UpdateCells(*Index);
+  }
+  MovedActors.Reset();
+}
+
+bool UWotInteractableGridSubsystem::FindClosestInteractable(const FVector& Origin, const FVector& End, const FVector& BoxHalfExtent, AActor*& ClosestActor, UActorComponent*& ClosestComponent, FHitResult& ClosestHit)
+{
+  FBox QueryBox(Origin, Origin);
+  QueryBox += End;
+  QueryBox = QueryBox.ExpandBy(BoxHalfExtent);
+  FIntVector MinCell;
+  FIntVector MaxCell;
+  GetCellRange(QueryBox, MinCell, MaxCell);
+
+  QueryStamp++;
+  float ClosestDistance = (End - Origin).Size();
+  int32 ClosestIndex = INDEX_NONE;
+  FVector ClosestLocation = FVector::ZeroVector;
+  FVector ClosestNormal = FVector::ZeroVector;
+  float ClosestTime = 1.0f;
+  for (int32 X = MinCell.X; X <= MaxCell.X; X++) {
+    for (int32 Y = MinCell.Y; Y <= MaxCell.Y; Y++) {
+      for (int32 Z = MinCell.Z; Z <= MaxCell.Z; Z++) {
+        const TArray<int32>* Cell = Cells.Find(FIntVector(X, Y, Z));
+        if (!Cell) {
+          continue;
+        }
+        for (const int32 Index : *Cell) {
+          if (QueryStamps[Index] == QueryStamp) {
+            continue;
+          }
+          QueryStamps[Index] = QueryStamp;
+          // pooled and disabled interactables have their collision off and
+          // would not be hit by the sweep either
+          const AActor* Actor = Actors[Index];
+          if (!IsValid(Actor) || !Actor->GetActorEnableCollision()) {
+            continue;
+          }
+          FVector HitLocation;
+          FVector HitNormal;
+          float HitTime;
+          if (!FMath::LineExtentBoxIntersection(Bounds[Index], Origin, End, BoxHalfExtent, HitLocation, HitNormal, HitTime)) {
+            continue;
+          }
+          const float Distance = FVector::Dist(HitLocation, Origin);
+          if (Distance < ClosestDistance) {
+            ClosestDistance = Distance;
+            ClosestIndex = Index;
+            ClosestLocation = HitLocation;
+            ClosestNormal = HitNormal;
+            ClosestTime = HitTime;
+          }
+        }
+      }
+    }
+  }
+  if (ClosestIndex == INDEX_NONE) {
+    return false;
+  }
+  AActor* Actor = Actors[ClosestIndex];
+  ClosestActor = Actor;
+  ClosestComponent = Components[ClosestIndex];
+  ClosestHit = FHitResult(Actor, Cast<UPrimitiveComponent>(Actor->GetRootComponent()), ClosestLocation, ClosestNormal);
+  ClosestHit.ImpactPoint = Bounds[ClosestIndex].GetClosestPointTo(ClosestLocation);
+  ClosestHit.ImpactNormal = ClosestNormal;
+  ClosestHit.TraceStart = Origin;
+  ClosestHit.TraceEnd = End;
+  ClosestHit.Time = ClosestTime;
+  ClosestHit.Distance = ClosestDistance;
+  return true;
+}
@@ -6,6 +6,8 @@
 #include "WotInventoryComponent.h"
 #include "Items/WotItem.h"
 #include "WotGameplayFunctionLibrary.h"
+#include "WotTraceSubsystem.h"
+#include "WotInteractableGridSubsystem.h"
 
 // For Debug:
 #include "DrawDebugHelpers.h"
@@ -51,6 +53,41 @@ bool UWotInteractionComponent::GetInteractableInRange(AActor *&OutActor, UActorC
 	return didHit;
 }
 
+void UWotInteractionComponent::RequestInteractableInRange(FWotInteractableResultDelegate OnResult) const
+{
+	AActor* MyOwner = GetOwner();
+	if (UWotInteractableGridSubsystem::GetIfEnabled(MyOwner)) {
+		// the grid answers without a physics query, no need to wait a frame
+		AActor* ClosestActor = nullptr;
+		UActorComponent* ClosestComponent = nullptr;
+		FHitResult ClosestHit;
+		if (GetInteractableInRange(ClosestActor, ClosestComponent, ClosestHit)) {
+			OnResult.ExecuteIfBound(ClosestActor, ClosestComponent, ClosestHit);
+		}
+		return;
+	}
+	// same sweep as UWotGameplayFunctionLibrary::GetClosestInteractableInRange
+	const FVector Origin = MyOwner->GetActorLocation();
+	const FVector End = Origin + (MyOwner->GetActorForwardVector() * InteractionRange);
+	FCollisionShape Shape;
+	Shape.SetBox(FVector3f(InteractionBoxQueryHalfExtent));
+	UWotTraceSubsystem::SweepMultiByObjectType(MyOwner,
+											   Origin,
+											   End,
+											   FQuat::Identity,
+											   UWotGameplayFunctionLibrary::GetInteractableObjectQueryParams(),
+											   Shape,
+											   FCollisionQueryParams(SCENE_QUERY_STAT(WotInteraction)),
+											   FWotTraceResultDelegate::CreateWeakLambda(this, [Origin, End, OnResult](const TArray<FHitResult>& Hits) {
+		AActor* ClosestActor = nullptr;
+		UActorComponent* ClosestComponent = nullptr;
+		FHitResult ClosestHit;
+		if (UWotGameplayFunctionLibrary::FindClosestInteractable(Hits, Origin, End, ClosestActor, ClosestComponent, ClosestHit)) {
+			OnResult.ExecuteIfBound(ClosestActor, ClosestComponent, ClosestHit);
+		}
+	}));
+}
+
 void UWotInteractionComponent::PrimaryInteract()
 {
 	AActor* MyOwner = GetOwner();
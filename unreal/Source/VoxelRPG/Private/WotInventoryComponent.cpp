@@ -1,4 +1,5 @@
 #include "WotInventoryComponent.h"
+#include "WotComponentHost.h"
 #include "Items/WotItem.h"
 
 UWotInventoryComponent::UWotInventoryComponent()
@@ -9,12 +10,23 @@ void UWotInventoryComponent::BeginPlay()
 {
   Super::BeginPlay();
   // Start the owning actor with the default items
-  for (auto& item : DefaultItems) {
+  AddDefaultItems();
+}
+
+void UWotInventoryComponent::AddDefaultItems()
+{
+  for (auto& DefaultItem : DefaultItems) {
+    if (!DefaultItem) {
+      continue;
+    }
     // get a random number
     float RandomNumber = FMath::FRandRange(0.0f, 1.0f);
-    auto spawn_info = item->SpawnInfo;
+    auto spawn_info = DefaultItem->SpawnInfo;
     // if the random number is less than the spawn chance, spawn the item
     if (RandomNumber < spawn_info.Probability) {
+      // work on a copy so the defaults can be added again when the owner is
+      // reused from a pool
+      UWotItem* item = DuplicateObject(DefaultItem, this);
       int min = spawn_info.MinCount;
       int max = spawn_info.MaxCount;
       // if the spawn info's min and max counts are 0, set them to the item's
@@ -133,6 +145,15 @@ void UWotInventoryComponent::DeleteItem(UWotItem* Item) {
   OnInventoryUpdated.Broadcast();
 }
 
+void UWotInventoryComponent::ClearItems() {
+  if (Items.Num() == 0) {
+    return;
+  }
+  Items.Reset();
+  // Update UI and other interested parties
+  OnInventoryUpdated.Broadcast();
+}
+
 void UWotInventoryComponent::DropAll() {
   FVector Location = GetOwner()->GetActorLocation();
   // TODO: cannot use range-based for loop here since Drop() will remove it from
@@ -145,8 +166,5 @@ void UWotInventoryComponent::DropAll() {
 
 UWotInventoryComponent* UWotInventoryComponent::GetInventory(AActor* FromActor)
 {
-	if (FromActor) {
-		return Cast<UWotInventoryComponent>(FromActor->GetComponentByClass(UWotInventoryComponent::StaticClass()));
-	}
-	return nullptr;
+	return FWotComponentCache::Find<UWotInventoryComponent>(FromActor);
 }
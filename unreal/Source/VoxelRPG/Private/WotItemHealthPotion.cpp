@@ -9,8 +9,7 @@ void AWotItemHealthPotion::Interact_Implementation(APawn* InstigatorPawn, FHitRe
     return;
   }
   // get the attribute component of the instigating pawn
-  UWotAttributeComponent* AttributeComp =
-    Cast<UWotAttributeComponent>(InstigatorPawn->GetComponentByClass(UWotAttributeComponent::StaticClass()));
+  UWotAttributeComponent* AttributeComp = UWotAttributeComponent::GetAttributes(InstigatorPawn);
   // if there's no attribute component, return
   if (!AttributeComp) {
     return;
@@ -29,8 +28,7 @@ void AWotItemHealthPotion::Interact_Implementation(APawn* InstigatorPawn, FHitRe
 void AWotItemHealthPotion::GetInteractionText_Implementation(APawn* InstigatorPawn, FHitResult Hit, FText& OutText)
 {
   // get the attribute component of the instigating pawn
-  UWotAttributeComponent* AttributeComp =
-    Cast<UWotAttributeComponent>(InstigatorPawn->GetComponentByClass(UWotAttributeComponent::StaticClass()));
+  UWotAttributeComponent* AttributeComp = UWotAttributeComponent::GetAttributes(InstigatorPawn);
   // if there's no attribute component, return
   if (!AttributeComp) {
     return;
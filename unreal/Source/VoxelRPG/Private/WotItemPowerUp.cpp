@@ -29,7 +29,7 @@ void AWotItemPowerUp::Highlight_Implementation(FHitResult Hit, int HighlightValu
   SetHighlightEnabled(HighlightValue, true);
   // if duration is > 0, start a timer to unhighlight the object
   if (Duration > 0) {
-    GetWorldTimerManager().SetTimer(HighlightTimerHandle, this, &AWotItemPowerUp::OnHighlightTimerExpired, Duration, false);
+    UWotTimingWheelSubsystem::SetTimer(this, HighlightTimerHandle, &AWotItemPowerUp::OnHighlightTimerExpired, Duration);
   }
 }
 
@@ -60,7 +60,7 @@ void AWotItemPowerUp::HideAndCooldownPowerup()
 {
   SetPowerupState(false);
 
-  GetWorldTimerManager().SetTimer(TimerHandle_Cooldown, this, &AWotItemPowerUp::ShowPowerup, CooldownTime);
+  UWotTimingWheelSubsystem::SetTimer(this, TimerHandle_Cooldown, &AWotItemPowerUp::ShowPowerup, CooldownTime);
 }
 
 void AWotItemPowerUp::SetPowerupState(bool bNewIsInteractable)
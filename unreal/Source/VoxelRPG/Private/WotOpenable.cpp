@@ -2,6 +2,8 @@
 
 #include "WotOpenable.h"
 #include "Components/AudioComponent.h"
+#include "WotSoundSubsystem.h"
+#include "AI/WotSpawnPointSubsystem.h"
 
 // Sets default values
 AWotOpenable::AWotOpenable()
@@ -49,7 +51,7 @@ void AWotOpenable::Highlight_Implementation(FHitResult Hit, int HighlightValue,
   SetHighlightEnabled(HighlightValue, true);
   // if duration is > 0, start a timer to unhighlight the object
   if (Duration > 0) {
-    GetWorldTimerManager().SetTimer(HighlightTimerHandle, this, &AWotOpenable::OnHighlightTimerExpired, Duration, false);
+    UWotTimingWheelSubsystem::SetTimer(this, HighlightTimerHandle, &AWotOpenable::OnHighlightTimerExpired, Duration);
   }
 }
 
@@ -76,10 +78,10 @@ void AWotOpenable::Open_Implementation(APawn* InstigatorPawn)
     // only update the state if it was closed
     bIsOpen = true;
     OnOpened.Broadcast(InstigatorPawn, this);
+    InvalidateSpawnPoints();
     OnStateChanged.Broadcast(InstigatorPawn, this, bIsOpen);
     // play open sound
-    EffectAudioComp->SetSound(OpenSound);
-    EffectAudioComp->Play(0);
+    UWotSoundSubsystem::PlaySoundAttached(OpenSound, EffectAudioComp, EWotSoundCategory::World);
   }
 }
 
@@ -89,9 +91,18 @@ void AWotOpenable::Close_Implementation(APawn* InstigatorPawn)
     // only update the state if it was open
     bIsOpen = false;
     OnClosed.Broadcast(InstigatorPawn, this);
+    InvalidateSpawnPoints();
     OnStateChanged.Broadcast(InstigatorPawn, this, bIsOpen);
     // play close sound
-    EffectAudioComp->SetSound(CloseSound);
-    EffectAudioComp->Play(0);
+    UWotSoundSubsystem::PlaySoundAttached(CloseSound, EffectAudioComp, EWotSoundCategory::World);
+  }
+}
+
+void AWotOpenable::InvalidateSpawnPoints()
+{
+  // doors and gates change the navmesh, so cached spawn points around us are
+  // no longer valid
+  if (UWotSpawnPointSubsystem* SpawnPoints = UWotSpawnPointSubsystem::Get(this)) {
+    SpawnPoints->InvalidateBounds(GetComponentsBoundingBox(true));
   }
 }
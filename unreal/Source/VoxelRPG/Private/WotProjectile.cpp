@@ -14,6 +14,10 @@
 #include "NiagaraFunctionLibrary.h"
 #include "NiagaraComponent.h"
 #include "WotGameplayFunctionLibrary.h"
+#include "WotActorPoolSubsystem.h"
+#include "WotProjectileSubsystem.h"
+#include "WotFXSubsystem.h"
+#include "WotSoundSubsystem.h"
 
 AWotProjectile::AWotProjectile()
 {
@@ -51,7 +55,7 @@ void AWotProjectile::PostInitializeComponents()
     SphereComp->OnComponentBeginOverlap.AddDynamic(this, &AWotProjectile::OnActorOverlap);
   }
   if (EffectNiagaraSystem) {
-    EffectNiagaraComp = UNiagaraFunctionLibrary::SpawnSystemAttached(EffectNiagaraSystem, SphereComp, NAME_None, FVector(0.f), FRotator(0.f), EAttachLocation::Type::KeepRelativeOffset, true);
+    EffectNiagaraComp = UNiagaraFunctionLibrary::SpawnSystemAttached(EffectNiagaraSystem, SphereComp, NAME_None, FVector(0.f), FRotator(0.f), EAttachLocation::Type::KeepRelativeOffset, false);
   }
 
   SetLifeSpan(ProjectileLifeSpan);
@@ -62,6 +66,116 @@ void AWotProjectile::BeginPlay()
 {
   Super::BeginPlay();
   EffectAudioComp->Play();
+  if (MovementComp->IsActive()) {
+    BeginManagedFlight();
+  }
+}
+
+void AWotProjectile::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+  EndManagedFlight();
+  Super::EndPlay(EndPlayReason);
+}
+
+void AWotProjectile::BeginManagedFlight()
+{
+  // bouncing is left to the movement component
+  if (!bUseProjectileManager || MovementComp->bShouldBounce || !UWotProjectileSubsystem::IsEnabled()) {
+    return;
+  }
+  UWotProjectileSubsystem* ProjectileSubsystem = UWotProjectileSubsystem::Get(this);
+  if (!ProjectileSubsystem) {
+    return;
+  }
+  ProjectileSubsystem->AddProjectile(this,
+                                     MovementComp,
+                                     SphereComp->GetScaledSphereRadius(),
+                                     CollisionProfileName);
+  // the subsystem sweeps for hits, so the sphere would only report them twice
+  MovementComp->StopMovementImmediately();
+  MovementComp->Deactivate();
+  SphereComp->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+}
+
+void AWotProjectile::EndManagedFlight()
+{
+  if (UWotProjectileSubsystem* ProjectileSubsystem = UWotProjectileSubsystem::Get(this)) {
+    ProjectileSubsystem->RemoveProjectile(this);
+  }
+}
+
+bool AWotProjectile::IsManagedFlight() const
+{
+  UWotProjectileSubsystem* ProjectileSubsystem = UWotProjectileSubsystem::Get(this);
+  return ProjectileSubsystem && ProjectileSubsystem->IsManaged(this);
+}
+
+FVector AWotProjectile::GetProjectileVelocity() const
+{
+  if (IsManagedFlight()) {
+    return UWotProjectileSubsystem::Get(this)->GetVelocity(this);
+  }
+  return MovementComp->Velocity;
+}
+
+void AWotProjectile::SetProjectileVelocity(const FVector& NewVelocity)
+{
+  if (IsManagedFlight()) {
+    UWotProjectileSubsystem::Get(this)->SetVelocity(this, NewVelocity);
+  } else {
+    MovementComp->Velocity = NewVelocity;
+  }
+}
+
+void AWotProjectile::HandleManagedHit(const FHitResult& Hit)
+{
+  OnActorOverlap(SphereComp, Hit.GetActor(), Hit.GetComponent(), Hit.Item, true, Hit);
+}
+
+void AWotProjectile::SetManagedCulled(bool bCulled)
+{
+  SetActorHiddenInGame(bCulled);
+  if (EffectNiagaraComp) {
+    EffectNiagaraComp->SetPaused(bCulled);
+  }
+  EffectAudioComp->SetPaused(bCulled);
+}
+
+void AWotProjectile::OnAcquiredFromPool_Implementation()
+{
+  // redo what PostInitializeComponents / BeginPlay set up for a new projectile
+  if (bUseSphereForCollisionAndOverlap) {
+    SphereComp->ClearMoveIgnoreActors();
+    SphereComp->IgnoreActorWhenMoving(GetInstigator(), true);
+    SphereComp->SetCollisionProfileName(CollisionProfileName);
+  }
+  MovementComp->SetUpdatedComponent(SphereComp);
+  MovementComp->Velocity = GetActorForwardVector() * MovementComp->InitialSpeed;
+  MovementComp->UpdateComponentVelocity();
+  MovementComp->Activate(true);
+  if (EffectNiagaraSystem && EffectNiagaraComp) {
+    EffectNiagaraComp->SetPaused(false);
+    EffectNiagaraComp->Activate(true);
+  }
+  EffectAudioComp->SetPaused(false);
+  EffectAudioComp->Play();
+  SetLifeSpan(ProjectileLifeSpan);
+  BeginManagedFlight();
+}
+
+void AWotProjectile::OnReleasedToPool_Implementation()
+{
+  EndManagedFlight();
+  MovementComp->StopMovementImmediately();
+  if (EffectNiagaraComp) {
+    EffectNiagaraComp->DeactivateImmediate();
+  }
+  EffectAudioComp->Stop();
+}
+
+void AWotProjectile::LifeSpanExpired()
+{
+  UWotActorPoolSubsystem::ReleasePooled(this);
 }
 
 
@@ -106,7 +220,7 @@ void AWotProjectile::OnActorOverlap(UPrimitiveComponent* OverlappedComponent, AA
   if (ActionComp && ActionComp->ActiveGameplayTags.HasTag(ParryTag)) {
     UE_LOG(LogTemp, Log, TEXT("Projectile was parried!"));
     // reflect projectile back to where it came from
-    MovementComp->Velocity = -MovementComp->Velocity;
+    SetProjectileVelocity(-GetProjectileVelocity());
     // Make sure to update the instigator so that it can damage the original actor if it hits them
     SetInstigator(Cast<APawn>(OtherActor));
     // return here so we don't explode or try to apply damage
@@ -124,16 +238,13 @@ void AWotProjectile::Explode_Implementation()
   // Adding ensure to see if we encounter this situation at all
   if (ensure(IsValid(this))) {
     if (ImpactNiagaraSystem) {
-      auto ImpactNiagaraComp = UNiagaraFunctionLibrary::SpawnSystemAtLocation(this,
-                                                                              ImpactNiagaraSystem,
-                                                                              GetActorLocation(),
-                                                                              GetActorRotation());
+      UWotFXSubsystem::SpawnSystemAtLocation(this, ImpactNiagaraSystem, GetActorLocation(), GetActorRotation());
     }
     EffectNiagaraComp->Deactivate();
     MovementComp->StopMovementImmediately();
     SetActorEnableCollision(false);
     if (ImpactSound) {
-      UGameplayStatics::PlaySoundAtLocation(this, ImpactSound, GetActorLocation(), 1.0f, 1.0f, 0.0f);
+      UWotSoundSubsystem::PlaySoundAtLocation(this, ImpactSound, GetActorLocation(), EWotSoundCategory::Impact);
     }
     if (CameraShakeEffect) {
       UGameplayStatics::PlayWorldCameraShake(this,
@@ -143,7 +254,7 @@ void AWotProjectile::Explode_Implementation()
                                              CameraShakeOuterRadius,
                                              CameraShakeFalloff);
     }
-    Destroy();
+    UWotActorPoolSubsystem::ReleasePooled(this);
   }
 }
 
@@ -0,0 +1,290 @@
+#include "WotProjectileSubsystem.h"
+#include "WotProjectile.h"
+#include "Engine/World.h"
+#include "GameFramework/PlayerController.h"
+#include "GameFramework/ProjectileMovementComponent.h"
+
+static TAutoConsoleVariable<bool> CVarProjectileManagerEnabled(TEXT("wot.Projectiles.UseManager"), true, TEXT("Let projectiles with bUseProjectileManager be moved by the projectile subsystem instead of their movement component"), ECVF_Cheat);
+static TAutoConsoleVariable<float> CVarProjectileCullDistance(TEXT("wot.Projectiles.CullDistance"), 10000.0f, TEXT("Managed projectiles further than this from every player are hidden and not moved visually (0 = never cull)"), ECVF_Cheat);
+static TAutoConsoleVariable<bool> CVarProjectileAsyncSweeps(TEXT("wot.Projectiles.AsyncSweeps"), true, TEXT("Sweep for managed projectile hits with a batch of async traces, handling the hits a frame later"), ECVF_Cheat);
+
+UWotProjectileSubsystem* UWotProjectileSubsystem::Get(const UObject* WorldContextObject)
+{
+  if (!WorldContextObject) {
+    return nullptr;
+  }
+  UWorld* World = WorldContextObject->GetWorld();
+  return World ? World->GetSubsystem<UWotProjectileSubsystem>() : nullptr;
+}
+
+bool UWotProjectileSubsystem::IsEnabled()
+{
+  return CVarProjectileManagerEnabled.GetValueOnGameThread();
+}
+
+void UWotProjectileSubsystem::AddProjectile(AWotProjectile* Projectile, const UProjectileMovementComponent* Movement, float Radius, FName ProfileName)
+{
+  if (!ensure(Projectile) || !ensure(Movement)) {
+    return;
+  }
+  if (const int32* Index = Indices.Find(Projectile)) {
+    Velocities[*Index] = Movement->Velocity;
+    return;
+  }
+  const FVector Location = Projectile->GetActorLocation();
+  Indices.Add(Projectile, Projectiles.Add(Projectile));
+  Locations.Add(Location);
+  PrevLocations.Add(Location);
+  Velocities.Add(Movement->Velocity);
+  GravityZs.Add(Movement->GetGravityZ());
+  MaxSpeeds.Add(Movement->GetMaxSpeed());
+  HomingTargets.Add(Movement->bIsHomingProjectile ? Movement->HomingTargetComponent : TWeakObjectPtr<USceneComponent>());
+  HomingAccelerations.Add(Movement->HomingAccelerationMagnitude);
+  Radii.Add(Radius);
+  ProfileNames.Add(ProfileName);
+  Culled.Add(false);
+  SweepHandles.AddDefaulted();
+}
+
+void UWotProjectileSubsystem::RemoveProjectile(AWotProjectile* Projectile)
+{
+  if (const int32* Index = Indices.Find(Projectile)) {
+    RemoveAt(*Index);
+  }
+}
+
+void UWotProjectileSubsystem::RemoveAt(int32 Index)
+{
+  Indices.Remove(Projectiles[Index]);
+  Projectiles.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+  Locations.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+  PrevLocations.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+  Velocities.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+  GravityZs.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+  MaxSpeeds.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+  HomingTargets.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+  HomingAccelerations.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+  Radii.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+  ProfileNames.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+  Culled.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+  SweepHandles.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+  // fix up the index of the projectile that was swapped into the hole
+  if (Projectiles.IsValidIndex(Index)) {
+    Indices[Projectiles[Index]] = Index;
+  }
+}
+
+FVector UWotProjectileSubsystem::GetVelocity(const AWotProjectile* Projectile) const
+{
+  const int32* Index = Indices.Find(Projectile);
+  return Index ? Velocities[*Index] : FVector::ZeroVector;
+}
+
+void UWotProjectileSubsystem::SetVelocity(const AWotProjectile* Projectile, const FVector& NewVelocity)
+{
+  if (const int32* Index = Indices.Find(Projectile)) {
+    Velocities[*Index] = NewVelocity;
+  }
+}
+
+void UWotProjectileSubsystem::Deinitialize()
+{
+  Projectiles.Empty();
+  Locations.Empty();
+  PrevLocations.Empty();
+  Velocities.Empty();
+  GravityZs.Empty();
+  MaxSpeeds.Empty();
+  HomingTargets.Empty();
+  HomingAccelerations.Empty();
+  Radii.Empty();
+  ProfileNames.Empty();
+  Culled.Empty();
+  SweepHandles.Empty();
+  Indices.Empty();
+  PendingHits.Empty();
+  Super::Deinitialize();
+}
+
+TStatId UWotProjectileSubsystem::GetStatId() const
+{
+  RETURN_QUICK_DECLARE_CYCLE_STAT(UWotProjectileSubsystem, STATGROUP_Tickables);
+}
+
+void UWotProjectileSubsystem::Tick(float DeltaTime)
+{
+  Super::Tick(DeltaTime);
+  // drop anything destroyed without going through RemoveProjectile
+  for (int32 i = Projectiles.Num() - 1; i >= 0; i--) {
+    if (!IsValid(Projectiles[i])) {
+      RemoveAt(i);
+    }
+  }
+  if (CVarProjectileAsyncSweeps.GetValueOnGameThread()) {
+    // hits of the flight queued last frame first, then move on and queue
+    // the next sweeps
+    CollectSweeps();
+    DispatchHits();
+    Integrate(DeltaTime);
+    IssueSweeps();
+    UpdateVisuals();
+    return;
+  }
+  Integrate(DeltaTime);
+  SweepAll();
+  UpdateVisuals();
+  // last, since hit handlers release projectiles and so reorder the arrays
+  DispatchHits();
+}
+
+void UWotProjectileSubsystem::Integrate(float DeltaTime)
+{
+  // plain loops over the contiguous arrays so the compiler can vectorize them
+  const int32 Num = Projectiles.Num();
+  FVector* RESTRICT Location = Locations.GetData();
+  FVector* RESTRICT PrevLocation = PrevLocations.GetData();
+  FVector* RESTRICT Velocity = Velocities.GetData();
+  const float* RESTRICT GravityZ = GravityZs.GetData();
+  const float* RESTRICT MaxSpeed = MaxSpeeds.GetData();
+  for (int32 i = 0; i < Num; i++) {
+    PrevLocation[i] = Location[i];
+  }
+  // accelerate towards the target like UProjectileMovementComponent does
+  for (int32 i = 0; i < Num; i++) {
+    if (const USceneComponent* HomingTarget = HomingTargets[i].Get()) {
+      Velocity[i] += (HomingTarget->GetComponentLocation() - Location[i]).GetSafeNormal() * (HomingAccelerations[i] * DeltaTime);
+    }
+  }
+  for (int32 i = 0; i < Num; i++) {
+    Velocity[i].Z += GravityZ[i] * DeltaTime;
+  }
+  for (int32 i = 0; i < Num; i++) {
+    if (MaxSpeed[i] > 0.0f) {
+      Velocity[i] = Velocity[i].GetClampedToMaxSize(MaxSpeed[i]);
+    }
+  }
+  for (int32 i = 0; i < Num; i++) {
+    Location[i] += Velocity[i] * DeltaTime;
+  }
+}
+
+void UWotProjectileSubsystem::SweepAll()
+{
+  UWorld* World = GetWorld();
+  TArray<FHitResult> Hits;
+  for (int32 i = 0; i < Projectiles.Num(); i++) {
+    AWotProjectile* Projectile = Projectiles[i];
+    FCollisionQueryParams Params(SCENE_QUERY_STAT(WotProjectileSweep), false, Projectile);
+    Params.AddIgnoredActor(Projectile->GetInstigator());
+    Hits.Reset();
+    World->SweepMultiByProfile(Hits,
+                               PrevLocations[i],
+                               Locations[i],
+                               FQuat::Identity,
+                               ProfileNames[i],
+                               FCollisionShape::MakeSphere(Radii[i]),
+                               Params);
+    AddHits(i, Hits);
+  }
+}
+
+void UWotProjectileSubsystem::IssueSweeps()
+{
+  UWorld* World = GetWorld();
+  for (int32 i = 0; i < Projectiles.Num(); i++) {
+    AWotProjectile* Projectile = Projectiles[i];
+    FCollisionQueryParams Params(SCENE_QUERY_STAT(WotProjectileSweep), false, Projectile);
+    Params.AddIgnoredActor(Projectile->GetInstigator());
+    SweepHandles[i] = World->AsyncSweepByProfile(EAsyncTraceType::Multi,
+                                                 PrevLocations[i],
+                                                 Locations[i],
+                                                 FQuat::Identity,
+                                                 ProfileNames[i],
+                                                 FCollisionShape::MakeSphere(Radii[i]),
+                                                 Params);
+  }
+}
+
+void UWotProjectileSubsystem::CollectSweeps()
+{
+  UWorld* World = GetWorld();
+  FTraceDatum Datum;
+  for (int32 i = 0; i < Projectiles.Num(); i++) {
+    // projectiles added since the last frame have nothing queued yet
+    if (SweepHandles[i].IsValid() && World->QueryTraceData(SweepHandles[i], Datum)) {
+      AddHits(i, Datum.OutHits);
+    }
+    SweepHandles[i] = FTraceHandle();
+  }
+}
+
+void UWotProjectileSubsystem::AddHits(int32 Index, const TArray<FHitResult>& Hits)
+{
+  for (const FHitResult& Hit : Hits) {
+    if (!Hit.GetActor()) {
+      continue;
+    }
+    // the projectile stops where it is blocked, same as the movement
+    // component would
+    if (Hit.bBlockingHit) {
+      Locations[Index] = Hit.Location;
+    }
+    PendingHits.Add({Projectiles[Index], Hit});
+  }
+}
+
+void UWotProjectileSubsystem::UpdateVisuals()
+{
+  UpdatePlayerViews();
+  const float CullDistance = CVarProjectileCullDistance.GetValueOnGameThread();
+  const float CullDistanceSq = CullDistance * CullDistance;
+  for (int32 i = 0; i < Projectiles.Num(); i++) {
+    bool bCulled = false;
+    if (CullDistance > 0.0f && PlayerViewLocations.Num() > 0) {
+      bCulled = true;
+      for (const FVector& ViewLocation : PlayerViewLocations) {
+        if (FVector::DistSquared(ViewLocation, Locations[i]) < CullDistanceSq) {
+          bCulled = false;
+          break;
+        }
+      }
+    }
+    if (bCulled != Culled[i]) {
+      Culled[i] = bCulled;
+      Projectiles[i]->SetManagedCulled(bCulled);
+    }
+    if (!bCulled) {
+      Projectiles[i]->SetActorLocationAndRotation(Locations[i], Velocities[i].Rotation());
+    }
+  }
+}
+
+void UWotProjectileSubsystem::DispatchHits()
+{
+  for (const FPendingHit& PendingHit : PendingHits) {
+    AWotProjectile* Projectile = PendingHit.Projectile.Get();
+    // an earlier hit this frame may have already ended the flight
+    if (!IsValid(Projectile) || !IsManaged(Projectile)) {
+      continue;
+    }
+    // handlers use the actor transform for impact effects and pickups
+    Projectile->SetActorLocationAndRotation(PendingHit.Hit.Location, GetVelocity(Projectile).Rotation());
+    Projectile->HandleManagedHit(PendingHit.Hit);
+  }
+  PendingHits.Reset();
+}
+
+void UWotProjectileSubsystem::UpdatePlayerViews()
+{
+  PlayerViewLocations.Reset();
+  for (FConstPlayerControllerIterator It = GetWorld()->GetPlayerControllerIterator(); It; ++It) {
+    APlayerController* PC = It->Get();
+    if (!PC) {
+      continue;
+    }
+    FVector ViewLocation;
+    FRotator ViewRotation;
+    PC->GetPlayerViewPoint(ViewLocation, ViewRotation);
+    PlayerViewLocations.Add(ViewLocation);
+  }
+}
@@ -0,0 +1,227 @@
+#include "WotSoundSubsystem.h"
+#include "Components/AudioComponent.h"
+#include "Engine/World.h"
+#include "Engine/Engine.h"
+#include "GameFramework/PlayerController.h"
+#include "Kismet/GameplayStatics.h"
+#include "Sound/SoundBase.h"
+
+static TAutoConsoleVariable<float> CVarSoundMergeCellSize(TEXT("wot.Sound.MergeCellSize"), 200.0f, TEXT("Identical sounds in the same cell of this size in the same frame are merged (0 = never merge)"), ECVF_Cheat);
+static TAutoConsoleVariable<int32> CVarSoundMaxImpactVoices(TEXT("wot.Sound.MaxVoices.Impact"), 12, TEXT("Voice budget for impact sounds"), ECVF_Cheat);
+static TAutoConsoleVariable<int32> CVarSoundMaxWeaponVoices(TEXT("wot.Sound.MaxVoices.Weapon"), 12, TEXT("Voice budget for weapon sounds"), ECVF_Cheat);
+static TAutoConsoleVariable<int32> CVarSoundMaxPickupVoices(TEXT("wot.Sound.MaxVoices.Pickup"), 4, TEXT("Voice budget for pickup sounds"), ECVF_Cheat);
+static TAutoConsoleVariable<int32> CVarSoundMaxWorldVoices(TEXT("wot.Sound.MaxVoices.World"), 8, TEXT("Voice budget for world sounds (doors, chests, ...)"), ECVF_Cheat);
+static TAutoConsoleVariable<int32> CVarSoundMaxDeathVoices(TEXT("wot.Sound.MaxVoices.Death"), 6, TEXT("Voice budget for death sounds"), ECVF_Cheat);
+
+static FAutoConsoleCommandWithWorld SoundStatsCommand(
+  TEXT("wot.Sound.Stats"),
+  TEXT("Logs the sound subsystem counters"),
+  FConsoleCommandWithWorldDelegate::CreateLambda([](UWorld* World) {
+    UWotSoundSubsystem* Sounds = UWotSoundSubsystem::Get(World);
+    if (!Sounds) {
+      return;
+    }
+    const FWotSoundCounters Counters = Sounds->GetCounters();
+    UE_LOG(LogTemp, Log, TEXT("Sound: requested %d, played %d, merged %d, culled by budget %d, culled by distance %d, components created %d, peak voices %d"),
+           Counters.Requested, Counters.Played, Counters.Merged, Counters.CulledByBudget, Counters.CulledByDistance, Counters.ComponentsCreated, Counters.PeakVoices);
+  }));
+
+static int32 GetMaxVoices(EWotSoundCategory Category)
+{
+  switch (Category) {
+    case EWotSoundCategory::Impact:
+      return CVarSoundMaxImpactVoices.GetValueOnGameThread();
+    case EWotSoundCategory::Weapon:
+      return CVarSoundMaxWeaponVoices.GetValueOnGameThread();
+    case EWotSoundCategory::Pickup:
+      return CVarSoundMaxPickupVoices.GetValueOnGameThread();
+    case EWotSoundCategory::World:
+      return CVarSoundMaxWorldVoices.GetValueOnGameThread();
+    case EWotSoundCategory::Death:
+      return CVarSoundMaxDeathVoices.GetValueOnGameThread();
+    default:
+      return 0;
+  }
+}
+
+UWotSoundSubsystem* UWotSoundSubsystem::Get(const UObject* WorldContextObject)
+{
+  if (!WorldContextObject) {
+    return nullptr;
+  }
+  UWorld* World = WorldContextObject->GetWorld();
+  return World ? World->GetSubsystem<UWotSoundSubsystem>() : nullptr;
+}
+
+void UWotSoundSubsystem::PlaySoundAtLocation(const UObject* WorldContextObject, USoundBase* Sound, FVector Location, EWotSoundCategory Category, float VolumeMultiplier, float PitchMultiplier)
+{
+  if (!Sound) {
+    return;
+  }
+  UWotSoundSubsystem* Sounds = Get(WorldContextObject);
+  if (Sounds && !Sounds->AllowPlay(Sound, Location, Category)) {
+    return;
+  }
+  UGameplayStatics::PlaySoundAtLocation(WorldContextObject, Sound, Location, VolumeMultiplier, PitchMultiplier, 0.0f);
+  if (Sounds) {
+    Sounds->OnPlayed(Sound, Category);
+  }
+}
+
+void UWotSoundSubsystem::PlaySoundAttached(USoundBase* Sound, USceneComponent* AttachToComponent, EWotSoundCategory Category, float VolumeMultiplier, float PitchMultiplier)
+{
+  if (!Sound || !AttachToComponent) {
+    return;
+  }
+  UWotSoundSubsystem* Sounds = Get(AttachToComponent);
+  if (!Sounds) {
+    UGameplayStatics::SpawnSoundAttached(Sound, AttachToComponent, NAME_None, FVector::ZeroVector, EAttachLocation::KeepRelativeOffset, false, VolumeMultiplier, PitchMultiplier);
+    return;
+  }
+  if (!Sounds->AllowPlay(Sound, AttachToComponent->GetComponentLocation(), Category)) {
+    return;
+  }
+  UAudioComponent* AudioComp = Sounds->AcquireComponent();
+  AudioComp->AttachToComponent(AttachToComponent, FAttachmentTransformRules::SnapToTargetNotIncludingScale);
+  AudioComp->SetSound(Sound);
+  AudioComp->SetVolumeMultiplier(VolumeMultiplier);
+  AudioComp->SetPitchMultiplier(PitchMultiplier);
+  AudioComp->Play(0.0f);
+  Sounds->OnPlayed(Sound, Category);
+}
+
+void UWotSoundSubsystem::ResetCounters()
+{
+  Counters = FWotSoundCounters();
+}
+
+int32 UWotSoundSubsystem::GetNumVoices(EWotSoundCategory Category) const
+{
+  PruneVoices(Category);
+  return VoiceEndTimes[(int32)Category].Num();
+}
+
+void UWotSoundSubsystem::Deinitialize()
+{
+  for (UAudioComponent* AudioComp : BusyComponents) {
+    if (IsValid(AudioComp)) {
+      AudioComp->DestroyComponent();
+    }
+  }
+  for (UAudioComponent* AudioComp : FreeComponents) {
+    if (IsValid(AudioComp)) {
+      AudioComp->DestroyComponent();
+    }
+  }
+  BusyComponents.Empty();
+  FreeComponents.Empty();
+  Super::Deinitialize();
+}
+
+bool UWotSoundSubsystem::AllowPlay(USoundBase* Sound, const FVector& Location, EWotSoundCategory Category)
+{
+  Counters.Requested++;
+  if (MergeFrame != GFrameCounter) {
+    MergeFrame = GFrameCounter;
+    PlayedThisFrame.Reset();
+  }
+  const float CellSize = CVarSoundMergeCellSize.GetValueOnGameThread();
+  if (CellSize > 0.0f) {
+    const FIntVector Cell(FMath::FloorToInt(Location.X / CellSize),
+                          FMath::FloorToInt(Location.Y / CellSize),
+                          FMath::FloorToInt(Location.Z / CellSize));
+    bool bAlreadyPlayed = false;
+    PlayedThisFrame.Add({Sound, Cell}, &bAlreadyPlayed);
+    if (bAlreadyPlayed) {
+      Counters.Merged++;
+      return false;
+    }
+  }
+  if (!IsAudibleToAnyPlayer(Sound, Location)) {
+    Counters.CulledByDistance++;
+    return false;
+  }
+  if (GetNumVoices(Category) >= GetMaxVoices(Category)) {
+    Counters.CulledByBudget++;
+    return false;
+  }
+  return true;
+}
+
+void UWotSoundSubsystem::OnPlayed(USoundBase* Sound, EWotSoundCategory Category)
+{
+  Counters.Played++;
+  float Duration = Sound->GetDuration();
+  // looping sounds still only hold their voice for a moment, they are one-shots
+  // as far as the budget is concerned
+  if (Duration <= 0.0f || Duration >= INDEFINITELY_LOOPING_DURATION) {
+    Duration = 1.0f;
+  }
+  VoiceEndTimes[(int32)Category].Add(GetWorld()->GetTimeSeconds() + Duration);
+  int32 NumVoices = 0;
+  for (const TArray<double>& EndTimes : VoiceEndTimes) {
+    NumVoices += EndTimes.Num();
+  }
+  Counters.PeakVoices = FMath::Max(Counters.PeakVoices, NumVoices);
+}
+
+void UWotSoundSubsystem::PruneVoices(EWotSoundCategory Category) const
+{
+  const double Now = GetWorld()->GetTimeSeconds();
+  VoiceEndTimes[(int32)Category].RemoveAllSwap([Now](double EndTime) { return EndTime <= Now; }, EAllowShrinking::No);
+}
+
+bool UWotSoundSubsystem::IsAudibleToAnyPlayer(const USoundBase* Sound, const FVector& Location) const
+{
+  const float MaxDistance = Sound->GetMaxDistance();
+  const float MaxDistanceSq = MaxDistance * MaxDistance;
+  bool bHasPlayer = false;
+  for (FConstPlayerControllerIterator It = GetWorld()->GetPlayerControllerIterator(); It; ++It) {
+    APlayerController* PC = It->Get();
+    if (!PC) {
+      continue;
+    }
+    bHasPlayer = true;
+    FVector ListenerLocation;
+    FVector FrontDir;
+    FVector RightDir;
+    PC->GetAudioListenerPosition(ListenerLocation, FrontDir, RightDir);
+    if (FVector::DistSquared(ListenerLocation, Location) <= MaxDistanceSq) {
+      return true;
+    }
+  }
+  // without players (e.g. headless tests) nothing is culled by distance
+  return !bHasPlayer;
+}
+
+UAudioComponent* UWotSoundSubsystem::AcquireComponent()
+{
+  UAudioComponent* AudioComp = nullptr;
+  while (!AudioComp && FreeComponents.Num() > 0) {
+    AudioComp = FreeComponents.Pop(EAllowShrinking::No);
+    if (!IsValid(AudioComp)) {
+      AudioComp = nullptr;
+    }
+  }
+  if (!AudioComp) {
+    AudioComp = NewObject<UAudioComponent>(GetWorld()->GetWorldSettings());
+    AudioComp->bAutoActivate = false;
+    AudioComp->bAutoDestroy = false;
+    AudioComp->bAllowSpatialization = true;
+    AudioComp->RegisterComponentWithWorld(GetWorld());
+    AudioComp->OnAudioFinishedNative.AddUObject(this, &UWotSoundSubsystem::OnPooledSoundFinished);
+    Counters.ComponentsCreated++;
+  }
+  BusyComponents.Add(AudioComp);
+  return AudioComp;
+}
+
+void UWotSoundSubsystem::OnPooledSoundFinished(UAudioComponent* AudioComp)
+{
+  if (BusyComponents.RemoveSwap(AudioComp, EAllowShrinking::No) == 0) {
+    return;
+  }
+  AudioComp->DetachFromComponent(FDetachmentTransformRules::KeepWorldTransform);
+  AudioComp->SetSound(nullptr);
+  FreeComponents.Push(AudioComp);
+}
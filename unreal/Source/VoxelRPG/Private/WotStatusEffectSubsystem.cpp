@@ -0,0 +1,286 @@
+#include "WotStatusEffectSubsystem.h"
+#include "WotStatusEffect.h"
+#include "WotActionComponent.h"
+#include "WotAttributeComponent.h"
+#include "Engine/World.h"
+#include "EngineUtils.h"
+
+static FAutoConsoleCommandWithWorld StatusEffectStatsCommand(
+  TEXT("wot.StatusEffects.Stats"),
+  TEXT("Logs the number of active status effects and the cost of their last update"),
+  FConsoleCommandWithWorldDelegate::CreateLambda([](UWorld* World) {
+    UWotStatusEffectSubsystem* StatusEffects = UWotStatusEffectSubsystem::Get(World);
+    if (!StatusEffects) {
+      return;
+    }
+    UE_LOG(LogTemp, Log, TEXT("Status effects: %d active, last update %.1f us"),
+           StatusEffects->GetNumActive(), StatusEffects->GetLastTickMicroseconds());
+  }));
+
+static FAutoConsoleCommandWithWorldAndArgs StatusEffectBenchCommand(
+  TEXT("wot.StatusEffects.Bench"),
+  TEXT("Applies the given number of transient magic drain effects (default 1000) to every actor with attributes, see wot.StatusEffects.Stats for the cost"),
+  FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World) {
+    const int32 NumEffects = Args.Num() > 0 ? FMath::Max(FCString::Atoi(*Args[0]), 1) : 1000;
+    TArray<AActor*> TargetActors;
+    for (AActor* Actor : TActorRange<AActor>(World)) {
+      if (UWotAttributeComponent::IsActorAlive(Actor)) {
+        TargetActors.Add(Actor);
+      }
+    }
+    for (int32 i = 0; i < NumEffects; i++) {
+      UWotStatusEffect* Effect = NewObject<UWotStatusEffect>(GetTransientPackage());
+      Effect->Duration = 10.0f;
+      Effect->Period = 0.5f;
+      Effect->MagicPerPeriod = -0.01f;
+      for (AActor* Actor : TargetActors) {
+        UWotStatusEffectSubsystem::ApplyStatusEffect(Actor, Effect, nullptr);
+      }
+    }
+    UE_LOG(LogTemp, Log, TEXT("wot.StatusEffects.Bench: applied %d effects to %d actors"), NumEffects, TargetActors.Num());
+  }));
+
+UWotStatusEffectSubsystem* UWotStatusEffectSubsystem::Get(const UObject* WorldContextObject)
+{
+  if (!WorldContextObject) {
+    return nullptr;
+  }
+  UWorld* World = WorldContextObject->GetWorld();
+  return World ? World->GetSubsystem<UWotStatusEffectSubsystem>() : nullptr;
+}
+
+bool UWotStatusEffectSubsystem::ApplyStatusEffect(AActor* TargetActor, UWotStatusEffect* Effect, AActor* InstigatorActor)
+{
+  if (!ensure(Effect)) {
+    return false;
+  }
+  UWotAttributeComponent* Target = UWotAttributeComponent::GetAttributes(TargetActor);
+  UWotStatusEffectSubsystem* StatusEffects = Get(TargetActor);
+  if (!Target || !StatusEffects) {
+    return false;
+  }
+  return StatusEffects->Apply(Target, Effect, InstigatorActor);
+}
+
+bool UWotStatusEffectSubsystem::RemoveStatusEffect(AActor* TargetActor, UWotStatusEffect* Effect)
+{
+  UWotAttributeComponent* Target = UWotAttributeComponent::GetAttributes(TargetActor);
+  UWotStatusEffectSubsystem* StatusEffects = Get(TargetActor);
+  if (!Target || !StatusEffects) {
+    return false;
+  }
+  const int32* Index = StatusEffects->Indices.Find(FEffectKey(Target, Effect));
+  if (!Index) {
+    return false;
+  }
+  StatusEffects->RemoveAt(*Index);
+  return true;
+}
+
+int32 UWotStatusEffectSubsystem::GetStatusEffectStacks(AActor* TargetActor, UWotStatusEffect* Effect)
+{
+  UWotAttributeComponent* Target = UWotAttributeComponent::GetAttributes(TargetActor);
+  UWotStatusEffectSubsystem* StatusEffects = Get(TargetActor);
+  if (!Target || !StatusEffects) {
+    return 0;
+  }
+  const int32* Index = StatusEffects->Indices.Find(FEffectKey(Target, Effect));
+  return Index ? StatusEffects->Stacks[*Index] : 0;
+}
+
+void UWotStatusEffectSubsystem::RemoveAllStatusEffects(AActor* TargetActor)
+{
+  UWotAttributeComponent* Target = UWotAttributeComponent::GetAttributes(TargetActor);
+  for (int32 Index = Targets.Num() - 1; Index >= 0; Index--) {
+    if (Targets[Index] == Target) {
+      RemoveAt(Index);
+    }
+  }
+}
+
+bool UWotStatusEffectSubsystem::Apply(UWotAttributeComponent* Target, UWotStatusEffect* Effect, AActor* InstigatorActor)
+{
+  if (!Target->IsAlive()) {
+    return false;
+  }
+  const float Duration = Effect->Duration > 0.0f ? Effect->Duration : TNumericLimits<float>::Max();
+  if (const int32* ExistingIndex = Indices.Find(FEffectKey(Target, Effect))) {
+    const int32 Index = *ExistingIndex;
+    switch (Effect->Stacking) {
+      case EWotStatusEffectStacking::Ignore:
+        return false;
+      case EWotStatusEffectStacking::Stack:
+        if (Stacks[Index] >= Effect->MaxStacks) {
+          TimesRemaining[Index] = Duration;
+          return true;
+        }
+        Stacks[Index]++;
+        break;
+      case EWotStatusEffectStacking::Refresh:
+        break;
+    }
+    TimesRemaining[Index] = Duration;
+    Instigators[Index] = InstigatorActor;
+  } else {
+    const int32 Index = Targets.Add(Target);
+    Indices.Add(FEffectKey(Target, Effect), Index);
+    UWotActionComponent* ActionComp = UWotActionComponent::GetActions(Target->GetOwner());
+    ActionComps.Add(ActionComp);
+    Effects.Add(Effect);
+    Instigators.Add(InstigatorActor);
+    TimesRemaining.Add(Duration);
+    TimesToNextPeriod.Add(Effect->Period);
+    Periods.Add(Effect->Period);
+    HealthPerPeriods.Add(Effect->HealthPerPeriod);
+    MagicPerPeriods.Add(Effect->MagicPerPeriod);
+    Stacks.Add(1);
+    Keys.Add({FEffectKey(Target, Effect), ActionComp});
+    GrantedTags.Add(Effect->GrantsTags);
+    AddTags(ActionComp, Effect->GrantsTags);
+    for (const FWotAttributeModifier& Modifier : Effect->Modifiers) {
+      Target->AddModifier(Modifier.Attribute, Modifier.Op, Modifier.Value, Effect);
+    }
+  }
+  if (Effect->bApplyOnStart) {
+    if (Effect->HealthPerPeriod != 0.0f) {
+      Target->ApplyPeriodicHealthChange(InstigatorActor, Effect->HealthPerPeriod);
+    }
+    if (Effect->MagicPerPeriod != 0.0f) {
+      Target->ApplyMagicChangeInstigator(InstigatorActor, Effect->MagicPerPeriod);
+    }
+  }
+  return true;
+}
+
+void UWotStatusEffectSubsystem::RemoveAt(int32 Index)
+{
+  RemoveTags(Keys[Index].ActionComp, ActionComps[Index], GrantedTags[Index]);
+  if (IsValid(Targets[Index]) && IsValid(Effects[Index]) && Effects[Index]->Modifiers.Num() > 0) {
+    Targets[Index]->RemoveModifiersFromSource(Effects[Index]);
+  }
+  Indices.Remove(Keys[Index].Effect);
+  Targets.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+  ActionComps.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+  Effects.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+  Instigators.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+  TimesRemaining.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+  TimesToNextPeriod.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+  Periods.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+  HealthPerPeriods.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+  MagicPerPeriods.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+  Stacks.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+  Keys.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+  GrantedTags.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+  // fix up the index of the effect that was swapped into the hole, its key
+  // is registered for as long as it is active
+  if (Targets.IsValidIndex(Index)) {
+    Indices.FindChecked(Keys[Index].Effect) = Index;
+  }
+}
+
+void UWotStatusEffectSubsystem::AddTags(UWotActionComponent* ActionComp, const FGameplayTagContainer& Tags)
+{
+  if (!ActionComp) {
+    return;
+  }
+  for (const FGameplayTag& Tag : Tags) {
+    int32& Count = TagCounts.FindOrAdd(FTagKey(ActionComp, Tag));
+    if (Count++ == 0) {
+      ActionComp->AddGameplayTag(Tag);
+    }
+  }
+}
+
+void UWotStatusEffectSubsystem::RemoveTags(TObjectKey<UWotActionComponent> ActionCompKey, UWotActionComponent* ActionComp, const FGameplayTagContainer& Tags)
+{
+  // no tags were counted for effects on actors without actions
+  if (ActionCompKey == TObjectKey<UWotActionComponent>()) {
+    return;
+  }
+  for (const FGameplayTag& Tag : Tags) {
+    const FTagKey Key(ActionCompKey, Tag);
+    int32* Count = TagCounts.Find(Key);
+    if (!Count || --(*Count) > 0) {
+      continue;
+    }
+    TagCounts.Remove(Key);
+    if (IsValid(ActionComp)) {
+      ActionComp->RemoveGameplayTag(Tag);
+    }
+  }
+}
+
+void UWotStatusEffectSubsystem::Deinitialize()
+{
+  Targets.Empty();
+  ActionComps.Empty();
+  Effects.Empty();
+  Instigators.Empty();
+  TimesRemaining.Empty();
+  TimesToNextPeriod.Empty();
+  Periods.Empty();
+  HealthPerPeriods.Empty();
+  MagicPerPeriods.Empty();
+  Stacks.Empty();
+  Keys.Empty();
+  GrantedTags.Empty();
+  Indices.Empty();
+  TagCounts.Empty();
+  PendingChanges.Empty();
+  Super::Deinitialize();
+}
+
+TStatId UWotStatusEffectSubsystem::GetStatId() const
+{
+  RETURN_QUICK_DECLARE_CYCLE_STAT(UWotStatusEffectSubsystem, STATGROUP_Tickables);
+}
+
+void UWotStatusEffectSubsystem::Tick(float DeltaTime)
+{
+  const uint64 StartCycles = FPlatformTime::Cycles64();
+  PendingChanges.Reset();
+  // backwards, so removing an effect swaps in one that was already updated
+  for (int32 Index = Targets.Num() - 1; Index >= 0; Index--) {
+    UWotAttributeComponent* Target = Targets[Index];
+    if (!IsValid(Target) || !Target->IsAlive()) {
+      RemoveAt(Index);
+      continue;
+    }
+    if (Periods[Index] > 0.0f) {
+      int32 NumPeriods = 0;
+      TimesToNextPeriod[Index] -= DeltaTime;
+      while (TimesToNextPeriod[Index] <= 0.0f) {
+        TimesToNextPeriod[Index] += Periods[Index];
+        NumPeriods++;
+      }
+      if (NumPeriods > 0) {
+        const float Scale = (float)(NumPeriods * Stacks[Index]);
+        PendingChanges.Add({Target, Instigators[Index], HealthPerPeriods[Index] * Scale, MagicPerPeriods[Index] * Scale});
+      }
+    }
+    TimesRemaining[Index] -= DeltaTime;
+    if (TimesRemaining[Index] <= 0.0f) {
+      RemoveAt(Index);
+    }
+  }
+  // applied after the pass since health changes can kill and end effects
+  ApplyPendingChanges();
+  LastTickMicroseconds = FPlatformTime::ToMilliseconds64(FPlatformTime::Cycles64() - StartCycles) * 1000.0;
+}
+
+void UWotStatusEffectSubsystem::ApplyPendingChanges()
+{
+  for (const FPendingChange& Change : PendingChanges) {
+    UWotAttributeComponent* Target = Change.Target.Get();
+    if (!Target) {
+      continue;
+    }
+    if (Change.HealthDelta != 0.0f) {
+      Target->ApplyPeriodicHealthChange(Change.InstigatorActor.Get(), Change.HealthDelta);
+    }
+    if (Change.MagicDelta != 0.0f) {
+      Target->ApplyMagicChangeInstigator(Change.InstigatorActor.Get(), Change.MagicDelta);
+    }
+  }
+  PendingChanges.Reset();
+}
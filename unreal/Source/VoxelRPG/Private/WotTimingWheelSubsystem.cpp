@@ -0,0 +1,257 @@
+#include "WotTimingWheelSubsystem.h"
+#include "Engine/World.h"
+
+static FAutoConsoleCommandWithWorld TimerStatsCommand(
+  TEXT("wot.Timers.Stats"),
+  TEXT("Logs the timing wheel counters"),
+  FConsoleCommandWithWorldDelegate::CreateLambda([](UWorld* World) {
+    UWotTimingWheelSubsystem* Timers = UWotTimingWheelSubsystem::Get(World);
+    if (!Timers) {
+      return;
+    }
+    const FWotTimerCounters Counters = Timers->GetCounters();
+    UE_LOG(LogTemp, Log, TEXT("Timers: active %d, scheduled %d, cancelled %d, fired %d, peak active %d, nodes allocated %d"),
+           Timers->GetNumActive(), Counters.Scheduled, Counters.Cancelled, Counters.Fired, Counters.PeakActive, Counters.NodesAllocated);
+  }));
+
+static FWotTimerHandle MakeHandle(int32 Index, uint32 Serial)
+{
+  FWotTimerHandle Handle;
+  Handle.Id = ((uint64)Serial << 32) | (uint32)Index;
+  return Handle;
+}
+
+UWotTimingWheelSubsystem* UWotTimingWheelSubsystem::Get(const UObject* WorldContextObject)
+{
+  if (!WorldContextObject) {
+    return nullptr;
+  }
+  UWorld* World = WorldContextObject->GetWorld();
+  return World ? World->GetSubsystem<UWotTimingWheelSubsystem>() : nullptr;
+}
+
+void UWotTimingWheelSubsystem::SetTimer(const UObject* WorldContextObject, FWotTimerHandle& InOutHandle, float Delay, FTimerDelegate Delegate)
+{
+  UWotTimingWheelSubsystem* Timers = Get(WorldContextObject);
+  if (!Timers) {
+    UE_LOG(LogTemp, Warning, TEXT("No timing wheel for '%s', timer not set"), *GetNameSafe(WorldContextObject));
+    return;
+  }
+  Timers->Cancel(InOutHandle);
+  InOutHandle = Timers->Schedule(Delay, MoveTemp(Delegate));
+}
+
+void UWotTimingWheelSubsystem::ClearTimer(const UObject* WorldContextObject, FWotTimerHandle& InOutHandle)
+{
+  if (UWotTimingWheelSubsystem* Timers = Get(WorldContextObject)) {
+    Timers->Cancel(InOutHandle);
+  }
+  InOutHandle.Invalidate();
+}
+
+void UWotTimingWheelSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+  Super::Initialize(Collection);
+  for (int32 Level = 0; Level < NumLevels; Level++) {
+    for (int32 Slot = 0; Slot < NumSlots; Slot++) {
+      Heads[Level][Slot] = INDEX_NONE;
+    }
+  }
+}
+
+void UWotTimingWheelSubsystem::Deinitialize()
+{
+  Delegates.Empty();
+  ExpireTicks.Empty();
+  Serials.Empty();
+  Prevs.Empty();
+  Nexts.Empty();
+  Levels.Empty();
+  Slots.Empty();
+  FreeNodes.Empty();
+  Expired.Empty();
+  NumActive = 0;
+  Super::Deinitialize();
+}
+
+void UWotTimingWheelSubsystem::ResetCounters()
+{
+  Counters = FWotTimerCounters();
+}
+
+FWotTimerHandle UWotTimingWheelSubsystem::Schedule(float Delay, FTimerDelegate Delegate)
+{
+  int32 Index = INDEX_NONE;
+  if (FreeNodes.Num() > 0) {
+    Index = FreeNodes.Pop(EAllowShrinking::No);
+  } else {
+    Index = Delegates.AddDefaulted();
+    ExpireTicks.Add(0);
+    Serials.Add(1);
+    Prevs.Add(INDEX_NONE);
+    Nexts.Add(INDEX_NONE);
+    Levels.Add(NodeFree);
+    Slots.Add(0);
+    Counters.NodesAllocated++;
+  }
+  Delegates[Index] = MoveTemp(Delegate);
+  // the next tick is only TickInterval - AccumulatedTime away
+  const double Ticks = FMath::CeilToDouble((FMath::Max(Delay, 0.0f) + AccumulatedTime) / TickInterval);
+  ExpireTicks[Index] = CurrentTick + FMath::Max<uint64>((uint64)Ticks, 1);
+  Insert(Index);
+  NumActive++;
+  Counters.Scheduled++;
+  Counters.PeakActive = FMath::Max(Counters.PeakActive, NumActive);
+  return MakeHandle(Index, Serials[Index]);
+}
+
+int32 UWotTimingWheelSubsystem::FindNode(FWotTimerHandle Handle) const
+{
+  if (!Handle.IsValid()) {
+    return INDEX_NONE;
+  }
+  const int32 Index = (int32)(Handle.Id & 0xffffffff);
+  const uint32 Serial = (uint32)(Handle.Id >> 32);
+  if (!Serials.IsValidIndex(Index) || Serials[Index] != Serial || Levels[Index] == NodeFree) {
+    return INDEX_NONE;
+  }
+  return Index;
+}
+
+void UWotTimingWheelSubsystem::Cancel(FWotTimerHandle Handle)
+{
+  const int32 Index = FindNode(Handle);
+  if (Index == INDEX_NONE) {
+    return;
+  }
+  // expired timers waiting in the batch are only unlinked from it by the
+  // serial changing
+  if (Levels[Index] != NodeExpired) {
+    Unlink(Index);
+  }
+  FreeNode(Index);
+  Counters.Cancelled++;
+}
+
+bool UWotTimingWheelSubsystem::IsTimerActive(FWotTimerHandle Handle) const
+{
+  return FindNode(Handle) != INDEX_NONE;
+}
+
+void UWotTimingWheelSubsystem::Insert(int32 Index)
+{
+  const uint64 Delta = ExpireTicks[Index] - FMath::Min(ExpireTicks[Index], CurrentTick);
+  int32 Level = 0;
+  while (Level < NumLevels - 1 && Delta >= (1ull << (SlotBits * (Level + 1)))) {
+    Level++;
+  }
+  // timers beyond the last level wait in it and are re-inserted each time
+  // their slot comes around
+  const uint64 MaxDelta = (1ull << (SlotBits * NumLevels)) - 1;
+  const uint64 SlotTick = CurrentTick + FMath::Min(Delta, MaxDelta);
+  const int32 Slot = (int32)((SlotTick >> (SlotBits * Level)) & SlotMask);
+  Levels[Index] = Level;
+  Slots[Index] = Slot;
+  Prevs[Index] = INDEX_NONE;
+  Nexts[Index] = Heads[Level][Slot];
+  if (Nexts[Index] != INDEX_NONE) {
+    Prevs[Nexts[Index]] = Index;
+  }
+  Heads[Level][Slot] = Index;
+}
+
+void UWotTimingWheelSubsystem::Unlink(int32 Index)
+{
+  const int32 Prev = Prevs[Index];
+  const int32 Next = Nexts[Index];
+  if (Prev != INDEX_NONE) {
+    Nexts[Prev] = Next;
+  } else {
+    Heads[Levels[Index]][Slots[Index]] = Next;
+  }
+  if (Next != INDEX_NONE) {
+    Prevs[Next] = Prev;
+  }
+  Prevs[Index] = INDEX_NONE;
+  Nexts[Index] = INDEX_NONE;
+}
+
+void UWotTimingWheelSubsystem::FreeNode(int32 Index)
+{
+  Delegates[Index].Unbind();
+  Levels[Index] = NodeFree;
+  // never hand out serial 0, it would make the id of node 0 look invalid
+  Serials[Index] = FMath::Max<uint32>(Serials[Index] + 1, 1);
+  FreeNodes.Push(Index);
+  NumActive--;
+}
+
+void UWotTimingWheelSubsystem::Cascade(int32 Level, int32 Slot)
+{
+  int32 Index = Heads[Level][Slot];
+  Heads[Level][Slot] = INDEX_NONE;
+  while (Index != INDEX_NONE) {
+    const int32 Next = Nexts[Index];
+    Insert(Index);
+    Index = Next;
+  }
+}
+
+void UWotTimingWheelSubsystem::AdvanceTick()
+{
+  CurrentTick++;
+  // when a level wraps, the next slot of the level above is due to move down
+  for (int32 Level = NumLevels - 1; Level > 0; Level--) {
+    const uint64 LevelMask = (1ull << (SlotBits * Level)) - 1;
+    if ((CurrentTick & LevelMask) == 0) {
+      Cascade(Level, (int32)((CurrentTick >> (SlotBits * Level)) & SlotMask));
+    }
+  }
+  const int32 Slot = (int32)(CurrentTick & SlotMask);
+  int32 Index = Heads[0][Slot];
+  Heads[0][Slot] = INDEX_NONE;
+  while (Index != INDEX_NONE) {
+    const int32 Next = Nexts[Index];
+    if (ExpireTicks[Index] <= CurrentTick) {
+      Levels[Index] = NodeExpired;
+      Prevs[Index] = INDEX_NONE;
+      Nexts[Index] = INDEX_NONE;
+      Expired.Add(MakeHandle(Index, Serials[Index]));
+    } else {
+      Insert(Index);
+    }
+    Index = Next;
+  }
+}
+
+void UWotTimingWheelSubsystem::FireExpired()
+{
+  // timers set or cleared by the callbacks don't touch this batch: new ones
+  // are at least one tick away and cleared ones fail the serial check
+  for (int32 i = 0; i < Expired.Num(); i++) {
+    const int32 Index = FindNode(Expired[i]);
+    if (Index == INDEX_NONE) {
+      continue;
+    }
+    FTimerDelegate Delegate = MoveTemp(Delegates[Index]);
+    FreeNode(Index);
+    Counters.Fired++;
+    Delegate.ExecuteIfBound();
+  }
+  Expired.Reset();
+}
+
+TStatId UWotTimingWheelSubsystem::GetStatId() const
+{
+  RETURN_QUICK_DECLARE_CYCLE_STAT(UWotTimingWheelSubsystem, STATGROUP_Tickables);
+}
+
+void UWotTimingWheelSubsystem::Tick(float DeltaTime)
+{
+  AccumulatedTime += DeltaTime;
+  while (AccumulatedTime >= TickInterval) {
+    AccumulatedTime -= TickInterval;
+    AdvanceTick();
+  }
+  FireExpired();
+}
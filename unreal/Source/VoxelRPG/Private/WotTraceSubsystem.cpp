@@ -0,0 +1,104 @@
+#include "WotTraceSubsystem.h"
+#include "Engine/World.h"
+
+static TAutoConsoleVariable<bool> CVarTraceAsync(TEXT("wot.Trace.Async"), true, TEXT("Run interaction / melee sweeps as async traces with results next frame, otherwise sweep immediately"), ECVF_Cheat);
+
+UWotTraceSubsystem* UWotTraceSubsystem::Get(const UObject* WorldContextObject)
+{
+  if (!WorldContextObject) {
+    return nullptr;
+  }
+  UWorld* World = WorldContextObject->GetWorld();
+  return World ? World->GetSubsystem<UWotTraceSubsystem>() : nullptr;
+}
+
+void UWotTraceSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+  Super::Initialize(Collection);
+  TraceDoneDelegate.BindUObject(this, &UWotTraceSubsystem::OnTraceDone);
+}
+
+void UWotTraceSubsystem::Deinitialize()
+{
+  PendingRequests.Empty();
+  TraceDoneDelegate.Unbind();
+  Super::Deinitialize();
+}
+
+void UWotTraceSubsystem::SweepMultiByObjectType(const UObject* WorldContextObject,
+                                                const FVector& Start,
+                                                const FVector& End,
+                                                const FQuat& Rotation,
+                                                const FCollisionObjectQueryParams& ObjectQueryParams,
+                                                const FCollisionShape& Shape,
+                                                const FCollisionQueryParams& Params,
+                                                FWotTraceResultDelegate OnResult)
+{
+  UWorld* World = WorldContextObject ? WorldContextObject->GetWorld() : nullptr;
+  if (!ensure(World)) {
+    return;
+  }
+  UWotTraceSubsystem* Traces = World->GetSubsystem<UWotTraceSubsystem>();
+  if (!Traces || !CVarTraceAsync.GetValueOnGameThread()) {
+    TArray<FHitResult> LocalHits;
+    TArray<FHitResult>& Hits = Traces ? Traces->SyncHits : LocalHits;
+    Hits.Reset();
+    World->SweepMultiByObjectType(Hits, Start, End, Rotation, ObjectQueryParams, Shape, Params);
+    OnResult.ExecuteIfBound(Hits);
+    return;
+  }
+  const uint32 RequestId = Traces->NextRequestId++;
+  Traces->PendingRequests.Add(RequestId, MoveTemp(OnResult));
+  World->AsyncSweepByObjectType(EAsyncTraceType::Multi,
+                                Start,
+                                End,
+                                Rotation,
+                                ObjectQueryParams,
+                                Shape,
+                                Params,
+                                &Traces->TraceDoneDelegate,
+                                RequestId);
+}
+
+void UWotTraceSubsystem::LineTraceTestByChannel(const UObject* WorldContextObject,
+                                                const FVector& Start,
+                                                const FVector& End,
+                                                ECollisionChannel TraceChannel,
+                                                const FCollisionQueryParams& Params,
+                                                FWotTraceResultDelegate OnResult)
+{
+  UWorld* World = WorldContextObject ? WorldContextObject->GetWorld() : nullptr;
+  if (!ensure(World)) {
+    return;
+  }
+  UWotTraceSubsystem* Traces = World->GetSubsystem<UWotTraceSubsystem>();
+  if (!Traces || !CVarTraceAsync.GetValueOnGameThread()) {
+    TArray<FHitResult> LocalHits;
+    TArray<FHitResult>& Hits = Traces ? Traces->SyncHits : LocalHits;
+    Hits.Reset();
+    FHitResult Hit;
+    if (World->LineTraceSingleByChannel(Hit, Start, End, TraceChannel, Params)) {
+      Hits.Add(Hit);
+    }
+    OnResult.ExecuteIfBound(Hits);
+    return;
+  }
+  const uint32 RequestId = Traces->NextRequestId++;
+  Traces->PendingRequests.Add(RequestId, MoveTemp(OnResult));
+  World->AsyncLineTraceByChannel(EAsyncTraceType::Test,
+                                 Start,
+                                 End,
+                                 TraceChannel,
+                                 Params,
+                                 FCollisionResponseParams::DefaultResponseParam,
+                                 &Traces->TraceDoneDelegate,
+                                 RequestId);
+}
+
+void UWotTraceSubsystem::OnTraceDone(const FTraceHandle& Handle, FTraceDatum& Datum)
+{
+  FWotTraceResultDelegate OnResult;
+  if (PendingRequests.RemoveAndCopyValue(Datum.UserData, OnResult)) {
+    OnResult.ExecuteIfBound(Datum.OutHits);
+  }
+}
@@ -2,8 +2,13 @@
 
 #include "CoreMinimal.h"
 #include "GameFramework/Character.h"
+#include "GameplayTagContainer.h"
+#include "BehaviorTree/BehaviorTreeTypes.h"
 #include "WotGameplayInterface.h"
 #include "WotInteractableInterface.h"
+#include "WotPoolableInterface.h"
+#include "WotComponentHost.h"
+#include "WotTimingWheelSubsystem.h"
 #include "WotAICharacter.generated.h"
 
 class UPawnSensingComponent;
@@ -14,9 +19,11 @@ class UWotEquipmentComponent;
 class UWotDeathEffectComponent;
 class UWotUWHealthBar;
 class UWotUWPopupNumber;
+class UWotStuckItemsComponent;
+struct FWotAILODTier;
 
 UCLASS()
-class VOXELRPG_API AWotAICharacter : public ACharacter, public IWotInteractableInterface, public IWotGameplayInterface
+class VOXELRPG_API AWotAICharacter : public ACharacter, public IWotInteractableInterface, public IWotGameplayInterface, public IWotPoolableInterface, public IWotComponentHost
 {
   GENERATED_BODY()
 
@@ -31,15 +38,56 @@ public:
   UFUNCTION(BlueprintCallable)
   void PrimaryAttackStop();
 
+  // Interacting with a bot picks up the items stuck in it, see
+  // UWotStuckItemsComponent
+  virtual void Interact_Implementation(APawn* InstigatorPawn, FHitResult Hit) override;
+
+  virtual void GetInteractionText_Implementation(APawn* InstigatorPawn, FHitResult Hit, FText& OutText) override;
+
   virtual void Highlight_Implementation(FHitResult Hit, int HighlightValue, float Duration) override;
 
   virtual void Unhighlight_Implementation(FHitResult Hit) override;
 
   virtual void SetHighlightEnabled(int HighlightValue, bool Enabled);
 
+  virtual void OnAcquiredFromPool_Implementation() override;
+
+  virtual void OnReleasedToPool_Implementation() override;
+
+  UFUNCTION(BlueprintCallable, Category = "AI")
+  FGameplayTag GetFaction() const { return Faction; }
+
+  virtual const FWotComponentCache& GetComponentCache() const override { return ComponentCache; }
+
+  // Called by UWotPerceptionSubsystem when the pawn this bot sees changes
+  void OnSensedTargetChanged(APawn* NewTarget, APawn* OldTarget);
+
+  // Called by UWotPerceptionSubsystem on every update the target stays in
+  // sight; puts it back only if the blackboard key was cleared or
+  // overwritten since
+  void OnSensedTargetKept(APawn* Target);
+
+  // AI LOD tier set by UWotAILODSubsystem, INDEX_NONE while at full detail
+  // without one
+  int32 GetLODTier() const { return LODTier; }
+
+  float GetLODServiceIntervalScale() const { return LODServiceIntervalScale; }
+
+  void ApplyLODTier(int32 Tier, const FWotAILODTier& Settings);
+
+  // Back to full detail
+  void ResetLODTier();
+
 protected:
 
-    FTimerHandle HighlightTimerHandle;
+  UPROPERTY(Transient)
+  FWotComponentCache ComponentCache;
+
+  // Faction used for grouping alive counts in the bot registry
+  UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "AI")
+  FGameplayTag Faction;
+
+    FWotTimerHandle HighlightTimerHandle;
     void OnHighlightTimerExpired();
 
 	UFUNCTION(BlueprintCallable)
@@ -53,6 +101,10 @@ protected:
 
 	virtual void PostInitializeComponents() override;
 
+	virtual void BeginPlay() override;
+
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
 	UFUNCTION(BlueprintCallable, Category = "AI")
 	void SetBlackboardActor(const FString BlackboardKeyName, AActor* Actor);
 
@@ -92,11 +144,32 @@ protected:
 	UFUNCTION()
 	void OnPawnSeen(APawn* Pawn);
 
+	// the stuck items component if anything is stuck in the bot
+	UWotStuckItemsComponent* GetStuckItems() const;
+
+	// hands sight over to the perception subsystem when it is enabled
+	void RegisterPerception();
+	void UnregisterPerception();
+
+	// resolved on first use, TargetActor is checked every perception update
+	FBlackboard::FKey TargetActorKeyID = FBlackboard::InvalidKey;
+
 	float DamageActorForgetDelay = 5.0f;
-	FTimerHandle TimerHandle_ForgetDamageActor;
+	FWotTimerHandle TimerHandle_ForgetDamageActor;
 	void ForgetDamageActor_TimeElapsed();
 
+	// state undone by OnKilled that a pooled bot needs restored
+	FTransform MeshRelativeTransform;
+	FName CapsuleProfileName;
+	FName MeshProfileName;
+
+	int32 LODTier = INDEX_NONE;
+	float LODServiceIntervalScale = 1.0f;
+	// movement settings the AI LOD changes
+	TEnumAsByte<EMovementMode> GroundMovementMode = MOVE_Walking;
+	bool bSweepWhileNavWalking = true;
+
 	float KilledDestroyDelay = 2.0f;
-	FTimerHandle TimerHandle_Destroy;
+	FWotTimerHandle TimerHandle_Destroy;
 	void Destroy_TimeElapsed();
 };
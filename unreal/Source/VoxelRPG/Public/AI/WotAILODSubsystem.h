@@ -0,0 +1,105 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "WotAILODSubsystem.generated.h"
+
+class AWotAICharacter;
+
+// What a bot in an AI LOD tier still gets; the defaults are full detail
+USTRUCT(BlueprintType)
+struct FWotAILODTier
+{
+  GENERATED_BODY()
+
+  // Bots at least this far from the closest player are in this tier
+  UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "AI")
+  float MinDistance = 0.0f;
+
+  // Multiplier on the intervals of the bot's behavior tree services, see
+  // UWotBTService
+  UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "AI")
+  float ServiceIntervalScale = 1.0f;
+
+  // Move on the navmesh without collision sweeps while on the ground
+  UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "AI")
+  bool bNavWalking = false;
+
+  // Frames skipped between animation updates (URO)
+  UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "AI")
+  int32 AnimFrameSkip = 0;
+};
+
+USTRUCT(BlueprintType)
+struct FWotAILODCounters
+{
+  GENERATED_BODY()
+
+  UPROPERTY(BlueprintReadOnly, Category = "AI")
+  int32 Evaluations = 0;
+
+  UPROPERTY(BlueprintReadOnly, Category = "AI")
+  int32 TierChanges = 0;
+
+  // Alive bots per tier as of the last evaluation
+  UPROPERTY(BlueprintReadOnly, Category = "AI")
+  TArray<int32> BotsPerTier;
+};
+
+/*
+ * 	Distance based level of detail for AI characters. Every
+ * 	wot.AILOD.UpdateInterval the alive bots of UWotBotRegistrySubsystem are
+ * 	sorted into Tiers by their distance to the closest player, counting
+ * 	bots that were not rendered lately as wot.AILOD.OffscreenDistanceScale
+ * 	times farther away. A bot only changes tier once it is
+ * 	wot.AILOD.Hysteresis past the tier boundary, so bots near a boundary
+ * 	don't flip back and forth. Tiers are set in the [/Script/VoxelRPG.
+ * 	WotAILODSubsystem] section of the game config, nearest first.
+ */
+UCLASS(Config = Game)
+class VOXELRPG_API UWotAILODSubsystem : public UTickableWorldSubsystem
+{
+  GENERATED_BODY()
+
+public:
+
+  UWotAILODSubsystem();
+
+  static UWotAILODSubsystem* Get(const UObject* WorldContextObject);
+
+  // Returns the subsystem if wot.AILOD.Enabled is on, nullptr otherwise
+  static UWotAILODSubsystem* GetIfEnabled(const UObject* WorldContextObject);
+
+  const TArray<FWotAILODTier>& GetTiers() const { return Tiers; }
+
+  UFUNCTION(BlueprintCallable, Category = "AI")
+  FWotAILODCounters GetCounters() const { return Counters; }
+
+  UFUNCTION(BlueprintCallable, Category = "AI")
+  void ResetCounters();
+
+  virtual void Tick(float DeltaTime) override;
+
+  virtual TStatId GetStatId() const override;
+
+protected:
+
+  // Sorts every alive bot into its tier
+  void Evaluate();
+
+  // Puts every bot back to full detail, when the LOD gets turned off
+  void ResetBots();
+
+  // Tier of a bot at Distance that is currently in CurrentTier
+  int32 SelectTier(int32 CurrentTier, float Distance, float Hysteresis) const;
+
+  UPROPERTY(Config, EditAnywhere, Category = "AI")
+  TArray<FWotAILODTier> Tiers;
+
+  double NextEvaluateTime = 0.0;
+
+  // whether bots may be in a tier other than full detail
+  bool bApplied = false;
+
+  FWotAILODCounters Counters;
+};
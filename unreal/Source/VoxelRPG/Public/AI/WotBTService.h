@@ -0,0 +1,20 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "BehaviorTree/BTService.h"
+#include "WotBTService.generated.h"
+
+/*
+ * 	Base of the game's behavior tree services. Stretches the interval until
+ * 	the next tick by the AI LOD tier of the bot running the tree (see
+ * 	UWotAILODSubsystem), so services of far away bots run less often.
+ */
+UCLASS(Abstract)
+class VOXELRPG_API UWotBTService : public UBTService
+{
+  GENERATED_BODY()
+
+protected:
+
+  virtual void ScheduleNextTick(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory) override;
+};
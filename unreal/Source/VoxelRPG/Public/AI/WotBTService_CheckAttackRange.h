@@ -1,21 +1,31 @@
 #pragma once
 
 #include "CoreMinimal.h"
-#include "BehaviorTree/BTService.h"
+#include "AI/WotBTService.h"
 #include "WotBTService_CheckAttackRange.generated.h"
 
 UCLASS()
-class VOXELRPG_API UWotBTService_CheckAttackRange : public UBTService
+class VOXELRPG_API UWotBTService_CheckAttackRange : public UWotBTService
 {
   GENERATED_BODY()
 
+public:
+
+  UWotBTService_CheckAttackRange();
+
 protected:
 
   UPROPERTY(EditAnywhere, Category = "AI")
   float AttackRange = 2000.0f;
 
+  UPROPERTY(EditAnywhere, Category = "AI")
+  FBlackboardKeySelector TargetActorKey;
+
   UPROPERTY(EditAnywhere, Category = "AI")
   FBlackboardKeySelector AttackRangeKey;
 
+  // resolves the key ids once instead of looking the keys up by name
+  virtual void InitializeFromAsset(UBehaviorTree& Asset) override;
+
   virtual void TickNode(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory, float DeltaSeconds) override;
 };
@@ -1,14 +1,18 @@
 #pragma once
 
 #include "CoreMinimal.h"
-#include "BehaviorTree/BTService.h"
+#include "AI/WotBTService.h"
 #include "WotBTService_CheckHidden.generated.h"
 
 UCLASS()
-class VOXELRPG_API UWotBTService_CheckHidden : public UBTService
+class VOXELRPG_API UWotBTService_CheckHidden : public UWotBTService
 {
   GENERATED_BODY()
 
+public:
+
+  UWotBTService_CheckHidden();
+
 protected:
 
   UPROPERTY(EditAnywhere, Category = "AI")
@@ -20,5 +24,8 @@ protected:
   UPROPERTY(EditAnywhere, Category = "AI")
   FBlackboardKeySelector HiddenKey;
 
+  // resolves the key ids once instead of looking the keys up by name
+  virtual void InitializeFromAsset(UBehaviorTree& Asset) override;
+
   virtual void TickNode(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory, float DeltaSeconds) override;
 };
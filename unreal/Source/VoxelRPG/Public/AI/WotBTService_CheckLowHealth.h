@@ -1,11 +1,11 @@
 #pragma once
 
 #include "CoreMinimal.h"
-#include "BehaviorTree/BTService.h"
+#include "AI/WotBTService.h"
 #include "WotBTService_CheckLowHealth.generated.h"
 
 UCLASS()
-class VOXELRPG_API UWotBTService_CheckLowHealth : public UBTService
+class VOXELRPG_API UWotBTService_CheckLowHealth : public UWotBTService
 {
   GENERATED_BODY()
 
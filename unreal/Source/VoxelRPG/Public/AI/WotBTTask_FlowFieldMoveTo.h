@@ -0,0 +1,52 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "BehaviorTree/BTTaskNode.h"
+#include "WotBTTask_FlowFieldMoveTo.generated.h"
+
+/*
+ * 	Moves to the actor in TargetActorKey by steering along its shared flow
+ * 	field (see UWotFlowFieldSubsystem), so a swarm chasing the same target
+ * 	costs one field update instead of a path query per agent. Where the
+ * 	field doesn't reach, or with wot.FlowField.Enabled off, falls back to a
+ * 	regular path following move.
+ *
+ * 	A drop-in replacement for the Move To node on TargetActor in the minion
+ * 	tree (BT_NPC); the tree has to be switched over in the editor to use it.
+ */
+UCLASS()
+class VOXELRPG_API UWotBTTask_FlowFieldMoveTo : public UBTTaskNode
+{
+  GENERATED_BODY()
+
+  virtual void InitializeFromAsset(UBehaviorTree& Asset) override;
+
+  virtual EBTNodeResult::Type ExecuteTask(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory) override;
+
+  virtual void TickTask(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory, float DeltaSeconds) override;
+
+  virtual EBTNodeResult::Type AbortTask(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory) override;
+
+  virtual uint16 GetInstanceMemorySize() const override;
+
+protected:
+
+  struct FMoveMemory
+  {
+    // moving along a navmesh path instead of the flow field
+    bool bFollowingPath;
+  };
+
+  UPROPERTY(EditAnywhere, Category = "AI")
+  FBlackboardKeySelector TargetActorKey;
+
+  UPROPERTY(EditAnywhere, Category = "AI")
+  float AcceptableRadius;
+
+  // Returns the result to finish with, or InProgress to keep moving
+  EBTNodeResult::Type Move(UBehaviorTreeComponent& OwnerComp, FMoveMemory& Memory);
+
+public:
+
+  UWotBTTask_FlowFieldMoveTo();
+};
@@ -0,0 +1,68 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "GameplayTagContainer.h"
+#include "WotBotRegistrySubsystem.generated.h"
+
+class AWotAICharacter;
+class UWotAttributeComponent;
+
+/*
+ * 	Registry of all AWotAICharacters in the world. Bots register themselves
+ * 	when they begin play and unregister when they end play; the registry
+ * 	listens to each bot's UWotAttributeComponent::OnKilled so the alive counts
+ * 	are kept up to date without ever having to walk the world's actors.
+ */
+UCLASS()
+class VOXELRPG_API UWotBotRegistrySubsystem : public UWorldSubsystem
+{
+  GENERATED_BODY()
+
+public:
+
+  static UWotBotRegistrySubsystem* Get(const UObject* WorldContextObject);
+
+  void RegisterBot(AWotAICharacter* Bot);
+
+  void UnregisterBot(AWotAICharacter* Bot);
+
+  UFUNCTION(BlueprintCallable, Category = "AI")
+  int32 GetNumAliveBots() const;
+
+  UFUNCTION(BlueprintCallable, Category = "AI")
+  int32 GetNumAliveBotsOfClass(TSubclassOf<AWotAICharacter> BotClass) const;
+
+  UFUNCTION(BlueprintCallable, Category = "AI")
+  int32 GetNumAliveBotsInFaction(FGameplayTag Faction) const;
+
+  // Contiguous arrays for fast iteration, order is not stable
+  const TArray<AWotAICharacter*>& GetAliveBots() const { return AliveBots; }
+
+  const TArray<AWotAICharacter*>& GetRegisteredBots() const { return RegisteredBots; }
+
+protected:
+
+  UFUNCTION()
+  void OnBotKilled(AActor* InstigatorActor, UWotAttributeComponent* OwningComp);
+
+  void AddAlive(AWotAICharacter* Bot);
+
+  void RemoveAlive(AWotAICharacter* Bot);
+
+  static void RemoveSwap(TArray<AWotAICharacter*>& Array, TMap<AWotAICharacter*, int32>& Indices, AWotAICharacter* Bot);
+
+  UPROPERTY(Transient)
+  TArray<AWotAICharacter*> RegisteredBots;
+
+  UPROPERTY(Transient)
+  TArray<AWotAICharacter*> AliveBots;
+
+  TMap<AWotAICharacter*, int32> RegisteredIndices;
+
+  TMap<AWotAICharacter*, int32> AliveIndices;
+
+  TMap<UClass*, int32> AliveCountByClass;
+
+  TMap<FGameplayTag, int32> AliveCountByFaction;
+};
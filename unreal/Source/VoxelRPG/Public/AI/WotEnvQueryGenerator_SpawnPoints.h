@@ -0,0 +1,37 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "EnvironmentQuery/EnvQueryGenerator.h"
+#include "WotEnvQueryGenerator_SpawnPoints.generated.h"
+
+class UEnvQueryContext;
+
+/*
+ * 	Generates points from the spawn point cache instead of projecting a new
+ * 	grid onto the navmesh for every query.
+ */
+UCLASS(meta = (DisplayName = "Cached Spawn Points"))
+class VOXELRPG_API UWotEnvQueryGenerator_SpawnPoints : public UEnvQueryGenerator
+{
+  GENERATED_BODY()
+
+public:
+
+  UWotEnvQueryGenerator_SpawnPoints();
+
+  virtual void GenerateItems(FEnvQueryInstance& QueryInstance) const override;
+
+  virtual FText GetDescriptionTitle() const override;
+
+protected:
+
+  UPROPERTY(EditDefaultsOnly, Category = "Generator")
+  TSubclassOf<UEnvQueryContext> GenerateAround;
+
+  UPROPERTY(EditDefaultsOnly, Category = "Generator")
+  float Radius = 5000.0f;
+
+  // Only generate points the cache has seen hidden from every player
+  UPROPERTY(EditDefaultsOnly, Category = "Generator")
+  bool bOnlyHiddenFromPlayers = true;
+};
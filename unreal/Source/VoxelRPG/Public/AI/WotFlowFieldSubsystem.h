@@ -0,0 +1,190 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "WotFlowFieldSubsystem.generated.h"
+
+USTRUCT(BlueprintType)
+struct FWotFlowFieldCounters
+{
+  GENERATED_BODY()
+
+  // Fields built from scratch for a new goal
+  UPROPERTY(BlueprintReadOnly, Category = "AI")
+  int32 FieldBuilds = 0;
+
+  // Integrations completed, each spread over as many frames as the budget
+  // takes
+  UPROPERTY(BlueprintReadOnly, Category = "AI")
+  int32 FieldUpdates = 0;
+
+  // Cells projected onto the navmesh, new ones only when a field recenters
+  UPROPERTY(BlueprintReadOnly, Category = "AI")
+  int32 CellsProjected = 0;
+
+  // Navmesh raycasts checking that neighboring cells connect
+  UPROPERTY(BlueprintReadOnly, Category = "AI")
+  int32 EdgeRaycasts = 0;
+
+  UPROPERTY(BlueprintReadOnly, Category = "AI")
+  int32 Samples = 0;
+
+  // Samples outside of a field or in a cell the goal can't be reached from
+  UPROPERTY(BlueprintReadOnly, Category = "AI")
+  int32 SampleMisses = 0;
+};
+
+/*
+ * 	Shared navigation for swarms chasing a common goal (the player, a chest
+ * 	being defended, ...). Instead of a navmesh path query per agent, every
+ * 	goal gets one flow field: a grid of wot.FlowField.CellSize cells around
+ * 	the goal, projected onto the navmesh, with the cost to the goal from
+ * 	every cell and the neighbor to step to next. Neighbors are only
+ * 	connected when a navmesh raycast between them is clear, so walls and
+ * 	drops between cells that both project are respected. Agents steer by
+ * 	sampling it with GetFlowDirection, see UWotBTTask_FlowFieldMoveTo.
+ *
+ * 	Fields are updated incrementally and in time slices: the integration is
+ * 	only redone when the goal moves to another cell, and when it gets near
+ * 	the edge of the grid, the grid recenters on it and only the cells that
+ * 	were not in it before are projected. Projection and integration run
+ * 	within a per frame budget (wot.FlowField.MaxProjectionsPerFrame,
+ * 	wot.FlowField.MaxIntegrationStepsPerFrame); agents keep sampling the
+ * 	last complete flow meanwhile, and a new field reports misses until its
+ * 	first one is done. Fields not sampled for a while are dropped.
+ */
+UCLASS()
+class VOXELRPG_API UWotFlowFieldSubsystem : public UTickableWorldSubsystem
+{
+  GENERATED_BODY()
+
+public:
+
+  static UWotFlowFieldSubsystem* Get(const UObject* WorldContextObject);
+
+  // Returns the subsystem if wot.FlowField.Enabled is on, nullptr otherwise
+  static UWotFlowFieldSubsystem* GetIfEnabled(const UObject* WorldContextObject);
+
+  // Direction, in the horizontal plane, to move in at Location to get to
+  // Goal; builds the field of Goal on first use. Returns false when
+  // Location is outside of the field or the goal can't be reached from it
+  UFUNCTION(BlueprintCallable, Category = "AI")
+  bool GetFlowDirection(AActor* Goal, FVector Location, FVector& OutDirection);
+
+  int32 GetNumFields() const { return Fields.Num(); }
+
+  // Cost of the last update, in microseconds
+  double GetLastTickMicroseconds() const { return LastTickMicroseconds; }
+
+  UFUNCTION(BlueprintCallable, Category = "AI")
+  FWotFlowFieldCounters GetCounters() const { return Counters; }
+
+  UFUNCTION(BlueprintCallable, Category = "AI")
+  void ResetCounters();
+
+  virtual void Tick(float DeltaTime) override;
+
+  virtual TStatId GetStatId() const override;
+
+  virtual bool IsTickable() const override { return Fields.Num() > 0; }
+
+protected:
+
+  struct FOpenCell
+  {
+    float Cost;
+    int32 Index;
+  };
+
+  struct FField
+  {
+    TWeakObjectPtr<AActor> Goal;
+
+    float CellSize = 0.0f;
+
+    // grid being projected and integrated: world cell of its first cell,
+    // cells per side and the height cells are projected from
+    FIntPoint Origin = FIntPoint::ZeroValue;
+    int32 Size = 0;
+    float ProjectZ = 0.0f;
+
+    // per cell, row major
+    TArray<bool> Projected;
+    TArray<bool> Walkable;
+    // where the cell is on the navmesh
+    TArray<FVector> Points;
+    // neighbors that can't be walked to in a straight line, see DirectionBit
+    TArray<uint16> Blocked;
+
+    // cells still to be projected
+    TArray<int32> ProjectQueue;
+
+    // integration towards IntegrationGoalCell, spread over frames; starts
+    // once every cell is projected
+    bool bIntegrating = false;
+    bool bIntegrationSeeded = false;
+    FIntPoint IntegrationGoalCell = FIntPoint(MAX_int32, MAX_int32);
+    TArray<float> Costs;
+    TArray<int32> IntegrationNext;
+    TArray<FOpenCell> Open;
+
+    // the last complete flow, which agents sample: index of the neighbor to
+    // step to in a FlowSize grid at FlowOrigin, INDEX_NONE where the goal
+    // can't be reached or at the goal
+    FIntPoint FlowOrigin = FIntPoint::ZeroValue;
+    int32 FlowSize = 0;
+    FIntPoint FlowGoalCell = FIntPoint(MAX_int32, MAX_int32);
+    TArray<int32> Next;
+
+    double LastSampleTime = 0.0;
+
+    int32 ToIndex(const FIntPoint& Cell) const { return (Cell.Y - Origin.Y) * Size + (Cell.X - Origin.X); }
+
+    bool Contains(const FIntPoint& Cell) const
+    {
+      return Cell.X >= Origin.X && Cell.Y >= Origin.Y && Cell.X < Origin.X + Size && Cell.Y < Origin.Y + Size;
+    }
+
+    bool FlowContains(const FIntPoint& Cell) const
+    {
+      return Cell.X >= FlowOrigin.X && Cell.Y >= FlowOrigin.Y && Cell.X < FlowOrigin.X + FlowSize && Cell.Y < FlowOrigin.Y + FlowSize;
+    }
+  };
+
+  // Bit of Blocked for the neighbor at DX, DY (each -1 to 1); the opposite
+  // direction is bit 8 - this one
+  static int32 DirectionBit(int32 DX, int32 DY) { return (DY + 1) * 3 + (DX + 1); }
+
+  FIntPoint ToCell(const FVector& Location, float CellSize) const;
+
+  // Moves the grid of Field to Center, keeping the cells that were already
+  // in it and queuing the others to be projected from Height
+  void Recenter(FField& Field, const FIntPoint& Center, float Height);
+
+  // Projects queued cells onto the navmesh and raycasts to their projected
+  // neighbors, within this frame's budget
+  void Project(FField& Field);
+
+  // Starts redoing the costs and next steps towards GoalCell
+  void StartIntegration(FField& Field, const FIntPoint& GoalCell);
+
+  // Continues the integration within this frame's budget, and makes it the
+  // flow agents sample once done
+  void Integrate(FField& Field);
+
+  // Moves the field along with its goal if bMoveGoal and continues its
+  // projection and integration; returns false if it should go
+  bool UpdateField(FField& Field, bool bMoveGoal);
+
+  TMap<TObjectKey<AActor>, FField> Fields;
+
+  double NextUpdateTime = 0.0;
+
+  // budgets left this frame, shared by all fields
+  int32 ProjectionsLeft = 0;
+  int32 IntegrationStepsLeft = 0;
+
+  FWotFlowFieldCounters Counters;
+
+  double LastTickMicroseconds = 0.0;
+};
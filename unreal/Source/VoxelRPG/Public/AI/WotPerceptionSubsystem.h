@@ -0,0 +1,161 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "WotPerceptionSubsystem.generated.h"
+
+class APawn;
+class AWotAICharacter;
+class UPawnSensingComponent;
+
+USTRUCT(BlueprintType)
+struct FWotPerceptionCounters
+{
+  GENERATED_BODY()
+
+  // Sight updates of single sensors, each sensor updates once per its
+  // sensing interval
+  UPROPERTY(BlueprintReadOnly, Category = "AI")
+  int32 SensorUpdates = 0;
+
+  // (sensor, stimulus) pairs from nearby cells that got the cone test
+  UPROPERTY(BlueprintReadOnly, Category = "AI")
+  int32 CandidatePairs = 0;
+
+  // Pairs inside the sight radius and cone, only these may need a trace
+  UPROPERTY(BlueprintReadOnly, Category = "AI")
+  int32 PairsInCone = 0;
+
+  UPROPERTY(BlueprintReadOnly, Category = "AI")
+  int32 TargetsGained = 0;
+
+  UPROPERTY(BlueprintReadOnly, Category = "AI")
+  int32 TargetsLost = 0;
+};
+
+/*
+ * 	Sight for every AI in one place, replacing the per pawn sight checks of
+ * 	UPawnSensingComponent (which stays on the bots to hold the sight
+ * 	settings). Stimuli are bucketed in a 2D spatial hash each frame; every
+ * 	sensor due for an update only pairs up with the stimuli in the cells its
+ * 	sight radius covers, and all those pairs get the distance and cone test
+ * 	in one pass over flat arrays. Only pairs that pass are checked for line
+ * 	of sight (through UWotVisibilitySubsystem). Sensors are told when their
+ * 	target changes and, like OnSeePawn, every update it stays in sight so
+ * 	they can restore it if it was cleared in the meantime.
+ */
+UCLASS()
+class VOXELRPG_API UWotPerceptionSubsystem : public UTickableWorldSubsystem
+{
+  GENERATED_BODY()
+
+public:
+
+  static UWotPerceptionSubsystem* Get(const UObject* WorldContextObject);
+
+  // Returns the subsystem if wot.Perception.Enabled is on, nullptr otherwise
+  static UWotPerceptionSubsystem* GetIfEnabled(const UObject* WorldContextObject);
+
+  // Sight radius, cone, interval and player filter are read from Config
+  void RegisterSensor(AWotAICharacter* Sensor, const UPawnSensingComponent* Config);
+
+  void UnregisterSensor(AWotAICharacter* Sensor);
+
+  void RegisterStimulus(APawn* Pawn);
+
+  void UnregisterStimulus(APawn* Pawn);
+
+  // The pawn Sensor currently sees, if any
+  APawn* GetSensedTarget(const AWotAICharacter* Sensor) const;
+
+  int32 GetNumSensors() const { return Sensors.Num(); }
+
+  int32 GetNumStimuli() const { return Stimuli.Num(); }
+
+  // Cost of the last update, in microseconds
+  double GetLastTickMicroseconds() const { return LastTickMicroseconds; }
+
+  UFUNCTION(BlueprintCallable, Category = "AI")
+  FWotPerceptionCounters GetCounters() const { return Counters; }
+
+  UFUNCTION(BlueprintCallable, Category = "AI")
+  void ResetCounters();
+
+  virtual void Deinitialize() override;
+
+  virtual void Tick(float DeltaTime) override;
+
+  virtual TStatId GetStatId() const override;
+
+  virtual bool IsTickable() const override { return Sensors.Num() > 0; }
+
+protected:
+
+  void RemoveSensorAt(int32 Index);
+
+  void RemoveStimulusAt(int32 Index);
+
+  // Buckets the live stimuli into Cells
+  void BuildCells(float CellSize);
+
+  // Picks the target of SensorIndex from its pairs [FirstPair, EndPair)
+  APawn* SelectTarget(int32 SensorIndex, int32 FirstPair, int32 EndPair);
+
+  void SetTarget(int32 SensorIndex, APawn* NewTarget);
+
+  // sensors, indexed alike
+  UPROPERTY(Transient)
+  TArray<AWotAICharacter*> Sensors;
+
+  TArray<float> SightRadii;
+  TArray<float> PeripheralCosines;
+  TArray<float> SensingIntervals;
+  TArray<double> NextUpdateTimes;
+  TArray<bool> OnlySensePlayers;
+  TArray<TWeakObjectPtr<APawn>> Targets;
+
+  TMap<const AWotAICharacter*, int32> SensorIndices;
+
+  // stimuli, indexed alike
+  UPROPERTY(Transient)
+  TArray<APawn*> Stimuli;
+
+  TArray<bool> StimulusIsPlayer;
+
+  TMap<const APawn*, int32> StimulusIndices;
+
+  // rebuilt every update
+  TArray<float> StimulusX;
+  TArray<float> StimulusY;
+  TArray<float> StimulusZ;
+  TMap<FIntPoint, TArray<int32>> Cells;
+
+  struct FSensorBatch
+  {
+    int32 SensorIndex = INDEX_NONE;
+    // range of the sensor's pairs in the Pair arrays
+    int32 FirstPair = 0;
+    int32 EndPair = 0;
+  };
+
+  // sensors updated this frame; reused between frames
+  TArray<FSensorBatch> Batches;
+
+  // (sensor, stimulus) pairs of the update, grouped by sensor; reused
+  // between frames
+  TArray<int32> PairStimuli;
+  TArray<float> PairDeltaX;
+  TArray<float> PairDeltaY;
+  TArray<float> PairDeltaZ;
+  TArray<float> PairForwardX;
+  TArray<float> PairForwardY;
+  TArray<float> PairForwardZ;
+  TArray<float> PairRadiiSquared;
+  TArray<float> PairCosines;
+  TArray<float> PairDistancesSquared;
+  TArray<uint8> PairInCone;
+
+  FWotPerceptionCounters Counters;
+
+  double LastTickMicroseconds = 0.0;
+};
@@ -0,0 +1,135 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "WotSpawnPointSubsystem.generated.h"
+
+class ANavigationData;
+
+USTRUCT(BlueprintType)
+struct FWotSpawnPointCacheSettings
+{
+  GENERATED_BODY()
+
+  // Size of a grid cell, each cell holds at most one spawn candidate
+  UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Spawn Points")
+  float CellSize = 400.0f;
+
+  // Cell size is increased if the level would need more cells than this
+  UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Spawn Points")
+  int32 MaxCells = 65536;
+
+  // Candidates closer than this to any player are never returned
+  UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Spawn Points")
+  float MinDistanceFromPlayers = 1500.0f;
+
+  // Candidates further than this from every player are never returned
+  UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Spawn Points")
+  float MaxDistanceFromPlayers = 5000.0f;
+
+  // Height above the navmesh used for the visibility trace
+  UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Spawn Points")
+  float EyeHeight = 90.0f;
+
+  // How long a visibility result stays valid
+  UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Spawn Points")
+  float VisibilityTTL = 1.0f;
+
+  UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Spawn Points")
+  int32 NavProjectionsPerFrame = 64;
+
+  UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Spawn Points")
+  int32 VisibilityChecksPerFrame = 32;
+};
+
+/*
+ * 	Grid of cached spawn candidates for the current level. Every cell caches
+ * 	its navmesh projection and whether it is hidden from the players, both
+ * 	refreshed a few cells per frame. Openables and other dynamic obstacles
+ * 	call InvalidateBounds so only the cells they touch are projected again.
+ */
+UCLASS()
+class VOXELRPG_API UWotSpawnPointSubsystem : public UTickableWorldSubsystem
+{
+  GENERATED_BODY()
+
+public:
+
+  static UWotSpawnPointSubsystem* Get(const UObject* WorldContextObject);
+
+  // Builds the grid over the navigable bounds of the level
+  void BuildGrid(const FWotSpawnPointCacheSettings& InSettings);
+
+  bool IsGridBuilt() const { return NumCellsX > 0 && NumCellsY > 0; }
+
+  // Re-projects every cell overlapping the box, now and once the navmesh
+  // has been rebuilt
+  UFUNCTION(BlueprintCallable, Category = "AI")
+  void InvalidateBounds(const FBox& Bounds);
+
+  // Gets up to MaxCount random cached candidates that are on the navmesh,
+  // hidden from the players and within the distance limits. Returns the
+  // number of locations added.
+  int32 GetSpawnCandidates(int32 MaxCount, TArray<FVector>& OutLocations);
+
+  // Gets every valid navmesh location within Radius of Origin, optionally
+  // only those hidden from the players
+  void GetCachedLocations(const FVector& Origin, float Radius, bool bOnlyHidden, TArray<FVector>& OutLocations) const;
+
+  virtual void Deinitialize() override;
+
+  virtual void Tick(float DeltaTime) override;
+
+  virtual TStatId GetStatId() const override;
+
+  virtual bool IsTickable() const override { return IsGridBuilt(); }
+
+protected:
+
+  static constexpr uint8 CF_Projected = 1 << 0;
+  static constexpr uint8 CF_OnNavMesh = 1 << 1;
+  static constexpr uint8 CF_Hidden = 1 << 2;
+
+  UFUNCTION()
+  void OnNavigationGenerationFinished(ANavigationData* NavData);
+
+  void QueueProjection(int32 CellIndex);
+
+  void ProjectCell(int32 CellIndex);
+
+  void RefreshVisibility();
+
+  void UpdatePlayerViews();
+
+  bool GetCellRange(const FBox& Bounds, FIntPoint& OutMin, FIntPoint& OutMax) const;
+
+  float DistanceSqToNearestPlayer(const FVector& Location) const;
+
+  FWotSpawnPointCacheSettings Settings;
+
+  FVector GridOrigin = FVector::ZeroVector;
+
+  float GridZ = 0.0f;
+
+  float GridHalfHeight = 0.0f;
+
+  int32 NumCellsX = 0;
+
+  int32 NumCellsY = 0;
+
+  // per cell data, indexed by Y * NumCellsX + X
+  TArray<FVector> CellLocations;
+  TArray<uint8> CellFlags;
+  TArray<float> CellVisibilityTime;
+
+  TArray<int32> ProjectionQueue;
+  TBitArray<> CellQueued;
+
+  // cells invalidated since the last navmesh rebuild
+  TSet<int32> CellsAwaitingNavRebuild;
+
+  // cursor into the area around the players for the visibility refresh
+  int32 VisibilityCursor = 0;
+
+  TArray<FVector> PlayerViewLocations;
+};
@@ -0,0 +1,109 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "UObject/ObjectKey.h"
+#include "WotVisibilitySubsystem.generated.h"
+
+USTRUCT(BlueprintType)
+struct FWotVisibilityCounters
+{
+  GENERATED_BODY()
+
+  UPROPERTY(BlueprintReadOnly, Category = "AI")
+  int32 Queries = 0;
+
+  // Queries answered from a result younger than wot.Visibility.TTL
+  UPROPERTY(BlueprintReadOnly, Category = "AI")
+  int32 FreshHits = 0;
+
+  // Queries answered from an older result while it is being refreshed
+  UPROPERTY(BlueprintReadOnly, Category = "AI")
+  int32 StaleHits = 0;
+
+  // Queries for a pair that had no result yet
+  UPROPERTY(BlueprintReadOnly, Category = "AI")
+  int32 Misses = 0;
+
+  UPROPERTY(BlueprintReadOnly, Category = "AI")
+  int32 TracesIssued = 0;
+
+  // Most pairs waiting for a trace at once
+  UPROPERTY(BlueprintReadOnly, Category = "AI")
+  int32 PeakQueued = 0;
+};
+
+/*
+ * 	Shared line of sight cache for AI queries. Results are kept per
+ * 	(observer, target) pair and answered from the cache; a result older than
+ * 	wot.Visibility.TTL is still returned but queues a refresh. Queued pairs
+ * 	are traced as async line traces, at most wot.Visibility.MaxTracesPerFrame
+ * 	per frame, so a crowd of minions watching the player costs a bounded
+ * 	number of traces per frame instead of one per service tick each.
+ */
+UCLASS()
+class VOXELRPG_API UWotVisibilitySubsystem : public UTickableWorldSubsystem
+{
+  GENERATED_BODY()
+
+public:
+
+  static UWotVisibilitySubsystem* Get(const UObject* WorldContextObject);
+
+  // Returns the subsystem if wot.Visibility.UseCache is on, nullptr otherwise
+  static UWotVisibilitySubsystem* GetIfEnabled(const UObject* WorldContextObject);
+
+  // Whether nothing blocks the line from Observer's eyes to Target; false
+  // until the first trace of a new pair is done
+  bool HasLineOfSight(const AActor* Observer, const AActor* Target);
+
+  int32 GetNumCached() const { return Entries.Num(); }
+
+  int32 GetNumQueued() const { return Queue.Num(); }
+
+  UFUNCTION(BlueprintCallable, Category = "AI")
+  FWotVisibilityCounters GetCounters() const { return Counters; }
+
+  UFUNCTION(BlueprintCallable, Category = "AI")
+  void ResetCounters();
+
+  virtual void Deinitialize() override;
+
+  virtual void Tick(float DeltaTime) override;
+
+  virtual TStatId GetStatId() const override;
+
+  virtual bool IsTickable() const override { return Entries.Num() > 0; }
+
+protected:
+
+  using FVisibilityKey = TPair<TObjectKey<AActor>, TObjectKey<AActor>>;
+
+  struct FVisibilityEntry
+  {
+    TWeakObjectPtr<const AActor> Observer;
+    TWeakObjectPtr<const AActor> Target;
+    // world time of the trace the result is from, negative if none yet
+    double TraceTime = -1.0;
+    double LastQueryTime = 0.0;
+    bool bVisible = false;
+    // waiting in Queue or for its trace
+    bool bQueued = false;
+  };
+
+  void IssueTraces();
+
+  void OnTraceDone(const TArray<FHitResult>& Hits, FVisibilityKey Key);
+
+  // drops pairs nobody asked about for a while
+  void EvictUnused(double Now);
+
+  TMap<FVisibilityKey, FVisibilityEntry> Entries;
+
+  // pairs waiting for a trace, oldest first
+  TArray<FVisibilityKey> Queue;
+
+  double NextEvictTime = 0.0;
+
+  FWotVisibilityCounters Counters;
+};
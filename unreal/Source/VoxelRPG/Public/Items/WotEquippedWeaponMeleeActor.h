@@ -41,6 +41,9 @@ public:
 
     virtual void AttackSweep();
 
+    // Applies the weapon's damage to everything the attack sweep hit
+    virtual void OnAttackSweepDone(const TArray<FHitResult>& Hits, FVector OwnerLocation, FVector End, FQuat OwnerRotation);
+
     virtual void PrimaryAttackStart_Implementation() override;
 
     virtual void PrimaryAttackStop_Implementation() override;
@@ -3,6 +3,7 @@
 
 #include "CoreMinimal.h"
 #include "GameFramework/Actor.h"
+#include "WotPoolableInterface.h"
 #include "WotItemActor.generated.h"
 
 class UStaticMeshComponent;
@@ -14,7 +15,7 @@ class UWotItem;
  * 	that the item can interact with the world.
  */
 UCLASS()
-class VOXELRPG_API AWotItemActor : public AActor
+class VOXELRPG_API AWotItemActor : public AActor, public IWotPoolableInterface
 {
 	GENERATED_BODY()
 
@@ -27,6 +28,10 @@ public:
 
 	AWotItemActor();
 
+    virtual void OnAcquiredFromPool_Implementation() override;
+
+    virtual void OnReleasedToPool_Implementation() override;
+
 protected:
     UPROPERTY(VisibleAnywhere, BlueprintReadOnly)
     UStaticMeshComponent* Mesh;
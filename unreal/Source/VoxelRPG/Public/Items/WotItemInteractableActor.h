@@ -6,9 +6,11 @@
 #include "Items/WotItemActor.h"
 #include "WotGameplayInterface.h"
 #include "WotInteractableInterface.h"
+#include "WotTimingWheelSubsystem.h"
 #include "WotItemInteractableActor.generated.h"
 
 class APawn;
+class UInstancedStaticMeshComponent;
 
 /*
  * 	Subclass of AWotItemActor which also implements IWotInteractableInterface -
@@ -32,9 +34,29 @@ public:
 
     virtual void SetHighlightEnabled(int HighlightValue, bool Enabled);
 
+    virtual void SetItem(UWotItem* NewItem) override;
+
+    virtual void OnReleasedToPool_Implementation() override;
+
 	AWotItemInteractableActor();
 
 protected:
-    FTimerHandle HighlightTimerHandle;
+
+    // Extra copies of the mesh scattered around the main one to show that
+    // this pickup is a stack; only visual
+    UPROPERTY(VisibleAnywhere, BlueprintReadOnly)
+    UInstancedStaticMeshComponent* ScatterMesh;
+
+    // Maximum number of extra copies shown for a stack (0 = none)
+    UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, Category = "Items")
+    int32 MaxScatterInstances = 8;
+
+    UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, Category = "Items")
+    float ScatterRadius = 20.0f;
+
+    // Updates the scatter instances to match the item count
+    void UpdateScatter();
+
+    FWotTimerHandle HighlightTimerHandle;
     void OnHighlightTimerExpired();
 };
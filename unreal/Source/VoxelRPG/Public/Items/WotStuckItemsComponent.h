@@ -0,0 +1,94 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/ActorComponent.h"
+#include "WotGameplayInterface.h"
+#include "WotInteractableInterface.h"
+#include "WotTimingWheelSubsystem.h"
+#include "WotStuckItemsComponent.generated.h"
+
+class UInstancedStaticMeshComponent;
+class UPrimitiveComponent;
+class UWotAttributeComponent;
+class UWotItem;
+
+// All items of one class stuck into the same component / bone
+USTRUCT()
+struct FWotStuckItemGroup
+{
+  GENERATED_BODY()
+
+  UPROPERTY()
+  TSubclassOf<UWotItem> ItemClass;
+
+  UPROPERTY()
+  UInstancedStaticMeshComponent* Instances = nullptr;
+
+  UPROPERTY()
+  TWeakObjectPtr<UPrimitiveComponent> AttachComponent;
+
+  UPROPERTY()
+  FName BoneName;
+};
+
+/*
+ * 	Items (e.g. arrows) stuck into an actor, drawn as instances of one
+ * 	instanced static mesh per item class and attach point instead of one
+ * 	AWotItemInteractableActor each. Added to the hit actor on demand and
+ * 	interacted with as a whole to pick up everything at once. If the owner
+ * 	is killed or destroyed, the items are dropped as one pickup per class.
+ */
+UCLASS( ClassGroup=(Custom), meta=(BlueprintSpawnableComponent) )
+class VOXELRPG_API UWotStuckItemsComponent : public UActorComponent, public IWotInteractableInterface, public IWotGameplayInterface
+{
+  GENERATED_BODY()
+
+public:
+
+  // Sticks one ItemClass item into Target at the given world transform,
+  // adding the component to Target if needed. Returns false if the item
+  // should be spawned as an actor instead, which is always the case for
+  // targets that don't pass interaction through to the component.
+  static bool AddStuckItem(AActor* Target, UPrimitiveComponent* HitComponent, FName BoneName, TSubclassOf<UWotItem> ItemClass, const FTransform& WorldTransform);
+
+  UFUNCTION(BlueprintCallable, Category = "Items")
+  int32 GetNumStuckItems() const;
+
+  // Spawns one pickup per item class at the owner and removes all instances
+  UFUNCTION(BlueprintCallable, Category = "Items")
+  void DropAll();
+
+  virtual void Interact_Implementation(APawn* InstigatorPawn, FHitResult Hit) override;
+
+  virtual void GetInteractionText_Implementation(APawn* InstigatorPawn, FHitResult Hit, FText& OutText) override;
+
+  virtual void Highlight_Implementation(FHitResult Hit, int HighlightValue, float Duration) override;
+
+  virtual void Unhighlight_Implementation(FHitResult Hit) override;
+
+protected:
+
+  virtual void BeginPlay() override;
+
+  virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+  UFUNCTION()
+  void OnOwnerKilled(AActor* InstigatorActor, UWotAttributeComponent* OwningComp);
+
+  FWotStuckItemGroup& FindOrAddGroup(UPrimitiveComponent* AttachComponent, FName BoneName, TSubclassOf<UWotItem> ItemClass);
+
+  // Removes up to Count instances of ItemClass, returns how many were removed
+  int32 RemoveItems(TSubclassOf<UWotItem> ItemClass, int32 Count);
+
+  int32 GetNumStuckItemsOfClass(TSubclassOf<UWotItem> ItemClass) const;
+
+  void GetItemClasses(TArray<TSubclassOf<UWotItem>>& OutItemClasses) const;
+
+  void SetHighlightEnabled(int HighlightValue, bool Enabled);
+
+  UPROPERTY()
+  TArray<FWotStuckItemGroup> Groups;
+
+  FWotTimerHandle HighlightTimerHandle;
+  void OnHighlightTimerExpired();
+};
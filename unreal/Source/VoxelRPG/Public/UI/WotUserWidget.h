@@ -2,6 +2,7 @@
 
 #include "CoreMinimal.h"
 #include "Blueprint/UserWidget.h"
+#include "WotTimingWheelSubsystem.h"
 #include "WotUserWidget.generated.h"
 
 // We make the class abstract, as we don't want to create
@@ -38,8 +39,8 @@ protected:
 
     TWeakObjectPtr<AActor> AttachTo;
 
-    UPROPERTY()
-	FTimerHandle TimerHandle_Remove;
+	FWotTimerHandle TimerHandle_Remove;
+
     UFUNCTION()
 	void Remove_TimeElapsed();
 };
@@ -0,0 +1,70 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DataAsset.h"
+#include "WotWildlifeSpecies.generated.h"
+
+class UStaticMesh;
+class AWotAICharacter;
+
+/*
+ * 	An animal species of the ambient wildlife (sheep, deer, horses, foxes,
+ * 	...). Herds of it are simulated as mass entities by
+ * 	UWotWildlifeSubsystem, drawn as instances of Mesh and turned into a
+ * 	CharacterClass bot when a player comes close or hits one.
+ */
+UCLASS(BlueprintType)
+class VOXELRPG_API UWotWildlifeSpecies : public UPrimaryDataAsset
+{
+  GENERATED_BODY()
+
+public:
+
+  // Drawn for animals between PromoteRadius and VisibleRadius
+  UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Visuals")
+  UStaticMesh* Mesh = nullptr;
+
+  // Full character the animal becomes near the players, with its
+  // attributes and the inventory it drops
+  UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Visuals")
+  TSubclassOf<AWotAICharacter> CharacterClass;
+
+  UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Visuals")
+  float PromoteRadius = 2500.0f;
+
+  // Extra distance before a promoted animal goes back to being an entity
+  UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Visuals")
+  float DemoteHysteresis = 500.0f;
+
+  UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Visuals")
+  float VisibleRadius = 15000.0f;
+
+  UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Movement")
+  float WalkSpeed = 120.0f;
+
+  UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Movement")
+  float RunSpeed = 600.0f;
+
+  // How far from where it was spawned the animal wanders
+  UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Behavior")
+  float WanderRadius = 2000.0f;
+
+  // Chance to forage instead of wandering off when a behavior ends
+  UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Behavior", meta = (ClampMin = "0.0", ClampMax = "1.0"))
+  float ForageChance = 0.5f;
+
+  UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Behavior")
+  FVector2D ForageDuration = FVector2D(4.0f, 10.0f);
+
+  // Give up on a wander goal after this long
+  UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Behavior")
+  float WanderTimeout = 15.0f;
+
+  // Players closer than this frighten the animal
+  UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Behavior")
+  float FleeRadius = 1500.0f;
+
+  // How far the animal runs from what frightened it
+  UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Behavior")
+  float FleeDistance = 2500.0f;
+};
@@ -0,0 +1,198 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "MassEntityTypes.h"
+#include "MassArchetypeTypes.h"
+#include "WotWildlifeSubsystem.generated.h"
+
+class AWotAICharacter;
+class UInstancedStaticMeshComponent;
+class UMassProcessor;
+class UWotWildlifeSpecies;
+struct FMassCommandBuffer;
+struct FMassEntityManager;
+
+USTRUCT(BlueprintType)
+struct FWotWildlifeCounters
+{
+  GENERATED_BODY()
+
+  UPROPERTY(BlueprintReadOnly, Category = "Wildlife")
+  int32 Spawned = 0;
+
+  UPROPERTY(BlueprintReadOnly, Category = "Wildlife")
+  int32 Promotions = 0;
+
+  UPROPERTY(BlueprintReadOnly, Category = "Wildlife")
+  int32 Demotions = 0;
+
+  // Promoted animals that died and were removed from the simulation
+  UPROPERTY(BlueprintReadOnly, Category = "Wildlife")
+  int32 Killed = 0;
+
+  UPROPERTY(BlueprintReadOnly, Category = "Wildlife")
+  int32 GroundTraces = 0;
+
+  // Instances drawn in the last update
+  UPROPERTY(BlueprintReadOnly, Category = "Wildlife")
+  int32 InstancesDrawn = 0;
+};
+
+/*
+ * 	Ambient wildlife herds as mass entities instead of one AWotAICharacter
+ * 	per animal. Animals wander around where their herd was spawned, forage
+ * 	and flee from nearby players, all in batched processors over the entity
+ * 	chunks that this subsystem runs every frame. Animals within a species'
+ * 	VisibleRadius are drawn as instanced static meshes; within its
+ * 	PromoteRadius, or when hit (see ResolveHitActor), an animal is promoted
+ * 	to a pooled CharacterClass bot with attributes and an inventory to drop,
+ * 	and goes back to being an entity once the players are far enough away.
+ */
+UCLASS()
+class VOXELRPG_API UWotWildlifeSubsystem : public UTickableWorldSubsystem
+{
+  GENERATED_BODY()
+
+  friend class UWotWildlifeBehaviorProcessor;
+  friend class UWotWildlifeMovementProcessor;
+  friend class UWotWildlifeRepresentationProcessor;
+
+public:
+
+  static UWotWildlifeSubsystem* Get(const UObject* WorldContextObject);
+
+  // Returns the subsystem if wot.Wildlife.Enabled is on, nullptr otherwise
+  static UWotWildlifeSubsystem* GetIfEnabled(const UObject* WorldContextObject);
+
+  // Spawns Count animals of HerdSpecies within Radius of Center, placed on
+  // the ground below; returns how many were spawned
+  UFUNCTION(BlueprintCallable, Category = "Wildlife")
+  int32 SpawnHerd(UWotWildlifeSpecies* HerdSpecies, FVector Center, int32 Count, float Radius);
+
+  // Removes every animal, promoted ones included
+  UFUNCTION(BlueprintCallable, Category = "Wildlife")
+  void DespawnAll();
+
+  // When Hit is on an animal instance, promotes it and returns its
+  // character so damage goes to it; returns HitActor otherwise
+  static AActor* ResolveHitActor(AActor* HitActor, const FHitResult& Hit);
+
+  // Spawns Count animals of a temporary species and steps only their
+  // behavior and movement Frames times, without promoting or drawing
+  // anything, then removes them and the species again; the live herds are
+  // left alone. Returns the average cost of a step in microseconds
+  double RunBench(int32 Count, int32 Frames);
+
+  int32 GetNumEntities() const { return Entities.Num(); }
+
+  int32 GetNumPromoted() const { return NumPromoted; }
+
+  // Cost of the last update, in microseconds
+  double GetLastTickMicroseconds() const { return LastTickMicroseconds; }
+
+  UFUNCTION(BlueprintCallable, Category = "Wildlife")
+  FWotWildlifeCounters GetCounters() const { return Counters; }
+
+  UFUNCTION(BlueprintCallable, Category = "Wildlife")
+  void ResetCounters();
+
+  virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+
+  virtual void Deinitialize() override;
+
+  virtual void Tick(float DeltaTime) override;
+
+  virtual TStatId GetStatId() const override;
+
+  virtual bool IsTickable() const override { return Entities.Num() > 0; }
+
+protected:
+
+  // Bench animals are tagged with FWotWildlifeBenchTag and not placed on
+  // the ground
+  int32 SpawnEntities(UWotWildlifeSpecies* HerdSpecies, const FVector& Center, int32 Count, float Radius, bool bBench, TArray<FMassEntityHandle>* OutEntities = nullptr);
+
+  // Removes the animals, releasing the characters of promoted ones
+  void DespawnEntities(TConstArrayView<FMassEntityHandle> EntitiesToRemove);
+
+  int32 RegisterSpecies(UWotWildlifeSpecies* NewSpecies);
+
+  // Only the last registered species can go, the animals of the others
+  // keep their index
+  void UnregisterLastSpecies(UWotWildlifeSpecies* LastSpecies);
+
+  UWotWildlifeSpecies* GetSpecies(int32 SpeciesIndex) const { return Species.IsValidIndex(SpeciesIndex) ? Species[SpeciesIndex] : nullptr; }
+
+  // Runs the processors of the live animals, representation included, or
+  // those of the bench animals if bBench
+  void Simulate(float DeltaTime, bool bBench);
+
+  FMassEntityManager* GetEntityManager() const;
+
+  // Spawns the character of an animal and tags it as promoted; Health is
+  // what it had when last demoted, negative for full health. The character
+  // is kept out of the bot registry so it doesn't count as an enemy
+  AWotAICharacter* Promote(FMassEntityHandle Entity, int32 SpeciesIndex, const FVector& Location, float Yaw, float Health, FMassCommandBuffer& CommandBuffer);
+
+  // Releases the character of an animal, which continues from where the
+  // character was
+  void Demote(FMassEntityHandle Entity, AWotAICharacter* Actor, FMassCommandBuffer& CommandBuffer);
+
+  // Removes an animal whose character died
+  void RemoveKilled(FMassEntityHandle Entity, FMassCommandBuffer& CommandBuffer);
+
+  // Queues an instance to draw in the next FlushInstances
+  void AddInstance(int32 SpeciesIndex, FMassEntityHandle Entity, const FTransform& Transform);
+
+  // Whether another ground trace fits in this frame's budget
+  bool TryUseGroundTrace();
+
+  // Moves the instanced meshes to the queued instances
+  void FlushInstances();
+
+  UInstancedStaticMeshComponent* GetOrCreateInstanceComp(int32 SpeciesIndex);
+
+  UPROPERTY(Transient)
+  TArray<UWotWildlifeSpecies*> Species;
+
+  // run in order each frame
+  UPROPERTY(Transient)
+  TArray<UMassProcessor*> SimulationProcessors;
+
+  UPROPERTY(Transient)
+  UMassProcessor* RepresentationProcessor = nullptr;
+
+  // simulation processors of the bench animals, made by the first RunBench
+  UPROPERTY(Transient)
+  TArray<UMassProcessor*> BenchProcessors;
+
+  // owner of the instanced meshes, one per species
+  UPROPERTY(Transient)
+  AActor* InstanceHost = nullptr;
+
+  UPROPERTY(Transient)
+  TArray<UInstancedStaticMeshComponent*> InstanceComps;
+
+  // per species, instance transforms and the entities they are of, in the
+  // order of the instances
+  TArray<TArray<FTransform>> InstanceTransforms;
+  TArray<TArray<FMassEntityHandle>> InstanceEntities;
+
+  FMassArchetypeHandle Archetype;
+
+  FMassArchetypeHandle BenchArchetype;
+
+  TSet<FMassEntityHandle> Entities;
+
+  int32 NumPromoted = 0;
+
+  // player pawn locations, updated before the processors run
+  TArray<FVector> ThreatLocations;
+
+  int32 GroundTracesLeft = 0;
+
+  FWotWildlifeCounters Counters;
+
+  double LastTickMicroseconds = 0.0;
+};
@@ -5,11 +5,26 @@
 #include "CoreMinimal.h"
 #include "UObject/NoExportTypes.h"
 #include "GameplayTagContainer.h"
+#include "WotGameplayTagMask.h"
+#include "WotTimingWheelSubsystem.h"
 #include "WotAction.generated.h"
 
 class UWorld;
 class UWotActionComponent;
 
+UENUM(BlueprintType)
+enum class EWotActionPhase : uint8
+{
+  // Not running
+  None,
+  // Running up to the effect, e.g. drawing the bow
+  Windup,
+  // The effect itself
+  Active,
+  // Running after the effect until the action stops
+  Recovery
+};
+
 UCLASS(Blueprintable)
 class VOXELRPG_API UWotAction : public UObject
 {
@@ -35,6 +50,70 @@ protected:
     UPROPERTY(EditDefaultsOnly, Category = "Tags")
     FGameplayTagContainer RequiredTags;
 
+    // BlockedTags and RequiredTags as masks, built on the first CanStart
+    FWotGameplayTagMask BlockedTagMask;
+    FWotGameplayTagMask RequiredTagMask;
+    bool bTagMasksBuilt = false;
+
+    // Paid from the owner's attributes when the action starts; it can't
+    // start without enough
+    UPROPERTY(EditDefaultsOnly, Category = "Cost")
+    float StaminaCost = 0.0f;
+
+    UPROPERTY(EditDefaultsOnly, Category = "Cost")
+    float MagicCost = 0.0f;
+
+    // Drained while the action runs (e.g. sprint), which stops it when
+    // stamina runs out
+    UPROPERTY(EditDefaultsOnly, Category = "Cost")
+    float StaminaCostPerSecond = 0.0f;
+
+    FWotTimerHandle TimerHandle_StaminaDepleted;
+
+    void StaminaDepleted_TimeElapsed(TWeakObjectPtr<AActor> Instigator);
+
+    void SetStaminaDepletedTimer(AActor* Instigator);
+
+    // Seconds from start until the Active phase, 0 starts Active immediately
+    UPROPERTY(EditDefaultsOnly, Category = "Timing", meta = (ClampMin = "0"))
+    float WindupDuration = 0.0f;
+
+    // Stop on its own after the Active and Recovery phases, otherwise the
+    // action stays Active until stopped
+    UPROPERTY(EditDefaultsOnly, Category = "Timing")
+    bool bAutoStop = false;
+
+    UPROPERTY(EditDefaultsOnly, Category = "Timing", meta = (ClampMin = "0", EditCondition = "bAutoStop"))
+    float ActiveDuration = 0.0f;
+
+    UPROPERTY(EditDefaultsOnly, Category = "Timing", meta = (ClampMin = "0", EditCondition = "bAutoStop"))
+    float RecoveryDuration = 0.0f;
+
+    // Seconds after stopping before the action can start again
+    UPROPERTY(EditDefaultsOnly, Category = "Timing", meta = (ClampMin = "0"))
+    float Cooldown = 0.0f;
+
+    // Called when the action enters Windup, Active or Recovery
+    UFUNCTION(BlueprintNativeEvent, Category = "Action")
+    void OnPhaseStarted(AActor* Instigator, EWotActionPhase NewPhase);
+
+    virtual void OnPhaseStarted_Implementation(AActor* Instigator, EWotActionPhase NewPhase);
+
+    void EnterPhase(EWotActionPhase NewPhase);
+
+    // Phase boundaries are events on the timing wheel, never ticks
+    void PhaseElapsed();
+
+    FWotTimerHandle TimerHandle_Phase;
+
+    TWeakObjectPtr<AActor> RunningInstigator;
+
+    UPROPERTY(VisibleAnywhere, Category = "Action")
+    EWotActionPhase Phase = EWotActionPhase::None;
+
+    // World time when the cooldown is over
+    double CooldownEndTime = 0.0;
+
     UPROPERTY(VisibleAnywhere, Category = "Action")
     bool bIsRunning;
 
@@ -45,6 +124,13 @@ public:
     UFUNCTION(BlueprintCallable, Category = "Action")
     bool IsRunning() const;
 
+    UFUNCTION(BlueprintCallable, Category = "Action")
+    EWotActionPhase GetPhase() const;
+
+    // Seconds until the action can start again, 0 if it isn't cooling down
+    UFUNCTION(BlueprintCallable, Category = "Action")
+    float GetCooldownRemaining() const;
+
     UFUNCTION(BlueprintCallable, BlueprintNativeEvent, Category = "Action")
     bool CanStart(AActor* Instigator);
 
@@ -5,6 +5,7 @@
 #include "CoreMinimal.h"
 #include "Components/ActorComponent.h"
 #include "GameplayTagContainer.h"
+#include "WotGameplayTagMask.h"
 #include "WotActionComponent.generated.h"
 
 class UWotAction;
@@ -19,9 +20,24 @@ public:
     UFUNCTION(BlueprintCallable, Category = "Actions")
     static UWotActionComponent* GetActions(AActor* FromActor);
 
-    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Actions")
+    // Change through AddGameplayTags / RemoveGameplayTags so the tag mask
+    // used by UWotAction::CanStart is rebuilt
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Actions")
     FGameplayTagContainer ActiveGameplayTags;
 
+    UFUNCTION(BlueprintCallable, Category = "Actions")
+    void AddGameplayTags(const FGameplayTagContainer& Tags);
+
+    UFUNCTION(BlueprintCallable, Category = "Actions")
+    void RemoveGameplayTags(const FGameplayTagContainer& Tags);
+
+    void AddGameplayTag(const FGameplayTag& Tag);
+
+    void RemoveGameplayTag(const FGameplayTag& Tag);
+
+    // Bits of the active tags, only rebuilt after the tags changed
+    const FWotGameplayTagMask& GetActiveTagMask() const;
+
     UFUNCTION(BlueprintCallable, Category = "Actions")
     void AddAction(TSubclassOf<UWotAction> Action);
 
@@ -38,6 +54,15 @@ protected:
     // Called when the game starts
     virtual void BeginPlay() override;
 
+    // Actions by ActionName, in the order they were added
+    TMap<FName, TArray<UWotAction*, TInlineAllocator<1>>> ActionsByName;
+
+    mutable FWotGameplayTagMask ActiveTagMask;
+
+    // FWotGameplayTagMask::GetGeneration() when ActiveTagMask was built, 0
+    // when the tags changed since
+    mutable uint32 ActiveTagMaskGeneration = 0;
+
 public:
 
     virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
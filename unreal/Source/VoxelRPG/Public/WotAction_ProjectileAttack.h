@@ -26,17 +26,14 @@ protected:
 	UPROPERTY(VisibleAnywhere, Category = "Attack")
 	FName HandSocketName;
 
-	UPROPERTY(EditDefaultsOnly, Category = "Attack")
-	float AttackAnimDelay;
-
 	UPROPERTY(EditAnywhere, Category = "Attack")
 	UAnimMontage* AttackAnim;
 
 	UPROPERTY(EditAnywhere, Category = "Attack")
 	UNiagaraSystem* CastingNiagaraSystem;
 
-	UFUNCTION()
-	void AttackDelay_TimerElapsed(ACharacter* InstigatorCharacter);
+	// Launches the projectile when the windup is over
+	virtual void OnPhaseStarted_Implementation(AActor* Instigator, EWotActionPhase NewPhase) override;
 
 public:
 
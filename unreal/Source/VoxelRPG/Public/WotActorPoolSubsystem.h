@@ -0,0 +1,77 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Engine/World.h"
+#include "WotActorPoolSubsystem.generated.h"
+
+USTRUCT()
+struct FWotActorPool
+{
+  GENERATED_BODY()
+
+  UPROPERTY(Transient)
+  TArray<AActor*> FreeActors;
+};
+
+/*
+ * 	Keeps released actors around (hidden, without collision and ticking) so
+ * 	they can be reused instead of spawning new ones. Only classes implementing
+ * 	IWotPoolableInterface are pooled; everything else falls back to normal
+ * 	spawning and destroying, so call sites can always go through the pool.
+ */
+UCLASS()
+class VOXELRPG_API UWotActorPoolSubsystem : public UWorldSubsystem
+{
+  GENERATED_BODY()
+
+public:
+
+  static UWotActorPoolSubsystem* Get(const UObject* WorldContextObject);
+
+  // Spawns an actor of the class, reusing a pooled one if available
+  AActor* AcquireActor(UClass* ActorClass, const FTransform& Transform, const FActorSpawnParameters& SpawnParams = FActorSpawnParameters());
+
+  template<typename T>
+  T* AcquireActor(UClass* ActorClass, const FTransform& Transform, const FActorSpawnParameters& SpawnParams = FActorSpawnParameters())
+  {
+    return Cast<T>(AcquireActor(ActorClass, Transform, SpawnParams));
+  }
+
+  // Puts the actor back in its pool, or destroys it if it isn't pooled
+  UFUNCTION(BlueprintCallable, Category = "Pooling")
+  void ReleaseActor(AActor* Actor);
+
+  // Spawns actors up front so the first uses don't have to
+  UFUNCTION(BlueprintCallable, Category = "Pooling")
+  void Prewarm(TSubclassOf<AActor> ActorClass, int32 Count);
+
+  UFUNCTION(BlueprintCallable, Category = "Pooling")
+  int32 GetNumFree(TSubclassOf<AActor> ActorClass) const;
+
+  // Convenience wrappers which fall back to spawning / destroying when there
+  // is no pool for the world
+  static AActor* SpawnPooled(const UObject* WorldContextObject, UClass* ActorClass, const FTransform& Transform, const FActorSpawnParameters& SpawnParams = FActorSpawnParameters());
+
+  template<typename T>
+  static T* SpawnPooled(const UObject* WorldContextObject, UClass* ActorClass, const FTransform& Transform, const FActorSpawnParameters& SpawnParams = FActorSpawnParameters())
+  {
+    return Cast<T>(SpawnPooled(WorldContextObject, ActorClass, Transform, SpawnParams));
+  }
+
+  static void ReleasePooled(AActor* Actor);
+
+protected:
+
+  bool CanPool(const UClass* ActorClass) const;
+
+  void ActivateActor(AActor* Actor, const FTransform& Transform, const FActorSpawnParameters& SpawnParams);
+
+  void DeactivateActor(AActor* Actor);
+
+  UPROPERTY(Transient)
+  TMap<UClass*, FWotActorPool> Pools;
+
+  // every actor the pool spawned, whether it is in use or free
+  TSet<TWeakObjectPtr<AActor>> ManagedActors;
+};
@@ -19,6 +19,8 @@ public:
 
   AWotArrowProjectile();
 
+  virtual void OnAcquiredFromPool_Implementation() override;
+
 protected:
 
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Item")
@@ -4,11 +4,55 @@
 
 #include "CoreMinimal.h"
 #include "Components/ActorComponent.h"
+#include "WotTimingWheelSubsystem.h"
 #include "WotAttributeComponent.generated.h"
 
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnKilled, AActor*, InstigatorActor, UWotAttributeComponent*, OwningComp);
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_FourParams(FOnHealthChanged, AActor*, InstigatorActor, UWotAttributeComponent*, OwningComp, float, NewHealth, float, Delta);
 
+// Attributes whose value is the base value with modifiers applied
+UENUM(BlueprintType)
+enum class EWotAttribute : uint8
+{
+  HealthMax,
+  StaminaMax,
+  StrengthMax,
+  MagicMax,
+  Defense,
+  MAX UMETA(Hidden)
+};
+
+UENUM(BlueprintType)
+enum class EWotModifierOp : uint8
+{
+  // Added to the base value
+  Add,
+  // Multiplies the base value plus all additions
+  Multiply,
+  // Replaces the value, the most recently added override wins
+  Override
+};
+
+USTRUCT(BlueprintType)
+struct FWotAttributeModifier
+{
+  GENERATED_BODY()
+
+  UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Attributes")
+  EWotAttribute Attribute = EWotAttribute::HealthMax;
+
+  UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Attributes")
+  EWotModifierOp Op = EWotModifierOp::Add;
+
+  UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Attributes")
+  float Value = 0.0f;
+
+  // what added the modifier (armor item, status effect, ...), used to
+  // remove it again
+  UPROPERTY(Transient)
+  TWeakObjectPtr<UObject> Source;
+};
+
 UCLASS( ClassGroup=(Custom), EditInlineNew, meta=(BlueprintSpawnableComponent) )
 class VOXELRPG_API UWotAttributeComponent : public UActorComponent
 {
@@ -39,11 +83,20 @@ protected:
     UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Attributes")
     float StunDuration = 1.0f;
 
-	FTimerHandle TimerHandle_Stunned;
+	FWotTimerHandle TimerHandle_Stunned;
 
     void Stunned_TimeElapsed();
 
-    UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Attributes")
+    bool ChangeHealth(AActor* InstigatorActor, float Delta, bool bUpdateStun);
+
+    // Sets health, clamped to the max, and raises OnHealthChanged and
+    // OnKilled for it; returns the actual change
+    float SetHealth(AActor* InstigatorActor, float NewHealth);
+
+    // Stamina as of StaminaUpdateTime; regeneration since then is only added
+    // on read (GetStamina) and stored when stamina is changed, so it is not
+    // exposed to blueprints directly
+    UPROPERTY(EditDefaultsOnly, Category = "Attributes")
     float Stamina;
 
     UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Attributes")
@@ -55,17 +108,75 @@ protected:
     UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Attributes")
     float StrengthMax = 100.0f;
 
-    UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Attributes")
+    // Magic as of MagicUpdateTime, see Stamina
+    UPROPERTY(EditDefaultsOnly, Category = "Attributes")
     float Magic;
 
     UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Attributes")
     float MagicMax = 100.0f;
 
+    // Stamina regained per second
+    UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Regeneration")
+    float StaminaRegenRate = 10.0f;
+
+    // Magic regained per second
+    UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Regeneration")
+    float MagicRegenRate = 2.0f;
+
+    // Sum of the active drains (e.g. sprinting), per second
+    float StaminaDrainRate = 0.0f;
+
+    // World time at which Stamina and Magic were last stored
+    double StaminaUpdateTime = 0.0;
+    double MagicUpdateTime = 0.0;
+
+    double GetTimeSeconds() const;
+
+    // Stores the regenerated value so the rate or max can change from now on
+    void UpdateStamina();
+    void UpdateMagic();
+
+    // Base defense before armor and effects
+    UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Attributes")
+    float Defense = 0.0f;
+
+    // Defense at which hits do half damage; damage is scaled by
+    // DefenseForHalfDamage / (DefenseForHalfDamage + Defense)
+    UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Attributes", meta = (ClampMin = "1"))
+    float DefenseForHalfDamage = 100.0f;
+
+    // Health change of a hit or kill, subject to the stun but not to defense
+    bool ApplyUnmitigatedHealthChange(AActor* InstigatorActor, float Delta);
+
+    float GetBaseValue(EWotAttribute Attribute) const;
+
+    void MarkAttributeDirty(EWotAttribute Attribute);
+
+    // Active modifiers of all attributes, in the order they were added
+    UPROPERTY(Transient)
+    TArray<FWotAttributeModifier> Modifiers;
+
+    // Final attribute values, only recomputed from the modifiers when the
+    // attribute's bit in DirtyAttributes is set
+    mutable float CachedValues[(int32)EWotAttribute::MAX];
+
+    mutable float CachedBaseValues[(int32)EWotAttribute::MAX];
+
+    mutable uint32 DirtyAttributes = ~0u;
+
 public:
 
     UFUNCTION(BlueprintCallable)
     bool Kill(AActor* InstigatorActor);
 
+    // Restores health, stamina and magic to their max and clears any stun
+    UFUNCTION(BlueprintCallable, Category = "Attributes")
+    void ResetAttributes();
+
+    // Sets health without raising any events, to restore what was kept
+    // while the owner was pooled (e.g. a demoted animal)
+    void RestoreHealth(float NewHealth);
+
     UFUNCTION(BlueprintCallable)
     float GetHealth() const;
 
@@ -87,6 +198,38 @@ public:
     UFUNCTION(BlueprintCallable)
     float GetMagicMax() const;
 
+    UFUNCTION(BlueprintCallable)
+    float GetStamina() const;
+
+    UFUNCTION(BlueprintCallable)
+    float GetStaminaMax() const;
+
+    // Regeneration minus active drains, per second
+    UFUNCTION(BlueprintCallable)
+    float GetStaminaRate() const;
+
+    // Seconds until the active drains empty stamina, negative if it isn't
+    // draining
+    UFUNCTION(BlueprintCallable)
+    float GetSecondsUntilStaminaDepleted() const;
+
+    UFUNCTION(BlueprintCallable)
+    float GetStrengthMax() const;
+
+    UFUNCTION(BlueprintCallable)
+    float GetDefense() const;
+
+    // Base value of Attribute with all its modifiers applied
+    UFUNCTION(BlueprintCallable, Category = "Attributes")
+    float GetAttributeValue(EWotAttribute Attribute) const;
+
+    UFUNCTION(BlueprintCallable, Category = "Attributes")
+    void AddModifier(EWotAttribute Attribute, EWotModifierOp Op, float Value, UObject* Source);
+
+    // Removes every modifier added by Source, returns how many were removed
+    UFUNCTION(BlueprintCallable, Category = "Attributes")
+    int32 RemoveModifiersFromSource(UObject* Source);
+
     UPROPERTY(BlueprintAssignable)
     FOnHealthChanged OnHealthChanged;
 
@@ -96,9 +239,29 @@ public:
     UFUNCTION(BlueprintCallable, Category = "Attributes")
     bool ApplyHealthChange(float Delta);
 
+    // Damage is reduced by GetDefense()
     UFUNCTION(BlueprintCallable, Category = "Attributes")
     bool ApplyHealthChangeInstigator(AActor* InstigatorActor, float Delta);
 
+    // Health change from a status effect tick: neither blocked by nor
+    // causing the hit stun, and not reduced by defense
+    UFUNCTION(BlueprintCallable, Category = "Attributes")
+    bool ApplyPeriodicHealthChange(AActor* InstigatorActor, float Delta);
+
+    // Broadcasts OnHealthChanged with the current health; called by
+    // UWotDamageSubsystem with the summed delta of the frame
+    void BroadcastHealthChanged(AActor* InstigatorActor, float Delta);
+
+    UFUNCTION(BlueprintCallable, Category = "Attributes")
+    bool ApplyStaminaChange(float Delta);
+
+    // Drains PerSecond stamina until removed again with the same value
+    UFUNCTION(BlueprintCallable, Category = "Attributes")
+    void AddStaminaDrain(float PerSecond);
+
+    UFUNCTION(BlueprintCallable, Category = "Attributes")
+    void RemoveStaminaDrain(float PerSecond);
+
     UFUNCTION(BlueprintCallable, Category = "Attributes")
     bool ApplyMagicChange(float Delta);
 
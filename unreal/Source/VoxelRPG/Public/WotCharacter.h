@@ -5,6 +5,8 @@
 #include "CoreMinimal.h"
 #include "GameFramework/Character.h"
 #include "CineCameraComponent.h"
+#include "WotComponentHost.h"
+#include "WotTimingWheelSubsystem.h"
 #include "WotCharacter.generated.h"
 
 class UAnimMontage;
@@ -27,7 +29,7 @@ class UAudioComponent;
 class UNiagaraSystem;
 
 UCLASS()
-class VOXELRPG_API AWotCharacter : public ACharacter
+class VOXELRPG_API AWotCharacter : public ACharacter, public IWotComponentHost
 {
 	GENERATED_BODY()
 
@@ -68,6 +70,8 @@ protected:
 	// Called when the game starts or when spawned
 	virtual void BeginPlay() override;
 
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
 	UPROPERTY(BlueprintReadWrite, VisibleAnywhere, Category = "Components")
 	USpringArmComponent* SpringArmComp;
 
@@ -158,12 +162,13 @@ protected:
 	void ShowHealthBarWidget(float NewHealth, float Delta, float Duration);
 
 	float KilledDestroyDelay = 2.0f;
-	FTimerHandle TimerHandle_Destroy;
+	FWotTimerHandle TimerHandle_Destroy;
 	void Destroy_TimeElapsed();
 
 	float InteractionCheckPeriod = 0.2f;
 	FTimerHandle TimerHandle_InteractionCheck;
 	void InteractionCheck_TimeElapsed();
+	void OnInteractableInRange(AActor* ClosestInteractable, UActorComponent* ClosestInteractionComp, const FHitResult& HitResult);
 
 	UFUNCTION(Exec)
 	void HealSelf(float Amount = 100.0f);
@@ -172,8 +177,13 @@ protected:
 
 	virtual FVector GetPawnViewLocation() const override;
 
+	UPROPERTY(Transient)
+	FWotComponentCache ComponentCache;
+
 public:
 
+	virtual const FWotComponentCache& GetComponentCache() const override { return ComponentCache; }
+
 	UFUNCTION(BlueprintCallable)
 	bool IsClimbing() const;
 
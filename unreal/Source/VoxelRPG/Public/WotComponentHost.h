@@ -0,0 +1,91 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/Interface.h"
+#include "WotComponentHost.generated.h"
+
+class UWotActionComponent;
+class UWotAttributeComponent;
+class UWotEquipmentComponent;
+class UWotInventoryComponent;
+
+/*
+ * 	The gameplay components of an actor, looked up once after its components
+ * 	are initialized so the static GetAttributes / GetInventory / ... helpers
+ * 	don't have to scan the component list on every call.
+ */
+USTRUCT()
+struct VOXELRPG_API FWotComponentCache
+{
+  GENERATED_BODY()
+
+  // Fills the cache from the components of Owner, should be called from
+  // PostInitializeComponents
+  void Fill(AActor* Owner);
+
+  bool IsFilled() const { return bFilled; }
+
+  // Cached component of type T, only specialized for the cached types
+  template<typename T>
+  T* Get() const;
+
+  // Component of type T from the cache if FromActor is a filled
+  // IWotComponentHost, otherwise from scanning its components
+  template<typename T>
+  static T* Find(AActor* FromActor);
+
+protected:
+
+  UPROPERTY(Transient)
+  UWotAttributeComponent* Attributes = nullptr;
+
+  UPROPERTY(Transient)
+  UWotInventoryComponent* Inventory = nullptr;
+
+  UPROPERTY(Transient)
+  UWotEquipmentComponent* Equipment = nullptr;
+
+  UPROPERTY(Transient)
+  UWotActionComponent* Actions = nullptr;
+
+  bool bFilled = false;
+};
+
+template<> inline UWotAttributeComponent* FWotComponentCache::Get<UWotAttributeComponent>() const { return Attributes; }
+template<> inline UWotInventoryComponent* FWotComponentCache::Get<UWotInventoryComponent>() const { return Inventory; }
+template<> inline UWotEquipmentComponent* FWotComponentCache::Get<UWotEquipmentComponent>() const { return Equipment; }
+template<> inline UWotActionComponent* FWotComponentCache::Get<UWotActionComponent>() const { return Actions; }
+
+UINTERFACE(MinimalAPI, meta = (CannotImplementInterfaceInBlueprint))
+class UWotComponentHost : public UInterface
+{
+  GENERATED_BODY()
+};
+
+/**
+ *   Implemented by actors that keep a FWotComponentCache of their gameplay
+ *   components
+ */
+class VOXELRPG_API IWotComponentHost
+{
+  GENERATED_BODY()
+
+public:
+
+  virtual const FWotComponentCache& GetComponentCache() const = 0;
+};
+
+template<typename T>
+T* FWotComponentCache::Find(AActor* FromActor)
+{
+  if (!FromActor) {
+    return nullptr;
+  }
+  if (const IWotComponentHost* Host = Cast<IWotComponentHost>(FromActor)) {
+    const FWotComponentCache& Cache = Host->GetComponentCache();
+    if (Cache.IsFilled()) {
+      return Cache.Get<T>();
+    }
+  }
+  return FromActor->FindComponentByClass<T>();
+}
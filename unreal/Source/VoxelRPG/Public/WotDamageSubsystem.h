@@ -0,0 +1,94 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "WotDamageSubsystem.generated.h"
+
+class UWotAttributeComponent;
+
+USTRUCT(BlueprintType)
+struct FWotDamageCounters
+{
+  GENERATED_BODY()
+
+  // Health changes applied by attribute components
+  UPROPERTY(BlueprintReadOnly, Category = "Attributes")
+  int32 HealthChanges = 0;
+
+  // OnHealthChanged events broadcast after coalescing
+  UPROPERTY(BlueprintReadOnly, Category = "Attributes")
+  int32 EventsBroadcast = 0;
+
+  // Health changes folded into an event already pending for the same victim
+  UPROPERTY(BlueprintReadOnly, Category = "Attributes")
+  int32 Coalesced = 0;
+};
+
+/*
+ * 	Collects the health changes of every attribute component during the
+ * 	frame and broadcasts one OnHealthChanged per victim at the end of it, with
+ * 	the summed delta and the resulting health, so a sweep or volley hitting
+ * 	several times doesn't create a health bar, popup and hit flash per hit.
+ * 	Health, stun and kills are still resolved when the damage is applied so
+ * 	the gameplay result is unchanged; a victim's pending event is flushed
+ * 	right before its OnKilled to keep the event order.
+ */
+UCLASS()
+class VOXELRPG_API UWotDamageSubsystem : public UTickableWorldSubsystem
+{
+  GENERATED_BODY()
+
+public:
+
+  static UWotDamageSubsystem* Get(const UObject* WorldContextObject);
+
+  // Returns the subsystem if wot.Damage.Coalesce is on, nullptr otherwise
+  static UWotDamageSubsystem* GetIfEnabled(const UObject* WorldContextObject);
+
+  void QueueHealthChanged(UWotAttributeComponent* Victim, AActor* InstigatorActor, float Delta);
+
+  // Broadcasts the pending event of Victim now, if it has one
+  void FlushVictim(UWotAttributeComponent* Victim);
+
+  void Flush();
+
+  UFUNCTION(BlueprintCallable, Category = "Attributes")
+  FWotDamageCounters GetCounters() const { return Counters; }
+
+  UFUNCTION(BlueprintCallable, Category = "Attributes")
+  void ResetCounters();
+
+  virtual void Deinitialize() override;
+
+  virtual void Tick(float DeltaTime) override;
+
+  virtual TStatId GetStatId() const override;
+
+  virtual bool IsTickable() const override { return Pending.Num() > 0; }
+
+protected:
+
+  struct FPendingHealthChange
+  {
+    TWeakObjectPtr<UWotAttributeComponent> Victim;
+    // the last instigator that changed the victim's health this frame
+    TWeakObjectPtr<AActor> InstigatorActor;
+    float Delta = 0.0f;
+  };
+
+  void Broadcast(const FPendingHealthChange& Change);
+
+  TArray<FPendingHealthChange> Pending;
+
+  // swapped with Pending while flushing, so events raised by the listeners
+  // are queued for the next flush
+  TArray<FPendingHealthChange> Flushing;
+
+  // index of the change being broadcast while flushing, INDEX_NONE
+  // otherwise
+  int32 FlushPosition = INDEX_NONE;
+
+  TMap<const UWotAttributeComponent*, int32> PendingIndices;
+
+  FWotDamageCounters Counters;
+};
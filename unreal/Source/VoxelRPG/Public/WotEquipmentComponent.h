@@ -42,6 +42,11 @@ public:
     UFUNCTION(BlueprintCallable)
     void UnequipAll();
 
+    // Unequips and equips again everything equipped, e.g. to put the item
+    // actors back on the owner after they were detached when it was killed
+    UFUNCTION(BlueprintCallable)
+    void ReequipAll();
+
     UFUNCTION(BlueprintCallable)
 	void UnequipArmor(UWotItemArmor* NewItemArmor);
 
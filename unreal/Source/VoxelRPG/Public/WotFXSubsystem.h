@@ -0,0 +1,99 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "WotFXSubsystem.generated.h"
+
+class UNiagaraComponent;
+class UNiagaraSystem;
+class USceneComponent;
+
+UENUM(BlueprintType)
+enum class EWotFXPriority : uint8
+{
+  // first to be culled by distance and budget
+  Low,
+  Normal,
+  // never culled or deduplicated (e.g. effects other code depends on)
+  Critical
+};
+
+USTRUCT(BlueprintType)
+struct FWotFXCounters
+{
+  GENERATED_BODY()
+
+  UPROPERTY(BlueprintReadOnly, Category = "FX")
+  int32 Requested = 0;
+
+  UPROPERTY(BlueprintReadOnly, Category = "FX")
+  int32 Spawned = 0;
+
+  UPROPERTY(BlueprintReadOnly, Category = "FX")
+  int32 CulledByDistance = 0;
+
+  UPROPERTY(BlueprintReadOnly, Category = "FX")
+  int32 CulledByBudget = 0;
+
+  UPROPERTY(BlueprintReadOnly, Category = "FX")
+  int32 Deduplicated = 0;
+
+  // Most effects spawned in a single frame
+  UPROPERTY(BlueprintReadOnly, Category = "FX")
+  int32 PeakSpawnedPerFrame = 0;
+};
+
+/*
+ * 	Single entry point for spawning one-shot Niagara effects. Effects are
+ * 	spawned from Niagara's per-system component pools, and are skipped when
+ * 	they are too far from every player, when the per-frame spawn budget is
+ * 	used up, or when the same system was just spawned at nearly the same
+ * 	place. Counters record what happened to every request.
+ */
+UCLASS()
+class VOXELRPG_API UWotFXSubsystem : public UWorldSubsystem
+{
+  GENERATED_BODY()
+
+public:
+
+  static UWotFXSubsystem* Get(const UObject* WorldContextObject);
+
+  // Returns nullptr if the effect was culled
+  UFUNCTION(BlueprintCallable, Category = "FX", meta = (WorldContext = "WorldContextObject"))
+  static UNiagaraComponent* SpawnSystemAtLocation(const UObject* WorldContextObject, UNiagaraSystem* System, FVector Location, FRotator Rotation, EWotFXPriority Priority = EWotFXPriority::Normal);
+
+  // Returns nullptr if the effect was culled
+  UFUNCTION(BlueprintCallable, Category = "FX")
+  static UNiagaraComponent* SpawnSystemAttached(UNiagaraSystem* System, USceneComponent* AttachToComponent, FName AttachPointName, FVector Location, FRotator Rotation, EWotFXPriority Priority = EWotFXPriority::Normal);
+
+  UFUNCTION(BlueprintCallable, Category = "FX")
+  FWotFXCounters GetCounters() const { return Counters; }
+
+  UFUNCTION(BlueprintCallable, Category = "FX")
+  void ResetCounters();
+
+protected:
+
+  struct FRecentSpawn
+  {
+    const UNiagaraSystem* System;
+    FVector Location;
+    double Time;
+  };
+
+  // Decides whether the effect may spawn, updating the counters
+  bool AllowSpawn(const UNiagaraSystem* System, const FVector& Location, EWotFXPriority Priority);
+
+  bool IsNearAnyPlayer(const FVector& Location, float Distance) const;
+
+  void OnSpawned(const UNiagaraSystem* System, const FVector& Location);
+
+  FWotFXCounters Counters;
+
+  uint64 BudgetFrame = 0;
+
+  int32 SpawnedThisFrame = 0;
+
+  TArray<FRecentSpawn> RecentSpawns;
+};
@@ -3,6 +3,7 @@
 #include "CoreMinimal.h"
 #include "GameFramework/GameModeBase.h"
 #include "EnvironmentQuery/EnvQueryTypes.h"
+#include "AI/WotSpawnPointSubsystem.h"
 #include "WotGameModeBase.generated.h"
 
 class UEnvQuery;
@@ -52,6 +53,50 @@ protected:
   UFUNCTION()
   void OnQueryCompleted(UEnvQueryInstanceBlueprintWrapper* QueryInstance, EEnvQueryStatus::Type QueryStatus);
 
+  // When enabled, the whole bot deficit is refilled from a single query
+  // result instead of one query per bot
+  UPROPERTY(EditDefaultsOnly, Category = "AI|Waves")
+  bool bSpawnInWaves{false};
+
+  // Minimum distance between bots spawned in the same wave (relaxed if the
+  // query doesn't return enough separated locations)
+  UPROPERTY(EditDefaultsOnly, Category = "AI|Waves")
+  float WaveSpawnMinSeparation{400.0f};
+
+  // Time budget for spawning wave bots each frame; at least one bot is always
+  // spawned per frame so the wave finishes
+  UPROPERTY(EditDefaultsOnly, Category = "AI|Waves")
+  float WaveSpawnBudgetMs{1.0f};
+
+  // How many bots the in-flight wave query should produce
+  int32 PendingWaveSize{0};
+
+  bool bWaveQueryInFlight{false};
+
+  // Locations picked for the current wave that haven't been spawned yet
+  TArray<FVector> PendingSpawnLocations;
+
+  // Pull spawn locations from the spawn point cache instead of running
+  // SpawnBotQuery; the query is still used while the cache is warming up
+  UPROPERTY(EditDefaultsOnly, Category = "AI|Spawn Points")
+  bool bUseSpawnPointCache{false};
+
+  UPROPERTY(EditDefaultsOnly, Category = "AI|Spawn Points", meta = (EditCondition = "bUseSpawnPointCache"))
+  FWotSpawnPointCacheSettings SpawnPointCacheSettings;
+
+  bool SpawnBotsFromCache(int32 NumToSpawn);
+
+  void SpawnPendingBots();
+
+  AActor* SpawnMinion(const FVector& Location);
+
+  // Number of inactive actors to create per class at the start of play, so
+  // the first waves / volleys don't pay for spawning
+  UPROPERTY(EditDefaultsOnly, Category = "Pooling")
+  TMap<TSubclassOf<AActor>, int32> PoolPrewarmCounts;
+
+  static void SelectSeparatedLocations(const TArray<FVector>& Candidates, int32 Count, float MinSeparation, TArray<FVector>& OutLocations);
+
   FTimerHandle TimerHandle_SpawnBots;
 
   UPROPERTY(EditDefaultsOnly, Category = "AI")
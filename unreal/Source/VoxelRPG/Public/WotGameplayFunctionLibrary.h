@@ -4,6 +4,7 @@
 
 #include "CoreMinimal.h"
 #include "Kismet/BlueprintFunctionLibrary.h"
+#include "CollisionQueryParams.h"
 #include "WotGameplayFunctionLibrary.generated.h"
 
 UCLASS()
@@ -19,6 +20,17 @@ public:
     UFUNCTION(BlueprintCallable, Category = "Gameplay")
     static bool GetClosestInteractableInBox(AActor* InstigatorActor, FVector BoxHalfExtent, FVector Origin, FVector End, AActor* &ClosestActor, UActorComponent* &ClosestComponent, FHitResult &ClosestHit);
 
+    // GetClosestInteractableInBox with a physics sweep, regardless of
+    // wot.Interaction.UseGrid
+    static bool SweepClosestInteractableInBox(AActor* InstigatorActor, FVector BoxHalfExtent, FVector Origin, FVector End, AActor* &ClosestActor, UActorComponent* &ClosestComponent, FHitResult &ClosestHit);
+
+    // Object types swept for interactables
+    static FCollisionObjectQueryParams GetInteractableObjectQueryParams();
+
+    // Picks the closest interactable actor / component from the hits of an
+    // interaction sweep from Origin to End
+    static bool FindClosestInteractable(const TArray<FHitResult>& Hits, const FVector& Origin, const FVector& End, AActor* &ClosestActor, UActorComponent* &ClosestComponent, FHitResult &ClosestHit);
+
     UFUNCTION(BlueprintCallable, Category = "Debug")
     static void DrawHitPointAndBounds(AActor* HitActor, const FHitResult& Hit);
 
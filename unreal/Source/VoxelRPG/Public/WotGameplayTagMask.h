@@ -0,0 +1,34 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameplayTagContainer.h"
+
+/*
+ * 	Gameplay tags as the bits of a 64 bit mask, so the tag requirements of
+ * 	actions are a couple of ANDs instead of container searches. Bits are
+ * 	handed out on first use to the tags that appear in requirements (there
+ * 	are only a few dozen); active tags set the bits of themselves and of
+ * 	their parents, which keeps the hierarchical matching of
+ * 	FGameplayTagContainer::HasAny / HasAll.
+ */
+struct VOXELRPG_API FWotGameplayTagMask
+{
+  // Mask of requirement tags, assigning bits to tags that don't have one
+  static FWotGameplayTagMask MakeRequirement(const FGameplayTagContainer& Tags);
+
+  // Mask of active tags, only sets bits that requirements already use
+  static FWotGameplayTagMask MakeActive(const FGameplayTagContainer& Tags);
+
+  // Bumped whenever a tag gets a new bit, active masks built before that
+  // are missing it and have to be rebuilt
+  static uint32 GetGeneration();
+
+  bool HasAny(const FWotGameplayTagMask& Other) const { return (Bits & Other.Bits) != 0; }
+
+  bool HasAll(const FWotGameplayTagMask& Other) const { return (Bits & Other.Bits) == Other.Bits; }
+
+  uint64 Bits = 0;
+
+  // false if the tags ran out of bits, queries must then use the containers
+  bool bValid = true;
+};
@@ -0,0 +1,115 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Components/SceneComponent.h"
+#include "WotInteractableGridSubsystem.generated.h"
+
+/*
+ * 	Uniform grid of every actor that implements IWotInteractableInterface,
+ * 	or owns a component that does, keyed by the actor's bounds. Actors are
+ * 	picked up when spawned (and from the level on begin play) and removed on
+ * 	end play; movable ones are re-bucketed, once per frame, after their root
+ * 	component reported a move and only if they changed cells. Finding
+ * 	the closest interactable along the interaction box is a walk over the
+ * 	few cells it touches, without a physics query or any allocation.
+ */
+UCLASS()
+class VOXELRPG_API UWotInteractableGridSubsystem : public UTickableWorldSubsystem
+{
+  GENERATED_BODY()
+
+public:
+
+  static UWotInteractableGridSubsystem* Get(const UObject* WorldContextObject);
+
+  // Returns the grid if wot.Interaction.UseGrid is on, nullptr otherwise
+  static UWotInteractableGridSubsystem* GetIfEnabled(const UObject* WorldContextObject);
+
+  // Adds Actor if it or Component implements the interactable interface.
+  // With no component the first interactable component of the actor is used,
+  // an interactable actor always takes precedence over its components
+  void RegisterInteractable(AActor* Actor, UActorComponent* Component = nullptr);
+
+  // Removes Actor; if Component is given only when it's the one registered
+  void UnregisterInteractable(AActor* Actor, UActorComponent* Component = nullptr);
+
+  // Measures the bounds of Actor again, e.g. after its mesh changed
+  void RefreshBounds(AActor* Actor);
+
+  // Same result as sweeping a box of BoxHalfExtent from Origin to End and
+  // picking the closest interactable hit
+  bool FindClosestInteractable(const FVector& Origin, const FVector& End, const FVector& BoxHalfExtent, AActor*& ClosestActor, UActorComponent*& ClosestComponent, FHitResult& ClosestHit);
+
+  int32 GetNumInteractables() const { return Actors.Num(); }
+
+  int32 GetNumCells() const { return Cells.Num(); }
+
+  virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+
+  virtual void Deinitialize() override;
+
+  virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+
+  virtual void Tick(float DeltaTime) override;
+
+  virtual TStatId GetStatId() const override;
+
+  virtual bool IsTickable() const override { return MovedActors.Num() > 0; }
+
+protected:
+
+  void OnActorSpawned(AActor* Actor);
+
+  void OnRootTransformUpdated(USceneComponent* UpdatedComponent, EUpdateTransformFlags UpdateTransformFlags, ETeleportType Teleport);
+
+  // Bounds of Actor in world space
+  static FBox MeasureBounds(AActor* Actor);
+
+  // Moves the interactable at Index to the cells its bounds are in now
+  void UpdateCells(int32 Index);
+
+  UFUNCTION()
+  void OnActorEndPlay(AActor* Actor, EEndPlayReason::Type EndPlayReason);
+
+  void RemoveAt(int32 Index);
+
+  void AddToCells(int32 Index);
+
+  void RemoveFromCells(int32 Index);
+
+  void GetCellRange(const FBox& Box, FIntVector& OutMin, FIntVector& OutMax) const;
+
+  // edge length of a grid cell, from wot.Interaction.GridCellSize when the
+  // world starts
+  float CellSize = 500.0f;
+
+  UPROPERTY(Transient)
+  TArray<AActor*> Actors;
+
+  UPROPERTY(Transient)
+  TArray<UActorComponent*> Components;
+
+  // per interactable data, indexed like Actors
+  TArray<FBox> Bounds;
+  TArray<FVector> BoundsOffsets;
+  TArray<bool> Movable;
+  // of the root component's TransformUpdated, for movable ones
+  TArray<FDelegateHandle> TransformHandles;
+  TArray<FIntVector> MinCells;
+  TArray<FIntVector> MaxCells;
+  TArray<uint32> QueryStamps;
+
+  TMap<const AActor*, int32> Indices;
+
+  TMap<FIntVector, TArray<int32>> Cells;
+
+  // movable interactables that moved since the last tick
+  TSet<const AActor*> MovedActors;
+
+  // bumped for every query so interactables spanning several cells are only
+  // tested once
+  uint32 QueryStamp = 0;
+
+  FDelegateHandle ActorSpawnedHandle;
+};
@@ -7,6 +7,8 @@
 #include "WotInteractableInterface.h"
 #include "WotInteractionComponent.generated.h"
 
+DECLARE_DELEGATE_ThreeParams(FWotInteractableResultDelegate, AActor* /* Actor */, UActorComponent* /* Component */, const FHitResult& /* Hit */);
+
 UCLASS()
 class VOXELRPG_API UWotInteractionComponent : public UActorComponent
 {
@@ -26,6 +28,11 @@ public:
     UFUNCTION(BlueprintCallable, Category = "Interaction")
     bool GetInteractableInRange(AActor*& OutActor, UActorComponent*& OutComponent, FHitResult& OutHitResult) const;
 
+    // Same as GetInteractableInRange but runs the sweep through
+    // UWotTraceSubsystem; OnResult is only called if an interactable was found.
+    // With the interactable grid enabled OnResult is called right away
+    void RequestInteractableInRange(FWotInteractableResultDelegate OnResult) const;
+
     void PrimaryInteract();
 
 public:
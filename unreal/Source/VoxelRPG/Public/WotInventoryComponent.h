@@ -27,6 +27,10 @@ public:
     // Called when the game starts
     virtual void BeginPlay() override;
 
+    // Rolls and adds a copy of each of the DefaultItems
+    UFUNCTION(BlueprintCallable)
+    void AddDefaultItems();
+
     UFUNCTION(BlueprintCallable)
     UWotItem* FindItem(TSubclassOf<UWotItem> ItemClass);
 
@@ -42,6 +46,10 @@ public:
     UFUNCTION(BlueprintCallable)
     void DropAll();
 
+    // Removes every item without dropping it
+    UFUNCTION(BlueprintCallable)
+    void ClearItems();
+
     UPROPERTY(BlueprintAssignable, Category = "Inventory")
     FOnInventoryUpdated OnInventoryUpdated;
 
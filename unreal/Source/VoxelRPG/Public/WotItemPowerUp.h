@@ -6,6 +6,7 @@
 #include "GameFramework/Actor.h"
 #include "WotGameplayInterface.h"
 #include "WotInteractableInterface.h"
+#include "WotTimingWheelSubsystem.h"
 #include "WotItemPowerUp.generated.h"
 
 class UStaticMeshComponent;
@@ -38,9 +39,9 @@ protected:
 
     virtual void SetPowerupState(bool bNewIsInteractable);
 
-	FTimerHandle TimerHandle_Cooldown;
+	FWotTimerHandle TimerHandle_Cooldown;
 
-    FTimerHandle HighlightTimerHandle;
+    FWotTimerHandle HighlightTimerHandle;
     void OnHighlightTimerExpired();
 
 public:
@@ -6,6 +6,7 @@
 #include "GameFramework/Actor.h"
 #include "WotGameplayInterface.h"
 #include "WotInteractableInterface.h"
+#include "WotTimingWheelSubsystem.h"
 #include "WotOpenable.generated.h"
 
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnOpened, AActor*, InstigatorActor, AActor*, OpenableActor);
@@ -78,10 +79,12 @@ protected:
 	// Called when the game starts or when spawned
 	virtual void BeginPlay() override;
 
+	void InvalidateSpawnPoints();
+
     UPROPERTY(VisibleAnywhere)
     USceneComponent* BaseSceneComp;
 
-    FTimerHandle HighlightTimerHandle;
+    FWotTimerHandle HighlightTimerHandle;
     void OnHighlightTimerExpired();
 
 public:
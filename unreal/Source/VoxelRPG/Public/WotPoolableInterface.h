@@ -0,0 +1,33 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/Interface.h"
+#include "WotPoolableInterface.generated.h"
+
+UINTERFACE(MinimalAPI, Blueprintable)
+class UWotPoolableInterface : public UInterface
+{
+  GENERATED_BODY()
+};
+
+/**
+ *   Interface for actors that can be reused by UWotActorPoolSubsystem
+ *   instead of being destroyed and spawned again
+ */
+class VOXELRPG_API IWotPoolableInterface
+{
+  GENERATED_BODY()
+
+public:
+
+  // Called when the actor is taken back out of the pool, after its transform,
+  // owner and instigator have been set. Newly spawned actors get BeginPlay
+  // instead.
+  UFUNCTION(BlueprintNativeEvent, Category = "Pooling")
+  void OnAcquiredFromPool();
+
+  // Called right before the actor is hidden and put back in the pool; should
+  // reset any state left over from its last use
+  UFUNCTION(BlueprintNativeEvent, Category = "Pooling")
+  void OnReleasedToPool();
+};
@@ -5,6 +5,7 @@
 #include "CoreMinimal.h"
 #include "GameFramework/Actor.h"
 #include "GameplayTagContainer.h"
+#include "WotPoolableInterface.h"
 #include "WotProjectile.generated.h"
 class UAudioComponent;
 class UCameraShakeBase;
@@ -16,7 +17,7 @@ class UNiagaraSystem;
 class UNiagaraComponent;
 
 UCLASS()
-class VOXELRPG_API AWotProjectile : public AActor
+class VOXELRPG_API AWotProjectile : public AActor, public IWotPoolableInterface
 {
   GENERATED_BODY()
 
@@ -24,6 +25,24 @@ public:
 
   AWotProjectile();
 
+  virtual void OnAcquiredFromPool_Implementation() override;
+
+  virtual void OnReleasedToPool_Implementation() override;
+
+  // Called by UWotProjectileSubsystem for each hit found while it is moving
+  // this projectile
+  virtual void HandleManagedHit(const FHitResult& Hit);
+
+  // Called by UWotProjectileSubsystem when the projectile gets too far from
+  // (or comes back close to) every player
+  virtual void SetManagedCulled(bool bCulled);
+
+  UFUNCTION(BlueprintCallable, Category = "Movement")
+  FVector GetProjectileVelocity() const;
+
+  UFUNCTION(BlueprintCallable, Category = "Movement")
+  void SetProjectileVelocity(const FVector& NewVelocity);
+
 protected:
 
   UFUNCTION(BlueprintCallable, BlueprintNativeEvent, Category = "Impact")
@@ -53,6 +72,21 @@ protected:
   UPROPERTY(BlueprintReadWrite, VisibleAnywhere, Category = "Movement")
   UProjectileMovementComponent* MovementComp;
 
+  // Let UWotProjectileSubsystem move this projectile and find its hits
+  // instead of the movement component and sphere overlaps; ignored for
+  // projectiles that bounce. On by default so existing projectiles are
+  // batched without content changes
+  UPROPERTY(EditDefaultsOnly, Category = "Movement")
+  bool bUseProjectileManager = true;
+
+  // Hands the movement component's current velocity over to the projectile
+  // subsystem, if bUseProjectileManager is set
+  void BeginManagedFlight();
+
+  void EndManagedFlight();
+
+  bool IsManagedFlight() const;
+
   UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "Audio Effects", meta = (AllowPrivateAccess = "true"))
   USoundBase* EffectSound;
 
@@ -89,6 +123,11 @@ protected:
 
   virtual void PostInitializeComponents() override;
 
+  virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+  // Returns the projectile to the pool instead of destroying it
+  virtual void LifeSpanExpired() override;
+
   // BlueprintNativeEvent = C++ base implementation, can be expanded in Blueprints
   // BlueprintCallable to allow child classes to trigger explosions
   UFUNCTION(BlueprintCallable, BlueprintNativeEvent)
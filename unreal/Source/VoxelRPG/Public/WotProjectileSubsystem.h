@@ -0,0 +1,104 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "WorldCollision.h"
+#include "WotProjectileSubsystem.generated.h"
+
+class AWotProjectile;
+class UProjectileMovementComponent;
+
+/*
+ * 	Moves projectiles that opted in with AWotProjectile::bUseProjectileManager.
+ * 	Their movement state is kept in parallel arrays and integrated in one pass,
+ * 	with the gravity, homing and max speed of their movement component. The
+ * 	sweeps for hits are queued as one batch of async traces that the physics
+ * 	threads run at the end of the frame, and their hits are handed back to
+ * 	the projectiles at the start of the next one (wot.Projectiles.AsyncSweeps
+ * 	off sweeps right away instead). The projectile actors themselves are only
+ * 	used for visuals and are not updated at all while far from every player.
+ */
+UCLASS()
+class VOXELRPG_API UWotProjectileSubsystem : public UTickableWorldSubsystem
+{
+  GENERATED_BODY()
+
+public:
+
+  static UWotProjectileSubsystem* Get(const UObject* WorldContextObject);
+
+  static bool IsEnabled();
+
+  // Takes over the velocity, gravity, homing and max speed of Movement
+  void AddProjectile(AWotProjectile* Projectile, const UProjectileMovementComponent* Movement, float Radius, FName ProfileName);
+
+  void RemoveProjectile(AWotProjectile* Projectile);
+
+  bool IsManaged(const AWotProjectile* Projectile) const { return Indices.Contains(Projectile); }
+
+  FVector GetVelocity(const AWotProjectile* Projectile) const;
+
+  void SetVelocity(const AWotProjectile* Projectile, const FVector& NewVelocity);
+
+  int32 GetNumProjectiles() const { return Projectiles.Num(); }
+
+  virtual void Deinitialize() override;
+
+  virtual void Tick(float DeltaTime) override;
+
+  virtual TStatId GetStatId() const override;
+
+  virtual bool IsTickable() const override { return Projectiles.Num() > 0; }
+
+protected:
+
+  struct FPendingHit
+  {
+    TWeakObjectPtr<AWotProjectile> Projectile;
+    FHitResult Hit;
+  };
+
+  void Integrate(float DeltaTime);
+
+  void SweepAll();
+
+  // Queues the sweeps of every projectile as async traces
+  void IssueSweeps();
+
+  // Takes the hits of the sweeps queued last frame
+  void CollectSweeps();
+
+  // Stops the projectile at Index where it is blocked and queues its hits
+  void AddHits(int32 Index, const TArray<FHitResult>& Hits);
+
+  void UpdateVisuals();
+
+  void DispatchHits();
+
+  void UpdatePlayerViews();
+
+  void RemoveAt(int32 Index);
+
+  UPROPERTY(Transient)
+  TArray<AWotProjectile*> Projectiles;
+
+  // per projectile data, indexed like Projectiles
+  TArray<FVector> Locations;
+  TArray<FVector> PrevLocations;
+  TArray<FVector> Velocities;
+  TArray<float> GravityZs;
+  // 0 for no limit
+  TArray<float> MaxSpeeds;
+  TArray<TWeakObjectPtr<USceneComponent>> HomingTargets;
+  TArray<float> HomingAccelerations;
+  TArray<float> Radii;
+  TArray<FName> ProfileNames;
+  TArray<bool> Culled;
+  TArray<FTraceHandle> SweepHandles;
+
+  TMap<const AWotProjectile*, int32> Indices;
+
+  TArray<FPendingHit> PendingHits;
+
+  TArray<FVector> PlayerViewLocations;
+};
@@ -0,0 +1,117 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "WotSoundSubsystem.generated.h"
+
+class UAudioComponent;
+class USceneComponent;
+class USoundBase;
+
+UENUM(BlueprintType)
+enum class EWotSoundCategory : uint8
+{
+  Impact,
+  Weapon,
+  Pickup,
+  World,
+  Death,
+  MAX UMETA(Hidden)
+};
+
+USTRUCT(BlueprintType)
+struct FWotSoundCounters
+{
+  GENERATED_BODY()
+
+  UPROPERTY(BlueprintReadOnly, Category = "Audio")
+  int32 Requested = 0;
+
+  UPROPERTY(BlueprintReadOnly, Category = "Audio")
+  int32 Played = 0;
+
+  // Requests dropped because the same sound already played this frame in
+  // the same location cell
+  UPROPERTY(BlueprintReadOnly, Category = "Audio")
+  int32 Merged = 0;
+
+  UPROPERTY(BlueprintReadOnly, Category = "Audio")
+  int32 CulledByBudget = 0;
+
+  UPROPERTY(BlueprintReadOnly, Category = "Audio")
+  int32 CulledByDistance = 0;
+
+  // Audio components ever created for the attached sound pool
+  UPROPERTY(BlueprintReadOnly, Category = "Audio")
+  int32 ComponentsCreated = 0;
+
+  // Most voices playing at once, over all categories
+  UPROPERTY(BlueprintReadOnly, Category = "Audio")
+  int32 PeakVoices = 0;
+};
+
+/*
+ * 	Single entry point for one-shot sounds. Identical sounds requested in
+ * 	the same frame and location cell are merged into one, each category has
+ * 	a voice budget, and sounds that follow a component reuse a pool of audio
+ * 	components instead of creating one per sound.
+ */
+UCLASS()
+class VOXELRPG_API UWotSoundSubsystem : public UWorldSubsystem
+{
+  GENERATED_BODY()
+
+public:
+
+  static UWotSoundSubsystem* Get(const UObject* WorldContextObject);
+
+  // Fire and forget sound at a location, no audio component is created
+  UFUNCTION(BlueprintCallable, Category = "Audio", meta = (WorldContext = "WorldContextObject"))
+  static void PlaySoundAtLocation(const UObject* WorldContextObject, USoundBase* Sound, FVector Location, EWotSoundCategory Category, float VolumeMultiplier = 1.0f, float PitchMultiplier = 1.0f);
+
+  // One-shot sound that follows AttachToComponent, played on a pooled audio
+  // component
+  UFUNCTION(BlueprintCallable, Category = "Audio")
+  static void PlaySoundAttached(USoundBase* Sound, USceneComponent* AttachToComponent, EWotSoundCategory Category, float VolumeMultiplier = 1.0f, float PitchMultiplier = 1.0f);
+
+  UFUNCTION(BlueprintCallable, Category = "Audio")
+  FWotSoundCounters GetCounters() const { return Counters; }
+
+  UFUNCTION(BlueprintCallable, Category = "Audio")
+  void ResetCounters();
+
+  UFUNCTION(BlueprintCallable, Category = "Audio")
+  int32 GetNumVoices(EWotSoundCategory Category) const;
+
+  virtual void Deinitialize() override;
+
+protected:
+
+  // Decides whether the sound may play, updating the counters
+  bool AllowPlay(USoundBase* Sound, const FVector& Location, EWotSoundCategory Category);
+
+  void OnPlayed(USoundBase* Sound, EWotSoundCategory Category);
+
+  bool IsAudibleToAnyPlayer(const USoundBase* Sound, const FVector& Location) const;
+
+  void PruneVoices(EWotSoundCategory Category) const;
+
+  UAudioComponent* AcquireComponent();
+
+  void OnPooledSoundFinished(UAudioComponent* AudioComp);
+
+  FWotSoundCounters Counters;
+
+  // end times of the voices playing in each category
+  mutable TArray<double> VoiceEndTimes[(int32)EWotSoundCategory::MAX];
+
+  uint64 MergeFrame = 0;
+
+  TSet<TPair<const USoundBase*, FIntVector>> PlayedThisFrame;
+
+  UPROPERTY(Transient)
+  TArray<UAudioComponent*> FreeComponents;
+
+  UPROPERTY(Transient)
+  TArray<UAudioComponent*> BusyComponents;
+};
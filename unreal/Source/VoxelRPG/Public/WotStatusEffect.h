@@ -0,0 +1,72 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DataAsset.h"
+#include "GameplayTagContainer.h"
+#include "WotAttributeComponent.h"
+#include "WotStatusEffect.generated.h"
+
+UENUM(BlueprintType)
+enum class EWotStatusEffectStacking : uint8
+{
+  // Applying again restarts the duration
+  Refresh,
+  // Applying again adds a stack (up to MaxStacks), which scales the
+  // magnitudes, and restarts the duration
+  Stack,
+  // Applying again while active does nothing
+  Ignore
+};
+
+/*
+ * 	Definition of a status effect (buff, drain, damage over time, ...).
+ * 	Applied to actors with UWotStatusEffectSubsystem::ApplyStatusEffect,
+ * 	which keeps the active effects and ticks them.
+ */
+UCLASS(BlueprintType)
+class VOXELRPG_API UWotStatusEffect : public UPrimaryDataAsset
+{
+  GENERATED_BODY()
+
+public:
+
+  UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Status Effect")
+  FText DisplayName;
+
+  // Seconds the effect lasts, 0 or less lasts until removed
+  UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Status Effect")
+  float Duration = 5.0f;
+
+  // Seconds between applications of the magnitudes, 0 or less never applies
+  // them (e.g. effects that only grant tags)
+  UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Status Effect")
+  float Period = 1.0f;
+
+  // Also apply the magnitudes once when the effect is applied
+  UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Status Effect")
+  bool bApplyOnStart = false;
+
+  // Health change per period and stack, negative for damage
+  UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Magnitude")
+  float HealthPerPeriod = 0.0f;
+
+  // Magic change per period and stack, negative for drains
+  UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Magnitude")
+  float MagicPerPeriod = 0.0f;
+
+  // Added to the target's attributes while the effect is active, once
+  // regardless of stacks
+  UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Magnitude")
+  TArray<FWotAttributeModifier> Modifiers;
+
+  UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Stacking")
+  EWotStatusEffectStacking Stacking = EWotStatusEffectStacking::Refresh;
+
+  UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Stacking", meta = (ClampMin = "1", EditCondition = "Stacking == EWotStatusEffectStacking::Stack"))
+  int32 MaxStacks = 1;
+
+  // Added to the target's UWotActionComponent::ActiveGameplayTags while the
+  // effect is active
+  UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Tags")
+  FGameplayTagContainer GrantsTags;
+};
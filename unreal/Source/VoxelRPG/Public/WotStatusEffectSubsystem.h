@@ -0,0 +1,122 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "GameplayTagContainer.h"
+#include "UObject/ObjectKey.h"
+#include "WotStatusEffectSubsystem.generated.h"
+
+class UWotActionComponent;
+class UWotAttributeComponent;
+class UWotStatusEffect;
+
+/*
+ * 	Owns every active status effect in the world. Effects are kept in
+ * 	parallel arrays and advanced in one pass per frame; the resulting health
+ * 	and magic changes are then applied through the targets'
+ * 	UWotAttributeComponent and granted tags are reference counted into their
+ * 	UWotActionComponent::ActiveGameplayTags. Nothing ticks per component.
+ */
+UCLASS()
+class VOXELRPG_API UWotStatusEffectSubsystem : public UTickableWorldSubsystem
+{
+  GENERATED_BODY()
+
+public:
+
+  static UWotStatusEffectSubsystem* Get(const UObject* WorldContextObject);
+
+  // Applies Effect to TargetActor following the effect's stacking rule;
+  // returns false if it wasn't applied (no attributes, dead, or ignored)
+  UFUNCTION(BlueprintCallable, Category = "Status Effects")
+  static bool ApplyStatusEffect(AActor* TargetActor, UWotStatusEffect* Effect, AActor* InstigatorActor);
+
+  UFUNCTION(BlueprintCallable, Category = "Status Effects")
+  static bool RemoveStatusEffect(AActor* TargetActor, UWotStatusEffect* Effect);
+
+  // Number of stacks of Effect on TargetActor, 0 if not active
+  UFUNCTION(BlueprintCallable, Category = "Status Effects")
+  static int32 GetStatusEffectStacks(AActor* TargetActor, UWotStatusEffect* Effect);
+
+  UFUNCTION(BlueprintCallable, Category = "Status Effects")
+  void RemoveAllStatusEffects(AActor* TargetActor);
+
+  int32 GetNumActive() const { return Targets.Num(); }
+
+  // Cost of the last batched update, in microseconds
+  double GetLastTickMicroseconds() const { return LastTickMicroseconds; }
+
+  virtual void Deinitialize() override;
+
+  virtual void Tick(float DeltaTime) override;
+
+  virtual TStatId GetStatId() const override;
+
+  virtual bool IsTickable() const override { return Targets.Num() > 0; }
+
+protected:
+
+  struct FPendingChange
+  {
+    TWeakObjectPtr<UWotAttributeComponent> Target;
+    TWeakObjectPtr<AActor> InstigatorActor;
+    float HealthDelta = 0.0f;
+    float MagicDelta = 0.0f;
+  };
+
+  // object keys rather than pointers, so a key stays unique and can still be
+  // removed after GC cleared the object it was made from
+  using FEffectKey = TPair<TObjectKey<UWotAttributeComponent>, TObjectKey<UWotStatusEffect>>;
+
+  using FTagKey = TPair<TObjectKey<UWotActionComponent>, FGameplayTag>;
+
+  struct FEffectKeys
+  {
+    FEffectKey Effect;
+    TObjectKey<UWotActionComponent> ActionComp;
+  };
+
+  bool Apply(UWotAttributeComponent* Target, UWotStatusEffect* Effect, AActor* InstigatorActor);
+
+  void RemoveAt(int32 Index);
+
+  void AddTags(UWotActionComponent* ActionComp, const FGameplayTagContainer& Tags);
+
+  // ActionComp may have been cleared by GC, the counts are still released
+  void RemoveTags(TObjectKey<UWotActionComponent> ActionCompKey, UWotActionComponent* ActionComp, const FGameplayTagContainer& Tags);
+
+  void ApplyPendingChanges();
+
+  UPROPERTY(Transient)
+  TArray<UWotAttributeComponent*> Targets;
+
+  UPROPERTY(Transient)
+  TArray<UWotActionComponent*> ActionComps;
+
+  UPROPERTY(Transient)
+  TArray<UWotStatusEffect*> Effects;
+
+  // per effect instance data, indexed like Targets; magnitudes are copied from
+  // the effect so the update pass doesn't touch the assets
+  TArray<TWeakObjectPtr<AActor>> Instigators;
+  TArray<float> TimesRemaining;
+  TArray<float> TimesToNextPeriod;
+  TArray<float> Periods;
+  TArray<float> HealthPerPeriods;
+  TArray<float> MagicPerPeriods;
+  TArray<int32> Stacks;
+  // what the effect was registered under, kept since GC nulls Targets and
+  // ActionComps of destroyed actors
+  TArray<FEffectKeys> Keys;
+  TArray<FGameplayTagContainer> GrantedTags;
+
+  TMap<FEffectKey, int32> Indices;
+
+  // how many active effects grant each tag to each action component
+  TMap<FTagKey, int32> TagCounts;
+
+  // reused between frames
+  TArray<FPendingChange> PendingChanges;
+
+  double LastTickMicroseconds = 0.0;
+};
@@ -0,0 +1,150 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "TimerManager.h"
+#include "WotTimingWheelSubsystem.generated.h"
+
+// Id of a timer scheduled on UWotTimingWheelSubsystem; stays invalid once
+// the timer fired or was cancelled
+struct FWotTimerHandle
+{
+  bool IsValid() const { return Id != 0; }
+
+  void Invalidate() { Id = 0; }
+
+  // serial in the high 32 bits, node index in the low 32 bits
+  uint64 Id = 0;
+};
+
+USTRUCT(BlueprintType)
+struct FWotTimerCounters
+{
+  GENERATED_BODY()
+
+  UPROPERTY(BlueprintReadOnly, Category = "Timers")
+  int32 Scheduled = 0;
+
+  UPROPERTY(BlueprintReadOnly, Category = "Timers")
+  int32 Cancelled = 0;
+
+  UPROPERTY(BlueprintReadOnly, Category = "Timers")
+  int32 Fired = 0;
+
+  // Most timers pending at once
+  UPROPERTY(BlueprintReadOnly, Category = "Timers")
+  int32 PeakActive = 0;
+
+  // Timer nodes ever allocated, stays at the peak once warmed up
+  UPROPERTY(BlueprintReadOnly, Category = "Timers")
+  int32 NodesAllocated = 0;
+};
+
+/*
+ * 	Hierarchical timing wheel for the many short one-off gameplay timers
+ * 	(stun, highlight expiry, cooldowns, delayed destroys, widget removal).
+ * 	Timers live in a pooled node array linked into slot lists, so scheduling
+ * 	and cancelling are O(1) without allocating, and all timers expiring in
+ * 	a frame are fired as one batch. Time advances in fixed ticks of game time
+ * 	and pauses with the game, like FTimerManager.
+ */
+UCLASS()
+class VOXELRPG_API UWotTimingWheelSubsystem : public UTickableWorldSubsystem
+{
+  GENERATED_BODY()
+
+public:
+
+  static UWotTimingWheelSubsystem* Get(const UObject* WorldContextObject);
+
+  // Cancels InOutHandle if it is pending and schedules Delegate in Delay
+  // seconds, like FTimerManager::SetTimer for a non-looping timer
+  static void SetTimer(const UObject* WorldContextObject, FWotTimerHandle& InOutHandle, float Delay, FTimerDelegate Delegate);
+
+  template<typename UserClass>
+  static void SetTimer(UserClass* Object, FWotTimerHandle& InOutHandle, void (UserClass::*Method)(), float Delay)
+  {
+    SetTimer(Object, InOutHandle, Delay, FTimerDelegate::CreateUObject(Object, Method));
+  }
+
+  // Cancels the timer if it is pending and invalidates the handle
+  static void ClearTimer(const UObject* WorldContextObject, FWotTimerHandle& InOutHandle);
+
+  FWotTimerHandle Schedule(float Delay, FTimerDelegate Delegate);
+
+  void Cancel(FWotTimerHandle Handle);
+
+  bool IsTimerActive(FWotTimerHandle Handle) const;
+
+  int32 GetNumActive() const { return NumActive; }
+
+  UFUNCTION(BlueprintCallable, Category = "Timers")
+  FWotTimerCounters GetCounters() const { return Counters; }
+
+  UFUNCTION(BlueprintCallable, Category = "Timers")
+  void ResetCounters();
+
+  virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+
+  virtual void Deinitialize() override;
+
+  virtual void Tick(float DeltaTime) override;
+
+  virtual TStatId GetStatId() const override;
+
+  virtual bool IsTickable() const override { return NumActive > 0; }
+
+protected:
+
+  static constexpr int32 NumLevels = 4;
+  static constexpr int32 SlotBits = 6;
+  static constexpr int32 NumSlots = 1 << SlotBits;
+  static constexpr int32 SlotMask = NumSlots - 1;
+
+  // node states other than the level the node is linked into
+  static constexpr int8 NodeFree = -1;
+  static constexpr int8 NodeExpired = -2;
+
+  // length of one wheel tick in seconds
+  static constexpr double TickInterval = 1.0 / 60.0;
+
+  int32 FindNode(FWotTimerHandle Handle) const;
+
+  void Insert(int32 Index);
+
+  void Unlink(int32 Index);
+
+  void FreeNode(int32 Index);
+
+  // moves the timers of a higher level slot down to the levels below
+  void Cascade(int32 Level, int32 Slot);
+
+  void AdvanceTick();
+
+  void FireExpired();
+
+  // timer nodes, parallel arrays indexed by node index
+  TArray<FTimerDelegate> Delegates;
+  TArray<uint64> ExpireTicks;
+  TArray<uint32> Serials;
+  TArray<int32> Prevs;
+  TArray<int32> Nexts;
+  TArray<int8> Levels;
+  TArray<uint8> Slots;
+
+  TArray<int32> FreeNodes;
+
+  // first node of each slot's list
+  int32 Heads[NumLevels][NumSlots];
+
+  // handles of the timers expired this frame, fired in one batch
+  TArray<FWotTimerHandle> Expired;
+
+  uint64 CurrentTick = 0;
+
+  double AccumulatedTime = 0.0;
+
+  int32 NumActive = 0;
+
+  FWotTimerCounters Counters;
+};
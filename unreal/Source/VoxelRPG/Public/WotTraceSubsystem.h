@@ -0,0 +1,64 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "WorldCollision.h"
+#include "WotTraceSubsystem.generated.h"
+
+DECLARE_DELEGATE_OneParam(FWotTraceResultDelegate, const TArray<FHitResult>& /* Hits */);
+
+/*
+ * 	Runs gameplay sweeps and traces that don't need an answer this frame as async
+ * 	traces. The world collects every request made during the frame into one
+ * 	batch, runs it alongside the next frame, and the hits are handed to the
+ * 	callback from the world's own reused trace buffers. With
+ * 	wot.Trace.Async off the sweep runs immediately and the callback is called
+ * 	before returning.
+ */
+UCLASS()
+class VOXELRPG_API UWotTraceSubsystem : public UWorldSubsystem
+{
+  GENERATED_BODY()
+
+public:
+
+  static UWotTraceSubsystem* Get(const UObject* WorldContextObject);
+
+  static void SweepMultiByObjectType(const UObject* WorldContextObject,
+                                     const FVector& Start,
+                                     const FVector& End,
+                                     const FQuat& Rotation,
+                                     const FCollisionObjectQueryParams& ObjectQueryParams,
+                                     const FCollisionShape& Shape,
+                                     const FCollisionQueryParams& Params,
+                                     FWotTraceResultDelegate OnResult);
+
+  // Line trace that only reports whether anything blocks it: the callback
+  // gets one blocking hit if blocked and no hits otherwise
+  static void LineTraceTestByChannel(const UObject* WorldContextObject,
+                                     const FVector& Start,
+                                     const FVector& End,
+                                     ECollisionChannel TraceChannel,
+                                     const FCollisionQueryParams& Params,
+                                     FWotTraceResultDelegate OnResult);
+
+  int32 GetNumPending() const { return PendingRequests.Num(); }
+
+  virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+
+  virtual void Deinitialize() override;
+
+protected:
+
+  void OnTraceDone(const FTraceHandle& Handle, FTraceDatum& Datum);
+
+  FTraceDelegate TraceDoneDelegate;
+
+  // callbacks waiting for their trace, keyed by the trace's user data
+  TMap<uint32, FWotTraceResultDelegate> PendingRequests;
+
+  uint32 NextRequestId = 1;
+
+  // reused for synchronous sweeps
+  TArray<FHitResult> SyncHits;
+};
@@ -8,10 +8,13 @@ public class VoxelRPG : ModuleRules
 	{
 		PCHUsage = PCHUsageMode.UseExplicitOrSharedPCHs;
 	
-		PublicDependencyModuleNames.AddRange(new string[] { "Core", "CoreUObject", "Engine", "InputCore", "Niagara" });
+		PublicDependencyModuleNames.AddRange(new string[] { "Core", "CoreUObject", "Engine", "InputCore", "Niagara", "AIModule", "NavigationSystem", "MassEntity" });
 
 		PrivateDependencyModuleNames.AddRange(new string[] {  });
 
+		// Gameplay debugger category, the engine leaves it out of shipping and test builds
+		SetupGameplayDebuggerSupport(Target);
+
 		// Uncomment if you are using Slate UI
 		PrivateDependencyModuleNames.AddRange(new string[] { "Slate", "SlateCore" });
 		
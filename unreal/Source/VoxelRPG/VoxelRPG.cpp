@@ -3,4 +3,36 @@
 #include "VoxelRPG.h"
 #include "Modules/ModuleManager.h"
 
-IMPLEMENT_PRIMARY_GAME_MODULE( FDefaultGameModuleImpl, VoxelRPG, "VoxelRPG" );
+#if WITH_GAMEPLAY_DEBUGGER
+#include "GameplayDebugger.h"
+#include "WotGameplayDebuggerCategory.h"
+#endif
+
+class FVoxelRPGModule : public FDefaultGameModuleImpl
+{
+public:
+
+  virtual void StartupModule() override
+  {
+#if WITH_GAMEPLAY_DEBUGGER
+    IGameplayDebugger& GameplayDebuggerModule = IGameplayDebugger::Get();
+    GameplayDebuggerModule.RegisterCategory("VoxelRPG",
+      IGameplayDebugger::FOnGetCategory::CreateStatic(&FWotGameplayDebuggerCategory::MakeInstance),
+      EGameplayDebuggerCategoryState::EnabledInGameAndSimulate, 5);
+    GameplayDebuggerModule.NotifyCategoriesChanged();
+#endif
+  }
+
+  virtual void ShutdownModule() override
+  {
+#if WITH_GAMEPLAY_DEBUGGER
+    if (IGameplayDebugger::IsAvailable()) {
+      IGameplayDebugger& GameplayDebuggerModule = IGameplayDebugger::Get();
+      GameplayDebuggerModule.UnregisterCategory("VoxelRPG");
+      GameplayDebuggerModule.NotifyCategoriesChanged();
+    }
+#endif
+  }
+};
+
+IMPLEMENT_PRIMARY_GAME_MODULE( FVoxelRPGModule, VoxelRPG, "VoxelRPG" );